@@ -0,0 +1,159 @@
+export module PGUI.Tests.Framework;
+
+import std;
+
+export namespace PGUI::Tests
+{
+	using TestFunction = void (*)();
+
+	enum class TestKind
+	{
+		Test,
+		Benchmark
+	};
+
+	struct TestCase
+	{
+		std::string_view suite;
+		std::string_view name;
+		TestFunction function;
+		TestKind kind;
+	};
+
+	[[nodiscard]] auto GetTestCases() noexcept -> std::vector<TestCase>&;
+
+	// Tests and benchmarks register themselves from namespace scope objects in their translation unit
+	struct RegisterTest
+	{
+		RegisterTest(std::string_view suite, std::string_view name, TestFunction function) noexcept;
+	};
+	struct RegisterBenchmark
+	{
+		RegisterBenchmark(std::string_view suite, std::string_view name, TestFunction function) noexcept;
+	};
+
+	// Thrown by failed checks, ends the current test
+	struct CheckFailure
+	{
+		std::string message;
+		std::source_location location;
+	};
+
+	auto Check(bool condition, std::string_view expression,
+	           const std::source_location& location = std::source_location::current()) -> void;
+
+	template <typename T, typename U>
+	auto CheckEqual(const T& actual, const U& expected,
+	                const std::source_location& location = std::source_location::current()) -> void
+	{
+		if (actual == expected)
+		{
+			return;
+		}
+
+		if constexpr (std::formattable<T, char> && std::formattable<U, char>)
+		{
+			throw CheckFailure{ std::format("expected {} but got {}", expected, actual), location };
+		}
+		else
+		{
+			throw CheckFailure{ "values are not equal", location };
+		}
+	}
+
+	auto CheckNear(double actual, double expected, double tolerance,
+	               const std::source_location& location = std::source_location::current()) -> void;
+
+	// Counted by the global operator new and delete replacements of the test executable
+	extern "C++" [[nodiscard]] auto GetAllocationCount() noexcept -> std::uint64_t;
+	extern "C++" [[nodiscard]] auto GetAllocatedBytes() noexcept -> std::uint64_t;
+	extern "C++" [[nodiscard]] auto GetLiveBytes() noexcept -> std::uint64_t;
+	extern "C++" [[nodiscard]] auto GetPeakLiveBytes() noexcept -> std::uint64_t;
+	extern "C++" auto ResetPeakLiveBytes() noexcept -> void;
+
+	class AllocationScope
+	{
+		public:
+		AllocationScope() noexcept :
+			startCount{ GetAllocationCount() },
+			startBytes{ GetAllocatedBytes() },
+			startLiveBytes{ GetLiveBytes() }
+		{
+			ResetPeakLiveBytes();
+		}
+
+		[[nodiscard]] auto GetAllocations() const noexcept { return GetAllocationCount() - startCount; }
+		[[nodiscard]] auto GetBytes() const noexcept { return GetAllocatedBytes() - startBytes; }
+		// Highest amount of memory held at once since the scope began, on top of what was held before
+		[[nodiscard]] auto GetPeakBytes() const noexcept
+		{
+			const auto peak = GetPeakLiveBytes();
+			return peak > startLiveBytes ? peak - startLiveBytes : 0;
+		}
+
+		private:
+		std::uint64_t startCount;
+		std::uint64_t startBytes;
+		std::uint64_t startLiveBytes;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string name;
+		std::size_t iterations = 0;
+		std::chrono::nanoseconds elapsed{ };
+		std::uint64_t allocations = 0;
+		std::uint64_t allocatedBytes = 0;
+		std::uint64_t peakBytes = 0;
+
+		[[nodiscard]] auto GetNanosecondsPerIteration() const noexcept
+		{
+			return iterations == 0 ? 0.0 : static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+		}
+		[[nodiscard]] auto GetAllocationsPerIteration() const noexcept
+		{
+			return iterations == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(iterations);
+		}
+	};
+
+	auto Report(const BenchmarkResult& result) -> void;
+
+	// Runs func iterations times and reports the time and the allocations it took
+	template <std::invocable Func>
+	auto Measure(std::string name, const std::size_t iterations, Func&& func) -> BenchmarkResult
+	{
+		const AllocationScope allocations;
+		const auto start = std::chrono::steady_clock::now();
+		for (auto i = 0ULL; i < iterations; i++)
+		{
+			std::invoke(func);
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		BenchmarkResult result{
+			.name = std::move(name),
+			.iterations = iterations,
+			.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+			.allocations = allocations.GetAllocations(),
+			.allocatedBytes = allocations.GetBytes(),
+			.peakBytes = allocations.GetPeakBytes()
+		};
+		Report(result);
+
+		return result;
+	}
+
+	// Keeps the optimizer from dropping work whose result is otherwise unused
+	template <typename T>
+	auto DoNotOptimize(const T& value) noexcept -> void
+	{
+		static volatile const void* sink;
+		sink = std::addressof(value);
+	}
+
+	// Golden files are compared byte for byte, --update-golden rewrites them instead
+	auto CheckGolden(std::string_view fileName, std::string_view actual,
+	                 const std::source_location& location = std::source_location::current()) -> void;
+	auto SetGoldenDirectory(std::filesystem::path directory) noexcept -> void;
+	auto SetUpdateGolden(bool update) noexcept -> void;
+}
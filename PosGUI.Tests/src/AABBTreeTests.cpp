@@ -0,0 +1,164 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.UICore;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	using Tree = AABBTree<int>;
+
+	struct Proxy
+	{
+		Tree::ProxyId id;
+		RectF bounds;
+	};
+
+	[[nodiscard]] auto RandomRect(std::mt19937& random) -> RectF
+	{
+		std::uniform_real_distribution position{ 0.0F, 1000.0F };
+		std::uniform_real_distribution extent{ 1.0F, 60.0F };
+		const PointF topLeft{ position(random), position(random) };
+		return RectF{ topLeft, SizeF{ extent(random), extent(random) } };
+	}
+
+	// Queries report fat bounds, callers keep the leaves whose exact bounds match
+	[[nodiscard]] auto QueryPoint(const Tree& tree, const std::map<int, Proxy>& live, const PointF point)
+	{
+		std::set<int> found;
+		tree.QueryPoint(point, [&live, &found, point](Tree::ProxyId, const int& data)
+		{
+			if (live.at(data).bounds.Contains(point))
+			{
+				found.insert(data);
+			}
+		});
+		return found;
+	}
+
+	[[nodiscard]] auto QueryRect(const Tree& tree, const std::map<int, Proxy>& live, const RectF rect)
+	{
+		std::set<int> found;
+		tree.QueryRect(rect, [&live, &found, rect](Tree::ProxyId, const int& data)
+		{
+			if (live.at(data).bounds.Intersects(rect))
+			{
+				found.insert(data);
+			}
+		});
+		return found;
+	}
+
+	const RegisterTest queriesMatchBruteForce{ "AABBTree", "QueriesMatchBruteForce", []
+	{
+		Tree tree;
+		std::map<int, Proxy> live;
+		std::mt19937 random{ 31 };
+		std::uniform_real_distribution nudge{ -3.0F, 3.0F };
+		auto nextData = 0;
+
+		const auto pickLive = [&live, &random]
+		{
+			return std::next(live.begin(), static_cast<std::ptrdiff_t>(random() % live.size()));
+		};
+
+		for (auto step = 1; step <= 6'000; step++)
+		{
+			if (const auto operation = random() % 10;
+				live.size() < 50 || (operation < 4 && live.size() < 800))
+			{
+				const auto bounds = RandomRect(random);
+				live.emplace(nextData, Proxy{ tree.CreateProxy(bounds, nextData), bounds });
+				nextData++;
+			}
+			else if (operation < 6)
+			{
+				// Small moves mostly stay inside the fat bounds and leave the tree alone
+				auto& [id, bounds] = pickLive()->second;
+				bounds = RectF{ bounds.TopLeft() + PointF{ nudge(random), nudge(random) }, bounds.Size() };
+				tree.MoveProxy(id, bounds);
+			}
+			else if (operation < 8)
+			{
+				auto& [id, bounds] = pickLive()->second;
+				bounds = RandomRect(random);
+				tree.MoveProxy(id, bounds);
+			}
+			else
+			{
+				const auto iter = pickLive();
+				tree.DestroyProxy(iter->second.id);
+				live.erase(iter);
+			}
+
+			if (step % 100 != 0)
+			{
+				continue;
+			}
+
+			CheckEqual(tree.Size(), live.size());
+			// Rotations keep the tree within a constant factor of a perfectly balanced one
+			Check(tree.GetHeight() <= 2 * static_cast<int>(std::bit_width(live.size())) + 2, "the tree stays balanced");
+			for (const auto& [data, proxy] : live)
+			{
+				CheckEqual(tree.GetData(proxy.id), data);
+				Check(tree.GetFatBounds(proxy.id).Contains(proxy.bounds), "the fat bounds cover the leaf");
+			}
+
+			for (auto query = 0; query < 50; query++)
+			{
+				const auto rect = RandomRect(random);
+				const auto point = rect.Center();
+
+				std::set<int> expectedAtPoint;
+				std::set<int> expectedInRect;
+				for (const auto& [data, proxy] : live)
+				{
+					if (proxy.bounds.Contains(point))
+					{
+						expectedAtPoint.insert(data);
+					}
+					if (proxy.bounds.Intersects(rect))
+					{
+						expectedInRect.insert(data);
+					}
+				}
+
+				Check(QueryPoint(tree, live, point) == expectedAtPoint, "the point query found every leaf at the point");
+				Check(QueryRect(tree, live, rect) == expectedInRect, "the rect query found every leaf in the rect");
+			}
+		}
+
+		for (const auto& proxy : live | std::views::values)
+		{
+			tree.DestroyProxy(proxy.id);
+		}
+		Check(tree.IsEmpty(), "every proxy was destroyed");
+		CheckEqual(tree.GetHeight(), 0);
+	} };
+
+	const RegisterTest freedNodesAreReused{ "AABBTree", "DestroyedProxiesAreReused", []
+	{
+		Tree tree;
+		std::mt19937 random{ 2 };
+		std::vector<Tree::ProxyId> ids;
+		for (auto i = 0; i < 100; i++)
+		{
+			ids.push_back(tree.CreateProxy(RandomRect(random), i));
+		}
+
+		// A leaf and its parent are freed together and handed out again for the next leaf
+		for (auto round = 0; round < 1'000; round++)
+		{
+			auto& id = ids[random() % ids.size()];
+			tree.DestroyProxy(id);
+			id = tree.CreateProxy(RandomRect(random), round);
+			Check(id < 2 * ids.size(), "the node storage does not grow");
+		}
+		CheckEqual(tree.Size(), ids.size());
+	} };
+}
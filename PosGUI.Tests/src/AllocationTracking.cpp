@@ -0,0 +1,147 @@
+// Replaces the global allocation functions of the test executable so tests and benchmarks can count allocations.
+// Every block carries a header with its size so live and peak memory can be tracked on unsized deletes too.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace
+{
+	std::atomic<std::uint64_t> allocationCount = 0;
+	std::atomic<std::uint64_t> allocatedBytes = 0;
+	std::atomic<std::uint64_t> liveBytes = 0;
+	std::atomic<std::uint64_t> peakLiveBytes = 0;
+
+	constexpr auto HeaderSize = static_cast<std::size_t>(__STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	auto Allocate(const std::size_t size, const std::size_t alignment) noexcept -> void*
+	{
+		const auto headerSize = alignment > HeaderSize ? alignment : HeaderSize;
+		auto* const block = static_cast<std::byte*>(_aligned_malloc(size + headerSize, alignment));
+		if (block == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto* const memory = block + headerSize;
+		*reinterpret_cast<std::size_t*>(memory - sizeof(std::size_t)) = size;
+
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		const auto live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		auto peak = peakLiveBytes.load(std::memory_order_relaxed);
+		while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		{
+		}
+
+		return memory;
+	}
+
+	auto Deallocate(void* memory, const std::size_t alignment) noexcept -> void
+	{
+		if (memory == nullptr)
+		{
+			return;
+		}
+
+		const auto headerSize = alignment > HeaderSize ? alignment : HeaderSize;
+		auto* const bytes = static_cast<std::byte*>(memory);
+		liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(bytes - sizeof(std::size_t)), std::memory_order_relaxed);
+		_aligned_free(bytes - headerSize);
+	}
+
+	auto AllocateOrThrow(const std::size_t size, const std::size_t alignment) -> void*
+	{
+		if (auto* const memory = Allocate(size, alignment);
+			memory != nullptr)
+		{
+			return memory;
+		}
+		throw std::bad_alloc{ };
+	}
+}
+
+auto operator new(const std::size_t size) -> void*
+{
+	return AllocateOrThrow(size, HeaderSize);
+}
+auto operator new[](const std::size_t size) -> void*
+{
+	return AllocateOrThrow(size, HeaderSize);
+}
+auto operator new(const std::size_t size, const std::align_val_t alignment) -> void*
+{
+	return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+auto operator new[](const std::size_t size, const std::align_val_t alignment) -> void*
+{
+	return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+auto operator new(const std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+	return Allocate(size, HeaderSize);
+}
+auto operator new[](const std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+	return Allocate(size, HeaderSize);
+}
+
+auto operator delete(void* memory) noexcept -> void
+{
+	Deallocate(memory, HeaderSize);
+}
+auto operator delete[](void* memory) noexcept -> void
+{
+	Deallocate(memory, HeaderSize);
+}
+auto operator delete(void* memory, std::size_t) noexcept -> void
+{
+	Deallocate(memory, HeaderSize);
+}
+auto operator delete[](void* memory, std::size_t) noexcept -> void
+{
+	Deallocate(memory, HeaderSize);
+}
+auto operator delete(void* memory, const std::align_val_t alignment) noexcept -> void
+{
+	Deallocate(memory, static_cast<std::size_t>(alignment));
+}
+auto operator delete[](void* memory, const std::align_val_t alignment) noexcept -> void
+{
+	Deallocate(memory, static_cast<std::size_t>(alignment));
+}
+auto operator delete(void* memory, std::size_t, const std::align_val_t alignment) noexcept -> void
+{
+	Deallocate(memory, static_cast<std::size_t>(alignment));
+}
+auto operator delete[](void* memory, std::size_t, const std::align_val_t alignment) noexcept -> void
+{
+	Deallocate(memory, static_cast<std::size_t>(alignment));
+}
+
+namespace PGUI::Tests
+{
+	auto GetAllocationCount() noexcept -> std::uint64_t
+	{
+		return allocationCount.load(std::memory_order_relaxed);
+	}
+	auto GetAllocatedBytes() noexcept -> std::uint64_t
+	{
+		return allocatedBytes.load(std::memory_order_relaxed);
+	}
+	auto GetLiveBytes() noexcept -> std::uint64_t
+	{
+		return liveBytes.load(std::memory_order_relaxed);
+	}
+	auto GetPeakLiveBytes() noexcept -> std::uint64_t
+	{
+		return peakLiveBytes.load(std::memory_order_relaxed);
+	}
+	auto ResetPeakLiveBytes() noexcept -> void
+	{
+		peakLiveBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
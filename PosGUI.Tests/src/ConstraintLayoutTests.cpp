@@ -0,0 +1,83 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.ConstraintSolver;
+import PGUI.UI.Layout.ConstraintLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest itemsPlacedByConstraints{ "ConstraintLayout", "ItemsFollowPanelResize", []
+	{
+		ConstraintLayout layout{ RectF{ 0, 0, 400, 200 } };
+		LayoutSpacer sidebar{ SizeF{ 100, 50 } };
+		LayoutSpacer content{ SizeF{ 50, 50 } };
+		layout.AddItem(sidebar);
+		layout.AddItem(content);
+
+		const auto& panel = layout.GetPanelAnchors();
+		const auto side = *layout.GetItemAnchors(0);
+		const auto main = *layout.GetItemAnchors(1);
+		for (const auto& constraint : {
+			     Constraint::Equal(side.left, panel.left),
+			     Constraint::Equal(side.top, panel.top),
+			     Constraint::Equal(side.Bottom(), panel.Bottom()),
+			     Constraint::Equal(side.width, 100.0, Strength::Medium),
+			     Constraint::Equal(main.left, side.Right()),
+			     Constraint::Equal(main.top, panel.top),
+			     Constraint::Equal(main.Right(), panel.Right()),
+			     Constraint::Equal(main.Bottom(), panel.Bottom())
+		     })
+		{
+			Check(layout.AddConstraint(constraint).has_value(), "the constraint was added");
+		}
+
+		layout.UpdateLayout();
+		Check(sidebar.GetRect() == RectF{ 0, 0, 100, 200 }, "the sidebar keeps its preferred width");
+		Check(content.GetRect() == RectF{ 100, 0, 400, 200 }, "the content fills the rest");
+
+		layout.Resize(SizeF{ 600, 300 });
+		layout.UpdateLayout();
+		Check(sidebar.GetRect() == RectF{ 0, 0, 100, 300 }, "the sidebar follows the new height");
+		Check(content.GetRect() == RectF{ 100, 0, 600, 300 }, "the content follows the new size");
+	} };
+
+	const RegisterTest removedItemsLeaveSolver{ "ConstraintLayout", "RemovingAnItemReleasesItsVariables", []
+	{
+		ConstraintLayout layout{ RectF{ 0, 0, 400, 200 } };
+		LayoutSpacer first{ SizeF{ 100, 50 } };
+		layout.AddItem(first);
+		const auto variableCount = layout.GetSolver().GetVariableCount();
+
+		LayoutSpacer splitter{ SizeF{ 4, 50 } };
+		layout.AddItem(splitter);
+		const auto anchors = *layout.GetItemAnchors(1);
+		Check(layout.AddConstraint(Constraint::GreaterOrEqual(anchors.left, 50.0)).has_value(), "the constraint was added");
+		Check(layout.AddEditVariable(anchors.left).has_value(), "the splitter position is editable");
+		Check(layout.SuggestValue(anchors.left, 120.0).has_value(), "the splitter was dragged");
+		layout.UpdateLayout();
+		CheckEqual(splitter.GetPosition().x, 120.0F);
+		Check(layout.GetSolver().GetVariableCount() > variableCount, "the splitter added its anchors");
+
+		Check(layout.RemoveItem(1).has_value(), "the splitter was removed");
+		Check(!layout.GetSolver().HasEditVariable(anchors.left), "the edit variable went with the item");
+		Check(!layout.SuggestValue(anchors.left, 200.0).has_value(), "the removed anchor cannot be suggested");
+		CheckEqual(layout.GetSolver().GetVariableCount(), variableCount);
+
+		// Adding and removing items over and over does not grow the solver
+		for (auto i = 0; i < 100; i++)
+		{
+			layout.AddItem(splitter);
+			const auto added = *layout.GetItemAnchors(1);
+			Check(layout.AddEditVariable(added.left).has_value(), "the splitter position is editable");
+			Check(layout.RemoveItem(1).has_value(), "the splitter was removed");
+		}
+		CheckEqual(layout.GetSolver().GetVariableCount(), variableCount);
+	} };
+}
@@ -0,0 +1,248 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.UI.Layout.ConstraintSolver;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Three panes side by side, the panel width and the first splitter are edited
+	struct SplitRow
+	{
+		Variable panelWidth;
+		Variable splitter;
+		std::array<Variable, 3> lefts;
+		std::array<Variable, 3> widths;
+		std::vector<Constraint> constraints;
+
+		SplitRow()
+		{
+			constraints.push_back(Constraint::Equal(lefts[0], 0.0));
+			constraints.push_back(Constraint::Equal(lefts[1], splitter));
+			constraints.push_back(Constraint::Equal(lefts[0] + widths[0], lefts[1]));
+			constraints.push_back(Constraint::Equal(lefts[1] + widths[1], lefts[2]));
+			constraints.push_back(Constraint::Equal(lefts[2] + widths[2], panelWidth));
+			for (const auto& width : widths)
+			{
+				constraints.push_back(Constraint::GreaterOrEqual(width, 50.0));
+			}
+			constraints.push_back(Constraint::Equal(widths[2], 200.0, Strength::Weak));
+		}
+
+		auto AddTo(ConstraintSolver& solver) const -> void
+		{
+			for (const auto& constraint : constraints)
+			{
+				Check(solver.AddConstraint(constraint).has_value(), "the constraint was added");
+			}
+			Check(solver.AddEditVariable(panelWidth, Strength::Strong).has_value(), "the panel width is editable");
+			Check(solver.AddEditVariable(splitter, Strength::Medium).has_value(), "the splitter is editable");
+		}
+
+		[[nodiscard]] auto Values() const
+		{
+			return std::array{
+				panelWidth.GetValue(), splitter.GetValue(),
+				lefts[0].GetValue(), lefts[1].GetValue(), lefts[2].GetValue(),
+				widths[0].GetValue(), widths[1].GetValue(), widths[2].GetValue()
+			};
+		}
+	};
+
+	auto CheckValues(const std::span<const double> actual, const std::span<const double> expected) -> void
+	{
+		CheckEqual(actual.size(), expected.size());
+		for (const auto& [value, expectedValue] : std::views::zip(actual, expected))
+		{
+			CheckNear(value, expectedValue, 1e-6);
+		}
+	}
+
+	const RegisterTest strengthsResolveConflicts{ "ConstraintSolver", "StrongerConstraintsWinConflicts", []
+	{
+		ConstraintSolver solver;
+		Variable x;
+		Variable y;
+
+		const auto required = Constraint::Equal(x, 10.0);
+		const auto strong = Constraint::Equal(x, 20.0, Strength::Strong);
+		const auto weak = Constraint::Equal(y, 5.0, Strength::Weak);
+		const auto medium = Constraint::Equal(y, x + 1.0, Strength::Medium);
+		for (const auto& constraint : { strong, weak, medium, required })
+		{
+			Check(solver.AddConstraint(constraint).has_value(), "the constraint was added");
+		}
+
+		solver.UpdateVariables();
+		CheckNear(x.GetValue(), 10.0, 1e-9);
+		CheckNear(y.GetValue(), 11.0, 1e-9);
+
+		// Without the required one the strong constraint decides x
+		Check(solver.RemoveConstraint(required).has_value(), "the required constraint was removed");
+		solver.UpdateVariables();
+		CheckNear(x.GetValue(), 20.0, 1e-9);
+		CheckNear(y.GetValue(), 21.0, 1e-9);
+
+		Check(solver.RemoveConstraint(medium).has_value(), "the medium constraint was removed");
+		solver.UpdateVariables();
+		CheckNear(y.GetValue(), 5.0, 1e-9);
+
+		Check(!solver.AddConstraint(strong).has_value(), "a constraint can only be added once");
+		Check(!solver.RemoveConstraint(medium).has_value(), "a removed constraint is not found");
+		Check(!solver.AddEditVariable(x, Strength::Required).has_value(), "edit variables cannot be required");
+	} };
+
+	const RegisterTest unsatisfiableLeavesTableau{ "ConstraintSolver", "UnsatisfiableConstraintChangesNothing", []
+	{
+		ConstraintSolver solver;
+		SplitRow row;
+		row.AddTo(solver);
+		Check(solver.SuggestValue(row.panelWidth, 800.0).has_value(), "the width was suggested");
+		Check(solver.SuggestValue(row.splitter, 300.0).has_value(), "the splitter was suggested");
+		solver.UpdateVariables();
+		const auto before = row.Values();
+		const auto variableCount = solver.GetVariableCount();
+
+		// The panes need at least 150 between them
+		const auto tooNarrow = Constraint::LessOrEqual(row.panelWidth, 100.0);
+		const auto contradiction = Constraint::LessOrEqual(row.widths[0] + row.widths[1], 60.0);
+		Check(!solver.AddConstraint(tooNarrow).has_value(), "the narrow panel is rejected");
+		Check(!solver.AddConstraint(contradiction).has_value(), "the contradiction is rejected");
+		Check(!solver.HasConstraint(tooNarrow) && !solver.HasConstraint(contradiction), "nothing was kept");
+		CheckEqual(solver.GetVariableCount(), variableCount);
+
+		solver.UpdateVariables();
+		CheckValues(row.Values(), before);
+
+		// The tableau still answers edits as if the rejected constraints were never tried
+		Check(solver.SuggestValue(row.splitter, 400.0).has_value(), "the splitter was suggested");
+		solver.UpdateVariables();
+		CheckNear(row.widths[0].GetValue(), 400.0, 1e-9);
+		CheckNear(row.widths[1].GetValue(), 200.0, 1e-9);
+		CheckNear(row.widths[2].GetValue(), 200.0, 1e-9);
+	} };
+
+	const RegisterTest removeReAddRoundTrip{ "ConstraintSolver", "RemoveAndReAddRoundTrips", []
+	{
+		ConstraintSolver solver;
+		SplitRow row;
+		row.AddTo(solver);
+		Check(solver.SuggestValue(row.panelWidth, 900.0).has_value(), "the width was suggested");
+		Check(solver.SuggestValue(row.splitter, 250.0).has_value(), "the splitter was suggested");
+		solver.UpdateVariables();
+		const auto expected = row.Values();
+		const auto variableCount = solver.GetVariableCount();
+
+		std::mt19937 random{ 5 };
+		auto order = row.constraints;
+		for (auto round = 0; round < 20; round++)
+		{
+			std::ranges::shuffle(order, random);
+			const auto count = std::uniform_int_distribution<std::size_t>{ 1, order.size() }(random);
+			for (const auto& constraint : order | std::views::take(count))
+			{
+				Check(solver.RemoveConstraint(constraint).has_value(), "the constraint was removed");
+			}
+			for (const auto& constraint : order | std::views::take(count) | std::views::reverse)
+			{
+				Check(solver.AddConstraint(constraint).has_value(), "the constraint was added again");
+			}
+
+			solver.UpdateVariables();
+			CheckValues(row.Values(), expected);
+			CheckEqual(solver.GetVariableCount(), variableCount);
+		}
+
+		// Variables nothing refers to anymore leave the solver
+		for (const auto& constraint : row.constraints)
+		{
+			Check(solver.RemoveConstraint(constraint).has_value(), "the constraint was removed");
+		}
+		Check(solver.RemoveEditVariable(row.panelWidth).has_value(), "the width edit was removed");
+		Check(solver.RemoveEditVariable(row.splitter).has_value(), "the splitter edit was removed");
+		CheckEqual(solver.GetVariableCount(), 0ULL);
+	} };
+
+	const RegisterTest suggestMatchesScratch{ "ConstraintSolver", "SuggestValueMatchesSolvingFromScratch", []
+	{
+		ConstraintSolver solver;
+		SplitRow row;
+		row.AddTo(solver);
+
+		std::mt19937 random{ 23 };
+		std::uniform_real_distribution width{ 100.0, 1200.0 };
+		std::uniform_real_distribution drag{ -40.0, 40.0 };
+		auto panelWidth = 800.0;
+		auto splitter = 300.0;
+		for (auto step = 0; step < 300; step++)
+		{
+			// Mostly small drags with an occasional resize, sometimes past what the panes allow
+			if (step % 10 == 0)
+			{
+				panelWidth = width(random);
+				Check(solver.SuggestValue(row.panelWidth, panelWidth).has_value(), "the width was suggested");
+			}
+			splitter += drag(random);
+			Check(solver.SuggestValue(row.splitter, splitter).has_value(), "the splitter was suggested");
+			solver.UpdateVariables();
+			const auto incremental = row.Values();
+
+			ConstraintSolver scratch;
+			SplitRow fresh;
+			fresh.AddTo(scratch);
+			Check(scratch.SuggestValue(fresh.panelWidth, panelWidth).has_value(), "the width was suggested");
+			Check(scratch.SuggestValue(fresh.splitter, splitter).has_value(), "the splitter was suggested");
+			scratch.UpdateVariables();
+			CheckValues(incremental, fresh.Values());
+		}
+	} };
+
+	const RegisterBenchmark dragAndResize{ "ConstraintSolver", "DragAndResize", []
+	{
+		constexpr auto PaneCount = 200;
+
+		// A row of panes, every splitter keeps its pane at least 10 wide
+		const auto build = [](ConstraintSolver& solver, std::vector<Variable>& splitters, Variable& panelWidth)
+		{
+			splitters = std::vector<Variable>(PaneCount + 1);
+			Unused(solver.AddConstraint(Constraint::Equal(splitters.front(), 0.0)));
+			Unused(solver.AddConstraint(Constraint::Equal(splitters.back(), panelWidth)));
+			for (auto i = 0; i < PaneCount; i++)
+			{
+				Unused(solver.AddConstraint(Constraint::GreaterOrEqual(splitters[i + 1] - splitters[i], 10.0)));
+				Unused(solver.AddConstraint(Constraint::Equal(splitters[i + 1] - splitters[i], 40.0, Strength::Weak)));
+			}
+			Unused(solver.AddEditVariable(panelWidth, Strength::Strong));
+			Unused(solver.AddEditVariable(splitters[PaneCount / 2], Strength::Medium));
+		};
+
+		ConstraintSolver solver;
+		std::vector<Variable> splitters;
+		Variable panelWidth;
+		build(solver, splitters, panelWidth);
+
+		std::mt19937 random{ 3 };
+		std::uniform_real_distribution width{ 4000.0, 12000.0 };
+		std::uniform_real_distribution position{ 1000.0, 6000.0 };
+		Unused(Measure("suggest a drag and a resize, 200 panes", 10'000, [&]
+		{
+			Unused(solver.SuggestValue(panelWidth, width(random)));
+			Unused(solver.SuggestValue(splitters[PaneCount / 2], position(random)));
+			solver.UpdateVariables();
+		}));
+		Unused(Measure("solve from scratch, 200 panes", 100, [&]
+		{
+			ConstraintSolver scratch;
+			std::vector<Variable> scratchSplitters;
+			Variable scratchWidth;
+			build(scratch, scratchSplitters, scratchWidth);
+			Unused(scratch.SuggestValue(scratchWidth, width(random)));
+			Unused(scratch.SuggestValue(scratchSplitters[PaneCount / 2], position(random)));
+			scratch.UpdateVariables();
+		}));
+	} };
+}
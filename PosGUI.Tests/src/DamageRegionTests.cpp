@@ -0,0 +1,151 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.DamageRegion;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	[[nodiscard]] auto IsCovered(const DamageRegion& region, const PointF point) noexcept
+	{
+		return std::ranges::any_of(region.GetRects(), [point](const RectF rect) { return rect.Contains(point); });
+	}
+
+	[[nodiscard]] auto AreDisjoint(const DamageRegion& region) noexcept
+	{
+		const auto rects = region.GetRects();
+		for (const auto first : std::views::iota(0ULL, rects.size()))
+		{
+			for (const auto second : std::views::iota(first + 1, rects.size()))
+			{
+				if (rects[first].Intersects(rects[second]))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	const RegisterTest overlappingRectsMerge{ "DamageRegion", "OverlappingRectsMerge", []
+	{
+		DamageRegion region;
+		region.Add(RectF{ 0, 0, 10, 10 });
+		region.Add(RectF{ 5, 5, 15, 15 });
+
+		CheckEqual(region.GetRects().size(), 1ULL);
+		Check(region.GetRects().front() == RectF{ 0, 0, 15, 15 }, "the rects became their union");
+	} };
+
+	const RegisterTest containedAndEmptyRects{ "DamageRegion", "ContainedAndEmptyRectsAddNothing", []
+	{
+		DamageRegion region;
+		region.Add(RectF{ 0, 0, 20, 20 });
+		region.Add(RectF{ 5, 5, 10, 10 });
+		region.Add(RectF{ 30, 30, 30, 40 });
+		region.Add(RectF{ 50, 50, 40, 60 });
+
+		CheckEqual(region.GetRects().size(), 1ULL);
+		CheckNear(region.GetArea(), 400.0F, 0.001F);
+	} };
+
+	const RegisterTest edgeAlignedRectsMerge{ "DamageRegion", "EdgeAlignedRectsMerge", []
+	{
+		DamageRegion region;
+		region.Add(RectF{ 0, 0, 10, 10 });
+		region.Add(RectF{ 10, 0, 20, 10 });
+		CheckEqual(region.GetRects().size(), 1ULL);
+		Check(region.GetRects().front() == RectF{ 0, 0, 20, 10 }, "the row became one rect");
+
+		// Touching only at a corner would repaint area nobody asked for
+		region.Add(RectF{ 20, 10, 30, 20 });
+		CheckEqual(region.GetRects().size(), 2ULL);
+		CheckNear(region.GetArea(), 300.0F, 0.001F);
+	} };
+
+	const RegisterTest mergeCascades{ "DamageRegion", "MergedRectReachesOtherRects", []
+	{
+		DamageRegion region;
+		region.Add(RectF{ 0, 0, 10, 10 });
+		region.Add(RectF{ 20, 0, 30, 10 });
+		CheckEqual(region.GetRects().size(), 2ULL);
+
+		// Bridges both, the union with the first then swallows the second too
+		region.Add(RectF{ 5, 0, 25, 10 });
+		CheckEqual(region.GetRects().size(), 1ULL);
+		Check(region.GetRects().front() == RectF{ 0, 0, 30, 10 }, "all three became one rect");
+	} };
+
+	const RegisterTest cheapestPairMerges{ "DamageRegion", "OverflowMergesTheCheapestPair", []
+	{
+		DamageRegion region{ 2 };
+		region.Add(RectF{ 0, 0, 10, 10 });
+		region.Add(RectF{ 100, 0, 110, 10 });
+		region.Add(RectF{ 0, 12, 10, 22 });
+
+		// The two rects stacked on the left waste far less than anything with the right one
+		CheckEqual(region.GetRects().size(), 2ULL);
+		Check(std::ranges::contains(region.GetRects(), RectF{ 0, 0, 10, 22 }), "the left rects were merged");
+		Check(std::ranges::contains(region.GetRects(), RectF{ 100, 0, 110, 10 }), "the right rect was kept");
+	} };
+
+	const RegisterTest clipAndCombine{ "DamageRegion", "ClipToAndAddRegion", []
+	{
+		DamageRegion region;
+		region.Add(RectF{ -10, -10, 10, 10 });
+		region.Add(RectF{ 200, 200, 210, 210 });
+
+		DamageRegion other;
+		other.Add(RectF{ 50, 50, 60, 60 });
+		region.Add(other);
+		CheckEqual(region.GetRects().size(), 3ULL);
+
+		region.ClipTo(RectF{ 0, 0, 100, 100 });
+		CheckEqual(region.GetRects().size(), 2ULL);
+		Check(region.GetBounds() == RectF{ 0, 0, 60, 60 }, "only the visible parts are left");
+		Check(region.Intersects(RectF{ 55, 55, 70, 70 }), "the added region is kept");
+		Check(!region.Intersects(RectF{ 20, 20, 40, 40 }), "the gap between the rects is not damaged");
+
+		region.Clear();
+		Check(region.IsEmpty(), "the region was cleared");
+		Check(region.GetBounds() == RectF{ }, "an empty region has no bounds");
+	} };
+
+	const RegisterTest randomRectsStayDisjoint{ "DamageRegion", "RandomRectsStayDisjointAndCovered", []
+	{
+		std::mt19937 random{ 17 };
+		std::uniform_int_distribution position{ 0, 90 };
+		std::uniform_int_distribution extent{ 1, 20 };
+
+		for (auto round = 0; round < 200; round++)
+		{
+			DamageRegion region{ 4 };
+			std::vector<RectF> added;
+			for (auto i = 0; i < 12; i++)
+			{
+				const auto left = static_cast<float>(position(random));
+				const auto top = static_cast<float>(position(random));
+				const RectF rect{
+					left, top,
+					left + static_cast<float>(extent(random)), top + static_cast<float>(extent(random))
+				};
+				added.push_back(rect);
+				region.Add(rect);
+
+				Check(region.GetRects().size() <= 4, "the rect count stays within the limit");
+				Check(AreDisjoint(region), "every pixel is repainted once");
+			}
+
+			for (const auto rect : added)
+			{
+				Check(IsCovered(region, rect.TopLeft()) && IsCovered(region, rect.BottomRight()) &&
+				      IsCovered(region, rect.Center()), "every added rect is still damaged");
+			}
+		}
+	} };
+}
@@ -0,0 +1,215 @@
+import std;
+
+import PGUI.Delegate;
+import PGUI.Event;
+import PGUI.Utils;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	struct Receiver
+	{
+		int total = 0;
+
+		auto OnValue(const int value) noexcept -> void { total += value; }
+	};
+
+	// The EventT storage before InlineDelegate, kept to compare the two paths
+	class VariantCallbackEvent
+	{
+		public:
+		using CancellingCallback = std::function<bool(int)>;
+		using NonCancellingCallback = std::function<void(int)>;
+		using Callback = std::variant<NonCancellingCallback, CancellingCallback>;
+
+		template <typename Callable>
+		auto AddCallback(const Callable& callable, const CallbackPriority priority = CallbackPriority::Normal)
+		{
+			using CallbackType = std::conditional_t<
+				std::is_same_v<bool, std::invoke_result_t<Callable, int>>,
+				CancellingCallback,
+				NonCancellingCallback>;
+
+			const auto id = nextId++;
+			callbacks.emplace_back(id, priority, CallbackType{ callable });
+			std::ranges::stable_sort(callbacks, std::ranges::greater{ }, &CallbackData::priority);
+
+			return id;
+		}
+
+		auto Invoke(const int value) const -> void
+		{
+			for (const auto& data : callbacks)
+			{
+				if (std::holds_alternative<CancellingCallback>(data.callback))
+				{
+					if (!std::get<CancellingCallback>(data.callback)(value))
+					{
+						return;
+					}
+				}
+				else
+				{
+					std::get<NonCancellingCallback>(data.callback)(value);
+				}
+			}
+		}
+
+		private:
+		struct CallbackData
+		{
+			CallbackId id;
+			CallbackPriority priority;
+			Callback callback;
+		};
+
+		std::vector<CallbackData> callbacks;
+		CallbackId nextId = 0;
+	};
+
+	const RegisterTest smallCallableIsInline{ "Delegate", "SmallCallableIsStoredInline", []
+	{
+		Receiver receiver;
+		const AllocationScope allocations;
+
+		const Delegate<int> delegate{ std::bind_front(&Receiver::OnValue, &receiver) };
+		Check(delegate(3), "non cancelling callbacks continue the dispatch");
+
+		CheckEqual(allocations.GetAllocations(), 0ULL);
+		CheckEqual(receiver.total, 3);
+	} };
+
+	const RegisterTest largeCallableUsesHeap{ "Delegate", "LargeCallableFallsBackToHeap", []
+	{
+		std::array<std::byte, 4 * DefaultDelegateBufferSize> payload{ };
+		const AllocationScope allocations;
+
+		const Delegate<> delegate{ [payload] { DoNotOptimize(payload); } };
+		Unused(delegate());
+
+		CheckEqual(allocations.GetAllocations(), 1ULL);
+	} };
+
+	const RegisterTest cancellingCallback{ "Delegate", "CancellingCallbackStopsDispatch", []
+	{
+		const Delegate<int> cancelling{ [](const int value) { return value < 10; } };
+
+		Check(cancelling(1), "callback returned true");
+		Check(!cancelling(11), "callback returned false");
+	} };
+
+	const RegisterTest moveAndClone{ "Delegate", "MoveAndCloneKeepOwnership", []
+	{
+		const auto counter = std::make_shared<int>(0);
+		{
+			Delegate<> original{ [counter] { ++*counter; } };
+			CheckEqual(counter.use_count(), 2L);
+
+			auto moved = std::move(original);
+			Check(!original, "moved from delegate is empty");
+			CheckEqual(counter.use_count(), 2L);
+
+			const auto clone = moved.Clone();
+			CheckEqual(counter.use_count(), 3L);
+
+			Unused(moved());
+			Unused(clone());
+			CheckEqual(*counter, 2);
+		}
+		CheckEqual(counter.use_count(), 1L);
+	} };
+
+	const RegisterTest moveOnlyClone{ "Delegate", "MoveOnlyCallableClonesToEmpty", []
+	{
+		const Delegate<> delegate{ [value = std::make_unique<int>(1)] { DoNotOptimize(*value); } };
+
+		Check(static_cast<bool>(delegate), "delegate holds the callable");
+		Check(!delegate.Clone(), "move only callables can't be cloned");
+	} };
+
+	const RegisterTest eventOrder{ "Delegate", "EventInvokesByPriorityAndCancels", []
+	{
+		EventNM<int> event;
+		std::vector<int> order;
+
+		event.AddCallback([&order](int) { order.push_back(1); }, CallbackPriority::Low);
+		event.AddCallback([&order](int) { order.push_back(2); }, CallbackPriority::High);
+		event.AddCallback([&order](const int value) { order.push_back(3); return value != 0; });
+		event.Invoke(1);
+		CheckEqual(order, std::vector{ 2, 3, 1 });
+
+		order.clear();
+		event.Invoke(0);
+		CheckEqual(order, std::vector{ 2, 3 });
+	} };
+
+	constexpr auto CallbackCount = 1000ULL;
+	constexpr auto InvokeCount = 10'000ULL;
+
+	const RegisterBenchmark addCallback{ "Delegate", "AddCallback", []
+	{
+		std::vector<Receiver> receivers(CallbackCount);
+
+		const auto legacy = Measure("std::function in std::variant", 1, [&receivers]
+		{
+			VariantCallbackEvent event;
+			for (auto& receiver : receivers)
+			{
+				// bind_front plus a payload, as UIContainer registers per child
+				event.AddCallback([&receiver, payload = std::array<void*, 2>{ }](const int value)
+				{
+					DoNotOptimize(payload);
+					receiver.OnValue(value);
+				});
+			}
+		});
+		const auto delegate = Measure("InlineDelegate", 1, [&receivers]
+		{
+			EventNM<int> event;
+			for (auto& receiver : receivers)
+			{
+				event.AddCallback([&receiver, payload = std::array<void*, 2>{ }](const int value)
+				{
+					DoNotOptimize(payload);
+					receiver.OnValue(value);
+				});
+			}
+		});
+
+		std::println("  allocations per AddCallback: {:.2f} -> {:.2f}",
+		             static_cast<double>(legacy.allocations) / CallbackCount,
+		             static_cast<double>(delegate.allocations) / CallbackCount);
+		Check(delegate.allocations <= legacy.allocations, "InlineDelegate allocates no more than std::function");
+	} };
+
+	const RegisterBenchmark invoke{ "Delegate", "Invoke", []
+	{
+		std::vector<Receiver> receivers(CallbackCount);
+		VariantCallbackEvent legacyEvent;
+		EventNM<int> event;
+		for (auto& receiver : receivers)
+		{
+			legacyEvent.AddCallback(std::bind_front(&Receiver::OnValue, &receiver));
+			event.AddCallback(std::bind_front(&Receiver::OnValue, &receiver));
+		}
+
+		const auto legacy = Measure("std::function in std::variant", InvokeCount, [&legacyEvent]
+		{
+			legacyEvent.Invoke(1);
+		});
+		const auto delegate = Measure("InlineDelegate", InvokeCount, [&event]
+		{
+			event.Invoke(1);
+		});
+
+		const auto callbacksPerSecond = [](const BenchmarkResult& result)
+		{
+			return static_cast<double>(CallbackCount) * 1e9 / result.GetNanosecondsPerIteration();
+		};
+		std::println("  callbacks invoked per second: {:.3e} -> {:.3e}",
+		             callbacksPerSecond(legacy), callbacksPerSecond(delegate));
+	} };
+}
@@ -0,0 +1,125 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.DataBinding.Property;
+import PGUI.DataBinding.DerivedProperty;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest diamondRecomputesOnce{ "DerivedProperty", "DiamondRecomputesOncePerWave", []
+	{
+		Property<int> a{ 1 };
+		auto bCount = 0;
+		auto cCount = 0;
+		auto dCount = 0;
+		DerivedProperty<int> b{ [&bCount](const int value)
+		{
+			bCount++;
+			return value + 1;
+		}, a };
+		DerivedProperty<int> c{ [&cCount](const int value)
+		{
+			cCount++;
+			return value * 2;
+		}, a };
+		DerivedProperty<int> d{ [&dCount](const int left, const int right)
+		{
+			dCount++;
+			return left + right;
+		}, b, c };
+		CheckEqual(*d.Get(), 4);
+
+		std::vector<int> seen;
+		auto consistent = true;
+		Unused(d.AddObserver([&](const auto& value)
+		{
+			seen.push_back(*value);
+			consistent &= *value == *b.Get() + *c.Get() && *b.Get() == *a.Get() + 1 && *c.Get() == *a.Get() * 2;
+		}));
+
+		bCount = cCount = dCount = 0;
+		a.Set(5);
+		CheckEqual(bCount, 1);
+		CheckEqual(cCount, 1);
+		CheckEqual(dCount, 1);
+		CheckEqual(seen, std::vector{ 16 });
+		Check(consistent, "the observer saw every value from the same wave");
+
+		a.Set(6);
+		CheckEqual(dCount, 2);
+		CheckEqual(seen, std::vector{ 16, 19 });
+	} };
+
+	const RegisterTest observersSeeSettledGraph{ "DerivedProperty", "ObserversNeverSeeMixedValues", []
+	{
+		Property<int> a{ 1 };
+		DerivedProperty<int> b{ [](const int value) { return value + 1; }, a };
+		DerivedProperty<int> c{ [](const int value) { return value * 2; }, a };
+		DerivedProperty<int> d{ [](const int left, const int right) { return left + right; }, b, c };
+
+		// In a naive push model b would notify while c and d still hold the old values
+		auto mixed = 0;
+		auto notified = 0;
+		const auto check = [&]
+		{
+			notified++;
+			if (*d.Get() != *b.Get() + *c.Get() || *c.Get() != *a.Get() * 2)
+			{
+				mixed++;
+			}
+		};
+		Unused(b.AddObserver([&check](const auto&) { check(); }));
+		Unused(c.AddObserver([&check](const auto&) { check(); }));
+		Unused(d.AddObserver([&check](const auto&) { check(); }));
+
+		for (auto value = 2; value < 50; value++)
+		{
+			a.Set(value);
+		}
+		CheckEqual(notified, 3 * 48);
+		CheckEqual(mixed, 0);
+	} };
+
+	const RegisterTest deepChainRecomputesOnce{ "DerivedProperty", "DeepChainRecomputesEachNodeOnce", []
+	{
+		constexpr auto Depth = 200;
+
+		Property<int> root{ 0 };
+		auto computeCount = 0;
+		// Every node reads the root as well as the node before it, so a node hears about a change
+		// twice per wave and has to wait until its whole rank is settled
+		std::vector<std::unique_ptr<DerivedProperty<int>>> chain;
+		chain.reserve(Depth);
+		chain.push_back(std::make_unique<DerivedProperty<int>>([&computeCount](const int value)
+		{
+			computeCount++;
+			return value;
+		}, root));
+		for (auto i = 1; i < Depth; i++)
+		{
+			chain.push_back(std::make_unique<DerivedProperty<int>>([&computeCount](const int previous, const int value)
+			{
+				computeCount++;
+				return previous + value;
+			}, *chain.back(), root));
+		}
+		CheckEqual(chain.back()->GetRank(), static_cast<std::size_t>(Depth));
+
+		std::vector<int> seen;
+		Unused(chain.back()->AddObserver([&seen](const auto& value) { seen.push_back(*value); }));
+
+		computeCount = 0;
+		root.Set(3);
+		CheckEqual(computeCount, Depth);
+		CheckEqual(seen, std::vector{ 3 * Depth });
+
+		computeCount = 0;
+		root.Set(3);
+		CheckEqual(computeCount, 0);
+	} };
+}
@@ -0,0 +1,320 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Color;
+import PGUI.UI.Brush;
+import PGUI.UI.TextLayout;
+import PGUI.UI.DisplayList;
+import PGUI.UI.D2D.D2DEnums;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	enum class Call
+	{
+		FillRectangle,
+		DrawRectangle,
+		FillRoundedRectangle,
+		DrawRoundedRectangle,
+		FillEllipse,
+		DrawEllipse,
+		DrawLine,
+		DrawText,
+		PushAxisAlignedClip,
+		PopAxisAlignedClip,
+		PushTransform,
+		PopTransform
+	};
+
+	struct RecordedCall
+	{
+		Call call;
+		std::array<float, 7> values{ };
+		const Brush* brush = nullptr;
+		const TextLayout* layout = nullptr;
+
+		[[nodiscard]] auto operator==(const RecordedCall&) const noexcept -> bool = default;
+	};
+
+	// Stands in for Graphics, keeps every call with its arguments instead of drawing
+	class MockTarget
+	{
+		public:
+		auto FillRectangle(const RectF rect, const Brush& brush) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::FillRectangle, Values(rect), &brush });
+		}
+		auto DrawRectangle(const RectF rect, const Brush& brush, const float strokeWidth) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::DrawRectangle, Values(rect, strokeWidth), &brush });
+		}
+		auto FillRoundedRectangle(const RoundedRect rect, const Brush& brush) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::FillRoundedRectangle, Values(rect), &brush });
+		}
+		auto DrawRoundedRectangle(const RoundedRect rect, const Brush& brush, const float strokeWidth) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::DrawRoundedRectangle, Values(rect, strokeWidth), &brush });
+		}
+		auto FillEllipse(const Ellipse ellipse, const Brush& brush) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::FillEllipse, Values(ellipse), &brush });
+		}
+		auto DrawEllipse(const Ellipse ellipse, const Brush& brush, const float strokeWidth) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::DrawEllipse, Values(ellipse, strokeWidth), &brush });
+		}
+		auto DrawLine(const PointF p1, const PointF p2, const Brush& brush, const float strokeWidth) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::DrawLine, { p1.x, p1.y, p2.x, p2.y, strokeWidth }, &brush });
+		}
+		auto DrawText(const TextLayout& layout, const PointF origin, const Brush& brush) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::DrawText, { origin.x, origin.y }, &brush, &layout });
+		}
+		auto PushAxisAlignedClip(const RectF rect, const D2D::AntiAliasingMode antiAliasingMode) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{
+				Call::PushAxisAlignedClip,
+				{ rect.left, rect.top, rect.right, rect.bottom, static_cast<float>(antiAliasingMode) }
+			});
+		}
+		auto PopAxisAlignedClip() const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::PopAxisAlignedClip });
+		}
+		auto PushTransform(const Matrix3x2& transform) const noexcept -> void
+		{
+			calls.push_back(RecordedCall{
+				Call::PushTransform,
+				{ transform.m11, transform.m12, transform.m21, transform.m22, transform.m31, transform.m32 }
+			});
+		}
+		auto PopTransform() const noexcept -> void
+		{
+			calls.push_back(RecordedCall{ Call::PopTransform });
+		}
+
+		[[nodiscard]] auto GetCalls() const noexcept -> const std::vector<RecordedCall>& { return calls; }
+
+		private:
+		// Replay hands out the target as const, like Graphics
+		mutable std::vector<RecordedCall> calls;
+
+		[[nodiscard]] static auto Values(const RectF rect, const float strokeWidth = 0.0F) noexcept -> std::array<float, 7>
+		{
+			return { rect.left, rect.top, rect.right, rect.bottom, strokeWidth };
+		}
+		[[nodiscard]] static auto Values(const RoundedRect rect, const float strokeWidth = 0.0F) noexcept
+			-> std::array<float, 7>
+		{
+			return {
+				rect.left, rect.top, rect.right, rect.bottom, rect.xRadius, rect.yRadius, strokeWidth
+			};
+		}
+		[[nodiscard]] static auto Values(const Ellipse ellipse, const float strokeWidth = 0.0F) noexcept
+			-> std::array<float, 7>
+		{
+			return {
+				ellipse.center.x, ellipse.center.y, ellipse.xRadius, ellipse.yRadius, strokeWidth
+			};
+		}
+	};
+
+	static_assert(DisplayListTarget<MockTarget>);
+
+	// Makes the same call on the list and on the mock, so replaying the list has to match the mock
+	class Mirror
+	{
+		public:
+		Mirror(DisplayList& list, MockTarget& expected) noexcept :
+			list{ list }, expected{ expected }
+		{
+		}
+
+		auto Draw(const std::size_t command, const std::span<const float, 6> v,
+		          const Brush& brush, const TextLayout& layout) const noexcept -> void
+		{
+			const RectF rect{ v[0], v[1], v[2], v[3] };
+			const RoundedRect roundedRect{ v[0], v[1], v[2], v[3], v[4], v[5] };
+			const Ellipse ellipse{ PointF{ v[0], v[1] }, v[2], v[3] };
+			const PointF p1{ v[0], v[1] };
+			const PointF p2{ v[2], v[3] };
+			const auto strokeWidth = v[4];
+			const auto mode = v[5] < 0.5F ? D2D::AntiAliasingMode::Aliased : D2D::AntiAliasingMode::PerPrimitive;
+			const Matrix3x2 transform{ v[0], v[1], v[2], v[3], v[4], v[5] };
+
+			const auto both = [this](const auto& draw)
+			{
+				draw(list.get());
+				draw(expected.get());
+			};
+			switch (static_cast<Call>(command))
+			{
+				case Call::FillRectangle:
+					both([&](auto& target) { target.FillRectangle(rect, brush); });
+					break;
+				case Call::DrawRectangle:
+					both([&](auto& target) { target.DrawRectangle(rect, brush, strokeWidth); });
+					break;
+				case Call::FillRoundedRectangle:
+					both([&](auto& target) { target.FillRoundedRectangle(roundedRect, brush); });
+					break;
+				case Call::DrawRoundedRectangle:
+					both([&](auto& target) { target.DrawRoundedRectangle(roundedRect, brush, strokeWidth); });
+					break;
+				case Call::FillEllipse:
+					both([&](auto& target) { target.FillEllipse(ellipse, brush); });
+					break;
+				case Call::DrawEllipse:
+					both([&](auto& target) { target.DrawEllipse(ellipse, brush, strokeWidth); });
+					break;
+				case Call::DrawLine:
+					both([&](auto& target) { target.DrawLine(p1, p2, brush, strokeWidth); });
+					break;
+				case Call::DrawText:
+					both([&](auto& target) { target.DrawText(layout, p1, brush); });
+					break;
+				case Call::PushAxisAlignedClip:
+					both([&](auto& target) { target.PushAxisAlignedClip(rect, mode); });
+					break;
+				case Call::PopAxisAlignedClip:
+					both([](auto& target) { target.PopAxisAlignedClip(); });
+					break;
+				case Call::PushTransform:
+					both([&](auto& target) { target.PushTransform(transform); });
+					break;
+				case Call::PopTransform:
+					both([](auto& target) { target.PopTransform(); });
+					break;
+			}
+		}
+
+		private:
+		std::reference_wrapper<DisplayList> list;
+		std::reference_wrapper<MockTarget> expected;
+	};
+
+	constexpr auto CallCount = static_cast<std::size_t>(Call::PopTransform) + 1;
+
+	[[nodiscard]] auto MakeBrush(const RGBA color) noexcept
+	{
+		return Brush{ BrushParameters{ color } };
+	}
+
+	const RegisterTest replaysEveryCommand{ "DisplayList", "ReplaysEveryCommandInOrder", []
+	{
+		const auto brush = MakeBrush(RGBA{ 1, 0, 0 });
+		const TextLayout layout;
+
+		DisplayList list;
+		MockTarget expected;
+		const Mirror mirror{ list, expected };
+		const std::array values{ 1.5F, 2.25F, 30.0F, 40.75F, 3.0F, 4.0F };
+		for (const auto command : std::views::iota(0ULL, CallCount))
+		{
+			mirror.Draw(command, values, brush, layout);
+		}
+		CheckEqual(list.GetCommandCount(), CallCount);
+
+		MockTarget replayed;
+		list.Replay(replayed);
+		CheckEqual(replayed.GetCalls().size(), CallCount);
+		Check(replayed.GetCalls() == expected.GetCalls(), "the replay made the recorded calls with the same arguments");
+	} };
+
+	const RegisterTest resourcesAreReferenced{ "DisplayList", "ReplayPassesTheRecordedResources", []
+	{
+		const auto red = MakeBrush(RGBA{ 1, 0, 0 });
+		const auto blue = MakeBrush(RGBA{ 0, 0, 1 });
+		const TextLayout title;
+		const TextLayout body;
+
+		DisplayList list;
+		list.FillRectangle(RectF{ 0, 0, 10, 10 }, red);
+		list.DrawText(title, PointF{ 1, 1 }, blue);
+		list.FillRectangle(RectF{ 0, 10, 10, 20 }, blue);
+		list.DrawText(body, PointF{ 1, 11 }, red);
+		list.DrawText(title, PointF{ 1, 21 }, red);
+
+		MockTarget replayed;
+		list.Replay(replayed);
+		const auto& calls = replayed.GetCalls();
+		CheckEqual(calls.size(), 5ULL);
+
+		// The very objects that were recorded come back, not copies
+		CheckEqual(calls[0].brush, &red);
+		CheckEqual(calls[1].brush, &blue);
+		CheckEqual(calls[1].layout, &title);
+		CheckEqual(calls[2].brush, &blue);
+		CheckEqual(calls[3].brush, &red);
+		CheckEqual(calls[3].layout, &body);
+		CheckEqual(calls[4].layout, &title);
+	} };
+
+	const RegisterTest clearStartsOver{ "DisplayList", "ClearStartsANewRecording", []
+	{
+		const auto first = MakeBrush(RGBA{ 1, 0, 0 });
+		const auto second = MakeBrush(RGBA{ 0, 1, 0 });
+
+		DisplayList list;
+		list.FillEllipse(Ellipse{ PointF{ 5, 5 }, 5 }, first);
+		list.PushTransform(Matrix3x2::Translation(3, 4));
+		list.PopTransform();
+		const auto recordedBytes = list.GetByteSize();
+
+		list.Clear();
+		Check(list.IsEmpty(), "the list is empty after Clear");
+		CheckEqual(list.GetByteSize(), 0ULL);
+		MockTarget empty;
+		list.Replay(empty);
+		Check(empty.GetCalls().empty(), "an empty list replays nothing");
+
+		// The resource tables start over too, the new brush takes the old brush's index
+		list.FillEllipse(Ellipse{ PointF{ 5, 5 }, 5 }, second);
+		list.PushTransform(Matrix3x2::Translation(3, 4));
+		list.PopTransform();
+		CheckEqual(list.GetByteSize(), recordedBytes);
+
+		MockTarget replayed;
+		list.Replay(replayed);
+		CheckEqual(replayed.GetCalls().size(), 3ULL);
+		CheckEqual(replayed.GetCalls().front().brush, &second);
+	} };
+
+	const RegisterTest randomRecordings{ "DisplayList", "RandomRecordingsReplayExactly", []
+	{
+		std::mt19937 random{ 23 };
+		std::uniform_int_distribution<std::size_t> command{ 0, CallCount - 1 };
+		std::uniform_real_distribution value{ -500.0F, 500.0F };
+
+		const std::array brushes{
+			MakeBrush(RGBA{ 1, 0, 0 }), MakeBrush(RGBA{ 0, 1, 0 }), MakeBrush(RGBA{ 0, 0, 1 })
+		};
+		const std::array<TextLayout, 2> layouts{ };
+
+		DisplayList list;
+		for (auto round = 0; round < 20; round++)
+		{
+			// Reuses the storage of the previous round
+			list.Clear();
+			MockTarget expected;
+			const Mirror mirror{ list, expected };
+			for (auto i = 0; i < 500; i++)
+			{
+				std::array<float, 6> values{ };
+				std::ranges::generate(values, [&] { return value(random); });
+				mirror.Draw(command(random), values, brushes[random() % brushes.size()], layouts[random() % layouts.size()]);
+			}
+
+			MockTarget replayed;
+			list.Replay(replayed);
+			CheckEqual(list.GetCommandCount(), 500ULL);
+			Check(replayed.GetCalls() == expected.GetCalls(), "the replay matches the direct calls");
+		}
+	} };
+}
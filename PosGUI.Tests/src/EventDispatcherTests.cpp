@@ -0,0 +1,174 @@
+import std;
+
+import PGUI.EventDispatcher;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Holds the only worker of a dispatcher until released so the queue can fill up
+	class BlockedWorker
+	{
+		public:
+		explicit BlockedWorker(EventDispatcher& dispatcher) noexcept
+		{
+			dispatcher.Post([this]
+			{
+				started.count_down();
+				release.wait();
+			});
+			started.wait();
+		}
+
+		auto Release() noexcept -> void { release.count_down(); }
+
+		private:
+		std::latch started{ 1 };
+		std::latch release{ 1 };
+	};
+
+	const RegisterTest fullQueueRejects{ "EventDispatcher", "FullQueueRejectsWithoutBlocking", []
+	{
+		constexpr auto TaskCount = 16;
+		EventDispatcher dispatcher{ 1, 2 };
+		BlockedWorker worker{ dispatcher };
+
+		const auto postingThread = std::this_thread::get_id();
+		std::vector<int> order;
+		auto ranInline = false;
+		std::vector<PostResult> results;
+		for (auto i = 0; i < TaskCount; i++)
+		{
+			results.push_back(dispatcher.Post([&, i]
+			{
+				ranInline |= std::this_thread::get_id() == postingThread;
+				order.push_back(i);
+			}));
+		}
+
+		// The default policy never makes the posting thread wait, the queue stays at its capacity
+		CheckEqual(std::ranges::count(results, PostResult::Queued), 2);
+		CheckEqual(std::ranges::count(results, PostResult::Rejected), TaskCount - 2);
+		CheckEqual(dispatcher.GetPendingCount(), 2ULL);
+		CheckEqual(dispatcher.GetDroppedCount(), static_cast<std::size_t>(TaskCount - 2));
+		Check(order.empty(), "no task ran while the worker was blocked");
+
+		std::latch done{ 1 };
+		worker.Release();
+		while (dispatcher.Post([&done] { done.count_down(); }) == PostResult::Rejected)
+		{
+			std::this_thread::yield();
+		}
+		done.wait();
+
+		Check(!ranInline, "tasks ran on the worker");
+		CheckEqual(order, std::vector{ 0, 1 });
+	} };
+
+	const RegisterTest dropOldestKeepsNewest{ "EventDispatcher", "DropOldestKeepsNewestTasks", []
+	{
+		EventDispatcher dispatcher{ 1, 2, OverflowPolicy::DropOldest };
+		BlockedWorker worker{ dispatcher };
+
+		std::vector<int> order;
+		std::vector<PostResult> results;
+		for (auto i = 0; i < 5; i++)
+		{
+			results.push_back(dispatcher.Post([&order, i] { order.push_back(i); }));
+		}
+		CheckEqual(results, std::vector{
+			           PostResult::Queued, PostResult::Queued,
+			           PostResult::DroppedOldest, PostResult::DroppedOldest, PostResult::DroppedOldest
+		           });
+		CheckEqual(dispatcher.GetPendingCount(), 2ULL);
+		CheckEqual(dispatcher.GetDroppedCount(), 3ULL);
+
+		// Posting while the queue is still full would drop another task
+		worker.Release();
+		while (dispatcher.GetPendingCount() == 2)
+		{
+			std::this_thread::yield();
+		}
+		std::latch done{ 1 };
+		CheckEqual(dispatcher.Post([&done] { done.count_down(); }), PostResult::Queued);
+		done.wait();
+		CheckEqual(order, std::vector{ 3, 4 });
+	} };
+
+	const RegisterTest fullQueueWaitsForRoom{ "EventDispatcher", "FullQueueWaitsForRoom", []
+	{
+		EventDispatcher dispatcher{ 1, 1, OverflowPolicy::Wait, std::chrono::seconds{ 10 } };
+		BlockedWorker worker{ dispatcher };
+		std::latch done{ 2 };
+
+		CheckEqual(dispatcher.Post([&done] { done.count_down(); }), PostResult::Queued);
+		std::jthread releaser{ [&worker]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+			worker.Release();
+		} };
+		CheckEqual(dispatcher.Post([&done] { done.count_down(); }), PostResult::Queued);
+		done.wait();
+
+		CheckEqual(dispatcher.GetDroppedCount(), 0ULL);
+	} };
+
+	const RegisterTest waitGivesUp{ "EventDispatcher", "WaitRejectsAfterTimeout", []
+	{
+		EventDispatcher dispatcher{ 1, 1, OverflowPolicy::Wait, std::chrono::milliseconds{ 5 } };
+		BlockedWorker worker{ dispatcher };
+
+		auto ran = false;
+		CheckEqual(dispatcher.Post([] { }), PostResult::Queued);
+		CheckEqual(dispatcher.Post([&ran] { ran = true; }), PostResult::Rejected);
+		CheckEqual(dispatcher.GetPendingCount(), 1ULL);
+		CheckEqual(dispatcher.GetDroppedCount(), 1ULL);
+
+		worker.Release();
+		Check(!ran, "the rejected task never runs");
+	} };
+
+	const RegisterTest coalescedRunsLatest{ "EventDispatcher", "CoalescedPostRunsLatestTask", []
+	{
+		EventDispatcher dispatcher{ 1, 4 };
+		BlockedWorker worker{ dispatcher };
+		const auto key = EventDispatcher::NewDispatchKey();
+
+		std::vector<int> values;
+		std::latch done{ 1 };
+		CheckEqual(dispatcher.PostCoalesced(key, [&values] { values.push_back(0); }), PostResult::Queued);
+		for (auto i = 1; i < 10; i++)
+		{
+			CheckEqual(dispatcher.PostCoalesced(key, [&values, i] { values.push_back(i); }), PostResult::Coalesced);
+		}
+		dispatcher.Post([&done] { done.count_down(); });
+		CheckEqual(dispatcher.GetPendingCount(), 2ULL);
+
+		worker.Release();
+		done.wait();
+		CheckEqual(values, std::vector{ 9 });
+	} };
+
+	const RegisterTest workerPostsDontBlock{ "EventDispatcher", "WorkerPostsToFullQueueDontBlock", []
+	{
+		EventDispatcher dispatcher{ 1, 1, OverflowPolicy::Wait, std::chrono::seconds{ 10 } };
+		std::latch done{ 1 };
+		std::vector<PostResult> results;
+
+		dispatcher.Post([&]
+		{
+			// The posting worker is the only one that could make room, waiting would never end
+			for (auto i = 0; i < 8; i++)
+			{
+				results.push_back(dispatcher.Post([] { }));
+			}
+			done.count_down();
+		});
+		done.wait();
+
+		CheckEqual(std::ranges::count(results, PostResult::Queued), 1);
+		CheckEqual(std::ranges::count(results, PostResult::Rejected), 7);
+	} };
+}
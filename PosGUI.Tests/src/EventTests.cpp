@@ -0,0 +1,63 @@
+import std;
+
+import PGUI.Event;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest staleIdKeepsReusedSlot{ "Event", "StaleIdDoesNotRemoveReusedSlot", []
+	{
+		EventNM<int> event;
+		auto first = 0;
+		auto second = 0;
+
+		const auto staleId = event.AddCallback([&first](const int value) { first += value; });
+		event.RemoveCallback(staleId);
+		const auto id = event.AddCallback([&second](const int value) { second += value; });
+		Check(id != staleId, "the reused slot got a new generation");
+
+		event.RemoveCallback(staleId);
+		event.Invoke(1);
+		CheckEqual(first, 0);
+		CheckEqual(second, 1);
+
+		event.RemoveCallback(id);
+		event.Invoke(1);
+		CheckEqual(second, 1);
+	} };
+
+	const RegisterTest snapshotClearKeepsGenerations{ "Event", "SnapshotClearDoesNotReuseIds", []
+	{
+		EventSnapshot<int> event;
+		auto first = 0;
+		auto second = 0;
+
+		const auto staleId = event.AddCallback([&first](const int value) { first += value; });
+		event.ClearCallbacks();
+		const auto id = event.AddCallback([&second](const int value) { second += value; });
+		Check(id != staleId, "the cleared slot got a new generation");
+
+		Check(!event.RemoveCallback(staleId), "the stale id matches nothing");
+		event.Invoke(1);
+		CheckEqual(first, 0);
+		CheckEqual(second, 1);
+	} };
+
+	const RegisterTest generationsUseHighBits{ "Event", "GenerationsSurviveManyReuses", []
+	{
+		EventNM<> event;
+		std::unordered_set<CallbackId> ids;
+
+		// Every id handed out for the same slot has to stay distinct, which needs a 64 bit id on 32 bit targets too
+		for (auto i = 0; i < 1000; i++)
+		{
+			const auto id = event.AddCallback([] { });
+			Check(ids.insert(id).second, "ids are never handed out twice");
+			event.RemoveCallback(id);
+		}
+		CheckEqual(ids.size(), 1000ULL);
+	} };
+}
@@ -0,0 +1,101 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest matchesNaiveSums{ "FenwickTree", "MatchesNaiveSums", []
+	{
+		std::mt19937 random{ 5 };
+		std::uniform_int_distribution value{ 0, 100 };
+
+		FenwickTree<long long> tree;
+		std::vector<long long> naive;
+		for (auto step = 0; step < 5'000; step++)
+		{
+			switch (step % 4)
+			{
+				case 0:
+					naive.push_back(value(random));
+					tree.PushBack(naive.back());
+					break;
+				case 1:
+				{
+					const auto index = std::uniform_int_distribution<std::size_t>{ 0, naive.size() - 1 }(random);
+					naive[index] = value(random);
+					tree.Set(index, naive[index]);
+					break;
+				}
+				case 2:
+				{
+					const auto index = std::uniform_int_distribution<std::size_t>{ 0, naive.size() - 1 }(random);
+					naive[index] += 3;
+					tree.Add(index, 3);
+					break;
+				}
+				default:
+				{
+					const auto count = std::uniform_int_distribution<std::size_t>{ 0, naive.size() }(random);
+					CheckEqual(tree.PrefixSum(count), std::accumulate(naive.begin(), naive.begin() + count, 0LL));
+
+					const auto target = std::uniform_int_distribution<long long>{ 0, tree.Total() }(random);
+					auto covering = 0ULL;
+					for (auto sum = 0LL; covering < naive.size() && sum + naive[covering] <= target; covering++)
+					{
+						sum += naive[covering];
+					}
+					CheckEqual(tree.FindByPrefixSum(target), covering);
+					break;
+				}
+			}
+		}
+
+		tree.Resize(10);
+		naive.resize(10);
+		CheckEqual(tree.Total(), std::accumulate(naive.begin(), naive.end(), 0LL));
+		CheckEqual(FenwickTree<long long>{ naive }.Total(), tree.Total());
+	} };
+
+	const RegisterTest setKeepsExactValue{ "FenwickTree", "SetKeepsExactValue", []
+	{
+		FenwickTree<float> tree{ 4, 0.0F };
+		tree.Set(2, 1e7F);
+		tree.Set(2, 0.1F);
+
+		// Adding the difference to the old value would round it away
+		CheckEqual(tree.Get(2), 0.1F);
+	} };
+
+	const RegisterBenchmark floatDrift{ "FenwickTree", "FloatAndDoubleDrift", []
+	{
+		constexpr auto Count = 1'000'000ULL;
+		constexpr auto Updates = 1'000'000;
+
+		std::mt19937 random{ 11 };
+		std::uniform_real_distribution extent{ 10.0F, 60.0F };
+		std::uniform_int_distribution<std::size_t> index{ 0, Count - 1 };
+
+		std::vector<float> exact(Count, 24.0F);
+		FenwickTree<float> floats{ Count, 24.0F };
+		FenwickTree<double> doubles{ Count, 24.0 };
+		Unused(Measure("1M point updates on a float and a double tree", Updates, [&]
+		{
+			const auto i = index(random);
+			const auto value = extent(random);
+			exact[i] = value;
+			floats.Set(i, value);
+			doubles.Set(i, value);
+		}));
+
+		const auto total = std::accumulate(exact.begin(), exact.end(), 0.0L);
+		const auto floatError = std::abs(static_cast<long double>(floats.Total()) - total);
+		const auto doubleError = std::abs(static_cast<long double>(doubles.Total()) - total);
+		std::println("  total {:.1f}, float tree off by {:.3f}, double tree off by {:.3g}",
+		             static_cast<double>(total), static_cast<double>(floatError), static_cast<double>(doubleError));
+		Check(doubleError < 1e-3L, "the double tree stays exact to well under a pixel");
+	} };
+}
@@ -0,0 +1,349 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.FlexLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	struct FlexContainer
+	{
+		SizeF size{ 300, 100 };
+		LayoutOrientation direction = LayoutOrientation::Horizontal;
+		MainAxisAlignment justifyContent = MainAxisAlignment::Start;
+		CrossAxisAlignment alignItems = CrossAxisAlignment::Stretch;
+		MainAxisAlignment alignContent = MainAxisAlignment::Start;
+		WrapMode wrapMode = WrapMode::NoWrap;
+		float gap = 0;
+		float crossGap = 0;
+	};
+
+	struct FlexItem
+	{
+		SizeF desiredSize;
+		FlexItemProperties properties{ };
+	};
+
+	// Expected rects follow the CSS flexbox algorithm, items in the order they were added
+	struct FlexCase
+	{
+		std::string_view name;
+		FlexContainer container;
+		std::vector<FlexItem> items;
+		std::vector<RectF> expected;
+	};
+
+	auto RunCase(const FlexCase& flexCase) -> void
+	{
+		const auto& container = flexCase.container;
+		FlexLayout flex{
+			RectF{ PointF{ 0, 0 }, container.size }, container.direction,
+			container.justifyContent, container.alignItems, container.wrapMode,
+			container.gap, container.crossGap
+		};
+		flex.SetAlignContent(container.alignContent);
+
+		std::vector<LayoutSpacer> spacers;
+		spacers.reserve(flexCase.items.size());
+		for (const auto& item : flexCase.items)
+		{
+			flex.AddItem(spacers.emplace_back(item.desiredSize), item.properties);
+		}
+		flex.UpdateLayout();
+
+		CheckEqual(flexCase.expected.size(), spacers.size());
+		for (const auto& [spacer, expected] : std::views::zip(spacers, flexCase.expected))
+		{
+			const auto rect = spacer.GetRect();
+			CheckNear(rect.left, expected.left, 0.01);
+			CheckNear(rect.top, expected.top, 0.01);
+			CheckNear(rect.right, expected.right, 0.01);
+			CheckNear(rect.bottom, expected.bottom, 0.01);
+		}
+	}
+
+	auto RunCases(const std::span<const FlexCase> cases) -> void
+	{
+		for (const auto& flexCase : cases)
+		{
+			try
+			{
+				RunCase(flexCase);
+			}
+			catch (CheckFailure& failure)
+			{
+				failure.message = std::format("{}: {}", flexCase.name, failure.message);
+				throw;
+			}
+		}
+	}
+
+	[[nodiscard]] auto Grow(const float grow, const std::optional<float> basis = std::nullopt) -> FlexItemProperties
+	{
+		return FlexItemProperties{ .grow = grow, .basis = basis };
+	}
+
+	[[nodiscard]] auto Rects(const std::initializer_list<std::array<float, 4>> rects) -> std::vector<RectF>
+	{
+		std::vector<RectF> result;
+		for (const auto& [x, y, width, height] : rects)
+		{
+			result.emplace_back(x, y, x + width, y + height);
+		}
+
+		return result;
+	}
+
+	const RegisterTest flexibleLengths{ "FlexLayout", "FlexibleLengths", []
+	{
+		const std::vector<FlexCase> cases{
+			{
+				.name = "grow splits the free space by factor",
+				.items = { { { 50, 20 }, Grow(1) }, { { 50, 20 }, Grow(2) }, { { 50, 20 }, Grow(1) } },
+				.expected = Rects({ { 0, 0, 87.5F, 100 }, { 87.5F, 0, 125, 100 }, { 212.5F, 0, 87.5F, 100 } })
+			},
+			{
+				.name = "grow factors summing below one take that share of the free space",
+				.items = { { { 50, 20 }, Grow(0.25F) }, { { 50, 20 }, Grow(0.25F) } },
+				.expected = Rects({ { 0, 0, 100, 100 }, { 100, 0, 100, 100 } })
+			},
+			{
+				.name = "shrink is weighted by the flex basis",
+				.container = { .size = { 240, 100 } },
+				.items = { { { 10, 20 }, { .basis = 200 } }, { { 10, 20 }, { .basis = 100 } } },
+				.expected = Rects({ { 0, 0, 160, 100 }, { 160, 0, 80, 100 } })
+			},
+			{
+				.name = "basis overrides the content size",
+				.items = { { { 80, 20 }, { .basis = 30 } } },
+				.expected = Rects({ { 0, 0, 30, 100 } })
+			},
+			{
+				.name = "max violation freezes the item and redistributes",
+				.items = {
+					{ { 0, 20 }, { .grow = 1, .basis = 0, .maxMainSize = 50 } },
+					{ { 0, 20 }, Grow(1, 0) },
+					{ { 0, 20 }, Grow(1, 0) }
+				},
+				.expected = Rects({ { 0, 0, 50, 100 }, { 50, 0, 125, 100 }, { 175, 0, 125, 100 } })
+			},
+			{
+				.name = "min violation while shrinking freezes the item and redistributes",
+				.items = {
+					{ { 0, 20 }, { .basis = 200, .minMainSize = 180 } },
+					{ { 0, 20 }, { .basis = 200 } }
+				},
+				.expected = Rects({ { 0, 0, 180, 100 }, { 180, 0, 120, 100 } })
+			},
+			{
+				.name = "items without shrink overflow",
+				.items = { { { 200, 20 }, { .shrink = 0 } }, { { 200, 20 }, { .shrink = 0 } } },
+				.expected = Rects({ { 0, 0, 200, 100 }, { 200, 0, 200, 100 } })
+			},
+			{
+				.name = "gaps are taken from the free space before growing",
+				.container = { .gap = 15 },
+				.items = { { { 0, 20 }, Grow(1, 0) }, { { 0, 20 }, Grow(1, 0) }, { { 0, 20 }, Grow(1, 0) } },
+				.expected = Rects({ { 0, 0, 90, 100 }, { 105, 0, 90, 100 }, { 210, 0, 90, 100 } })
+			},
+			{
+				.name = "column direction flexes the height",
+				.container = { .size = { 100, 300 }, .direction = LayoutOrientation::Vertical },
+				.items = { { { 20, 50 }, Grow(1) }, { { 20, 50 }, Grow(1) } },
+				.expected = Rects({ { 0, 0, 100, 150 }, { 0, 150, 100, 150 } })
+			}
+		};
+		RunCases(cases);
+	} };
+
+	const RegisterTest justifyContent{ "FlexLayout", "JustifyContent", []
+	{
+		const auto threeItems = std::vector<FlexItem>(3, FlexItem{ { 50, 20 } });
+		const auto overflowing = std::vector<FlexItem>(2, FlexItem{ { 200, 20 }, { .shrink = 0 } });
+		const std::vector<FlexCase> cases{
+			{
+				.name = "start",
+				.items = threeItems,
+				.expected = Rects({ { 0, 0, 50, 100 }, { 50, 0, 50, 100 }, { 100, 0, 50, 100 } })
+			},
+			{
+				.name = "center",
+				.container = { .justifyContent = MainAxisAlignment::Center },
+				.items = threeItems,
+				.expected = Rects({ { 75, 0, 50, 100 }, { 125, 0, 50, 100 }, { 175, 0, 50, 100 } })
+			},
+			{
+				.name = "end",
+				.container = { .justifyContent = MainAxisAlignment::End },
+				.items = threeItems,
+				.expected = Rects({ { 150, 0, 50, 100 }, { 200, 0, 50, 100 }, { 250, 0, 50, 100 } })
+			},
+			{
+				.name = "space between",
+				.container = { .justifyContent = MainAxisAlignment::SpaceBetween },
+				.items = threeItems,
+				.expected = Rects({ { 0, 0, 50, 100 }, { 125, 0, 50, 100 }, { 250, 0, 50, 100 } })
+			},
+			{
+				.name = "space around",
+				.container = { .justifyContent = MainAxisAlignment::SpaceAround },
+				.items = threeItems,
+				.expected = Rects({ { 25, 0, 50, 100 }, { 125, 0, 50, 100 }, { 225, 0, 50, 100 } })
+			},
+			{
+				.name = "space evenly",
+				.container = { .justifyContent = MainAxisAlignment::SpaceEvenly },
+				.items = threeItems,
+				.expected = Rects({ { 37.5F, 0, 50, 100 }, { 125, 0, 50, 100 }, { 212.5F, 0, 50, 100 } })
+			},
+			{
+				.name = "space between falls back to start on overflow",
+				.container = { .justifyContent = MainAxisAlignment::SpaceBetween },
+				.items = overflowing,
+				.expected = Rects({ { 0, 0, 200, 100 }, { 200, 0, 200, 100 } })
+			},
+			{
+				.name = "space around falls back to center on overflow",
+				.container = { .justifyContent = MainAxisAlignment::SpaceAround },
+				.items = overflowing,
+				.expected = Rects({ { -50, 0, 200, 100 }, { 150, 0, 200, 100 } })
+			},
+			{
+				.name = "space between with a single item is start",
+				.container = { .justifyContent = MainAxisAlignment::SpaceBetween },
+				.items = { { { 50, 20 } } },
+				.expected = Rects({ { 0, 0, 50, 100 } })
+			}
+		};
+		RunCases(cases);
+	} };
+
+	const RegisterTest alignment{ "FlexLayout", "CrossAxisAlignment", []
+	{
+		const auto oneItem = std::vector<FlexItem>{ { { 50, 20 } } };
+		const std::vector<FlexCase> cases{
+			{
+				.name = "align items start",
+				.container = { .alignItems = CrossAxisAlignment::Start },
+				.items = oneItem,
+				.expected = Rects({ { 0, 0, 50, 20 } })
+			},
+			{
+				.name = "align items center",
+				.container = { .alignItems = CrossAxisAlignment::Center },
+				.items = oneItem,
+				.expected = Rects({ { 0, 40, 50, 20 } })
+			},
+			{
+				.name = "align items end",
+				.container = { .alignItems = CrossAxisAlignment::End },
+				.items = oneItem,
+				.expected = Rects({ { 0, 80, 50, 20 } })
+			},
+			{
+				.name = "align items stretch",
+				.items = oneItem,
+				.expected = Rects({ { 0, 0, 50, 100 } })
+			},
+			{
+				.name = "align self overrides align items",
+				.container = { .alignItems = CrossAxisAlignment::Start },
+				.items = {
+					{ { 50, 20 } },
+					{ { 50, 20 }, { .alignSelf = CrossAxisAlignment::End } },
+					{ { 50, 20 }, { .alignSelf = CrossAxisAlignment::Stretch } }
+				},
+				.expected = Rects({ { 0, 0, 50, 20 }, { 50, 80, 50, 20 }, { 100, 0, 50, 100 } })
+			}
+		};
+		RunCases(cases);
+	} };
+
+	const RegisterTest orderAndWrap{ "FlexLayout", "OrderAndWrapping", []
+	{
+		const std::vector<FlexCase> cases{
+			{
+				.name = "order places items ascending and keeps insertion order for ties",
+				.items = {
+					{ { 10, 20 }, { .order = 2 } },
+					{ { 20, 20 }, { .order = 0 } },
+					{ { 30, 20 }, { .order = 1 } },
+					{ { 40, 20 }, { .order = 0 } }
+				},
+				.expected = Rects({ { 90, 0, 10, 100 }, { 0, 0, 20, 100 }, { 60, 0, 30, 100 }, { 20, 0, 40, 100 } })
+			},
+			{
+				.name = "wrap breaks lines at the main size and stretches to the line",
+				.container = { .size = { 100, 100 }, .wrapMode = WrapMode::Wrap, .crossGap = 5 },
+				.items = {
+					{ { 40, 10 } }, { { 40, 20 } }, { { 40, 10 } }, { { 40, 10 } }, { { 40, 10 } }
+				},
+				.expected = Rects({
+					{ 0, 0, 40, 20 }, { 40, 0, 40, 20 },
+					{ 0, 25, 40, 10 }, { 40, 25, 40, 10 },
+					{ 0, 40, 40, 10 }
+				})
+			},
+			{
+				.name = "each line flexes on its own",
+				.container = { .size = { 100, 100 }, .alignItems = CrossAxisAlignment::Start, .wrapMode = WrapMode::Wrap },
+				.items = { { { 40, 10 }, Grow(1) }, { { 40, 10 }, Grow(1) }, { { 40, 10 }, Grow(1) } },
+				.expected = Rects({ { 0, 0, 50, 10 }, { 50, 0, 50, 10 }, { 0, 10, 100, 10 } })
+			},
+			{
+				.name = "the main gap counts when breaking lines",
+				.container = { .size = { 100, 100 }, .alignItems = CrossAxisAlignment::Start, .wrapMode = WrapMode::Wrap, .gap = 30 },
+				.items = { { { 40, 10 } }, { { 40, 10 } } },
+				.expected = Rects({ { 0, 0, 40, 10 }, { 0, 10, 40, 10 } })
+			},
+			{
+				.name = "align content centers the lines",
+				.container = {
+					.size = { 100, 100 }, .alignItems = CrossAxisAlignment::Start,
+					.alignContent = MainAxisAlignment::Center, .wrapMode = WrapMode::Wrap
+				},
+				.items = { { { 60, 20 } }, { { 60, 20 } }, { { 60, 20 } } },
+				.expected = Rects({ { 0, 20, 60, 20 }, { 0, 40, 60, 20 }, { 0, 60, 60, 20 } })
+			},
+			{
+				.name = "align content space between spreads the lines",
+				.container = {
+					.size = { 100, 100 }, .alignItems = CrossAxisAlignment::Start,
+					.alignContent = MainAxisAlignment::SpaceBetween, .wrapMode = WrapMode::Wrap
+				},
+				.items = { { { 60, 20 } }, { { 60, 20 } }, { { 60, 20 } } },
+				.expected = Rects({ { 0, 0, 60, 20 }, { 0, 40, 60, 20 }, { 0, 80, 60, 20 } })
+			}
+		};
+		RunCases(cases);
+	} };
+
+	const RegisterTest cachedSizes{ "FlexLayout", "CachedSizesFollowItemChanges", []
+	{
+		FlexLayout flex{ RectF{ 0, 0, 300, 100 } };
+		std::vector<LayoutSpacer> spacers(2, LayoutSpacer{ SizeF{ 50, 20 } });
+		for (auto& spacer : spacers)
+		{
+			flex.AddItem(spacer, FlexItemProperties{ });
+		}
+		flex.UpdateLayout();
+		CheckNear(spacers[1].GetRect().left, 50, 0.01);
+
+		// Spacers advance their own version, the cache has to notice without an invalidation of the item
+		spacers[0].SetDesiredSize(SizeF{ 80, 20 });
+		flex.InvalidateArrange();
+		flex.UpdateLayout();
+		CheckNear(spacers[1].GetRect().left, 80, 0.01);
+
+		Check(flex.SetItemProperties(1, FlexItemProperties{ .grow = 1 }).has_value(), "properties were set");
+		flex.UpdateLayout();
+		CheckNear(spacers[1].GetRect().Width(), 220, 0.01);
+	} };
+}
@@ -0,0 +1,466 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.GridLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	constexpr auto CellSize = 10L;
+	constexpr auto ColumnCount = 12L;
+
+	// Row, column, row span and column span of an item
+	using Placement = std::array<long, 4>;
+
+	// Placement done with a std::set of occupied cells probed one by one,
+	// the way GridLayout placed its items before it kept an occupancy bitmap
+	class SetPlacementReference
+	{
+		public:
+		SetPlacementReference(const long definedColumns, const GridCellPlacementType placementType) noexcept :
+			definedColumns{ definedColumns }, placementType{ placementType }
+		{
+		}
+
+		auto InsertBlankCell(const long row, const long column) -> void { occupied.emplace(row, column); }
+
+		[[nodiscard]] auto Place(const std::vector<Placement>& requested) -> std::vector<Placement>
+		{
+			long maxDefinedColumn = definedColumns;
+			long maxColumnSpan = 1;
+			for (const auto& [row, column, rowSpan, columnSpan] : requested)
+			{
+				maxDefinedColumn = std::max(maxDefinedColumn, column);
+				maxColumnSpan = std::max(maxColumnSpan, columnSpan);
+			}
+			maxDefinedColumn += maxColumnSpan - 1;
+
+			std::vector<Placement> placements(requested.size());
+			long maxPlacedRow = 0;
+			const auto place = [&](const std::size_t id, const long row, const long column, const long rowSpan, const long columnSpan)
+			{
+				placements[id] = Placement{ row, column, rowSpan, columnSpan };
+				Occupy(row, column, rowSpan, columnSpan);
+				maxPlacedRow = std::max(maxPlacedRow, row + rowSpan - 1);
+			};
+
+			for (const auto id : PlacementOrder(requested))
+			{
+				const auto& [row, column, rowSpan, columnSpan] = requested[id];
+				if (row != AUTO_PLACE && column != AUTO_PLACE)
+				{
+					place(id, row, column, rowSpan, columnSpan);
+				}
+				else if (row != AUTO_PLACE)
+				{
+					auto tryColumn = 0L;
+					while (tryColumn <= maxDefinedColumn - columnSpan && IsOccupied(row, tryColumn, rowSpan, columnSpan))
+					{
+						tryColumn++;
+					}
+					if (tryColumn > maxDefinedColumn - columnSpan)
+					{
+						tryColumn = maxDefinedColumn - 1;
+						while (IsOccupied(row, tryColumn, 1, 1) && tryColumn > 0)
+						{
+							tryColumn--;
+						}
+					}
+					place(id, row, tryColumn, rowSpan, columnSpan);
+				}
+				else if (column != AUTO_PLACE)
+				{
+					auto tryRow = placementType == GridCellPlacementType::Appended ? maxPlacedRow : 0L;
+					while (IsOccupied(tryRow, column, rowSpan, columnSpan))
+					{
+						tryRow++;
+					}
+					place(id, tryRow, column, rowSpan, columnSpan);
+				}
+				else
+				{
+					auto tryRow = placementType == GridCellPlacementType::Appended ? maxPlacedRow : 0L;
+					auto placed = false;
+					while (!placed)
+					{
+						for (auto tryColumn = 0L; tryColumn <= maxDefinedColumn - columnSpan; tryColumn++)
+						{
+							if (!IsOccupied(tryRow, tryColumn, rowSpan, columnSpan))
+							{
+								place(id, tryRow, tryColumn, rowSpan, columnSpan);
+								placed = true;
+								break;
+							}
+						}
+						tryRow++;
+					}
+				}
+			}
+
+			return placements;
+		}
+
+		private:
+		long definedColumns;
+		GridCellPlacementType placementType;
+		std::set<std::pair<long, long>> occupied;
+
+		auto Occupy(const long row, const long column, const long rowSpan, const long columnSpan) -> void
+		{
+			for (auto r = row; r < row + rowSpan; r++)
+			{
+				for (auto c = column; c < column + columnSpan; c++)
+				{
+					occupied.emplace(r, c);
+				}
+			}
+		}
+		[[nodiscard]] auto IsOccupied(const long row, const long column, const long rowSpan, const long columnSpan) const -> bool
+		{
+			for (auto r = row; r < row + rowSpan; r++)
+			{
+				for (auto c = column; c < column + columnSpan; c++)
+				{
+					if (occupied.contains({ r, c }))
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		// Fully defined items by row plus column first, then items with a row, then the rest by column
+		[[nodiscard]] static auto PlacementOrder(const std::vector<Placement>& requested) -> std::vector<std::size_t>
+		{
+			std::vector<std::size_t> order(requested.size());
+			std::iota(order.begin(), order.end(), 0ULL);
+			const auto isDefined = [&requested](const std::size_t id)
+			{
+				return requested[id][0] != AUTO_PLACE && requested[id][1] != AUTO_PLACE;
+			};
+
+			std::ranges::stable_sort(order, [&](const auto lhs, const auto rhs)
+			{
+				if (isDefined(lhs) && isDefined(rhs))
+				{
+					return requested[lhs][0] + requested[lhs][1] < requested[rhs][0] + requested[rhs][1];
+				}
+				return isDefined(lhs);
+			});
+			const auto firstUndefined = std::ranges::find_if_not(order, isDefined) - order.begin();
+			std::stable_sort(order.begin() + firstUndefined, order.end(), [&](const auto lhs, const auto rhs)
+			{
+				return requested[lhs][0] < requested[rhs][0];
+			});
+			const auto firstDefinedRow = std::find_if(order.begin() + firstUndefined, order.end(), [&](const auto id)
+			{
+				return requested[id][0] != AUTO_PLACE;
+			}) - order.begin();
+			std::stable_sort(order.begin() + firstDefinedRow, order.end(), [&](const auto lhs, const auto rhs)
+			{
+				return requested[lhs][1] < requested[rhs][1];
+			});
+
+			return order;
+		}
+	};
+
+	// Grid with fixed square cells so that item rects map back to cells
+	[[nodiscard]] auto MakeGrid(const GridCellPlacementType placementType) -> std::unique_ptr<GridLayout>
+	{
+		auto grid = std::make_unique<GridLayout>(RectF{ 0, 0, ColumnCount * CellSize, 100 * CellSize });
+		grid->SetColumnDefinitions(std::vector<GridCellDefinition>(ColumnCount, GridCellDefinition{ FixedSize{ CellSize } }));
+		Check(grid->SetAutoCellSize(FixedSize{ CellSize }).has_value(), "auto cells are fixed");
+		grid->SetPlacementType(placementType);
+
+		return grid;
+	}
+
+	[[nodiscard]] auto PlacementOf(const LayoutSpacer& spacer) -> Placement
+	{
+		const auto rect = spacer.GetRect();
+		return Placement{
+			std::lround(rect.top / CellSize), std::lround(rect.left / CellSize),
+			std::lround(rect.Height() / CellSize), std::lround(rect.Width() / CellSize)
+		};
+	}
+
+	// Mix of fully defined, half defined and automatic items, spans stay inside the defined columns
+	[[nodiscard]] auto RandomRequests(std::mt19937& random, const std::size_t count) -> std::vector<Placement>
+	{
+		std::uniform_int_distribution kind{ 0, 3 };
+		std::uniform_int_distribution span{ 1L, 3L };
+		std::uniform_int_distribution row{ 0L, 20L };
+
+		std::vector<Placement> requests;
+		requests.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const auto rowSpan = span(random);
+			const auto columnSpan = span(random);
+			const auto column = std::uniform_int_distribution{ 0L, ColumnCount - columnSpan }(random);
+			switch (kind(random))
+			{
+				case 0:
+					requests.push_back(Placement{ row(random), column, rowSpan, columnSpan });
+					break;
+				case 1:
+					requests.push_back(Placement{ row(random), AUTO_PLACE, rowSpan, columnSpan });
+					break;
+				case 2:
+					requests.push_back(Placement{ AUTO_PLACE, column, rowSpan, columnSpan });
+					break;
+				default:
+					requests.push_back(Placement{ AUTO_PLACE, AUTO_PLACE, rowSpan, columnSpan });
+					break;
+			}
+		}
+
+		return requests;
+	}
+
+	auto AddItems(GridLayout& grid, std::vector<LayoutSpacer>& spacers, const std::vector<Placement>& requests) -> void
+	{
+		for (const auto& [spacer, request] : std::views::zip(spacers, requests))
+		{
+			const auto& [row, column, rowSpan, columnSpan] = request;
+			grid.AddItem(spacer, GridItemProperties{ row, column, rowSpan, columnSpan });
+		}
+	}
+
+	// Rect of a placement with the track sizes summed per item, the way GridLayout computed it before
+	// it kept prefix sums of the tracks
+	[[nodiscard]] auto AccumulatedRect(
+		const std::vector<long>& rowSizes, const std::vector<long>& columnSizes,
+		const long gap, const GridLayoutPadding& padding, const Placement& placement) -> RectL
+	{
+		const auto& [row, column, rowSpan, columnSpan] = placement;
+		const PointL position{
+			std::accumulate(columnSizes.begin(), columnSizes.begin() + column, 0L) + column * gap + padding.left,
+			std::accumulate(rowSizes.begin(), rowSizes.begin() + row, 0L) + row * gap + padding.top
+		};
+		const SizeL size{
+			std::accumulate(columnSizes.begin() + column, columnSizes.begin() + column + columnSpan, 0L) + (columnSpan - 1) * gap,
+			std::accumulate(rowSizes.begin() + row, rowSizes.begin() + row + rowSpan, 0L) + (rowSpan - 1) * gap
+		};
+
+		return RectL{ position, size };
+	}
+
+	[[nodiscard]] auto RandomTrackSizes(std::mt19937& random, const std::size_t count) -> std::vector<long>
+	{
+		std::uniform_int_distribution size{ 5L, 40L };
+		std::vector<long> sizes(count);
+		std::ranges::generate(sizes, [&] { return size(random); });
+
+		return sizes;
+	}
+
+	[[nodiscard]] auto ToDefinitions(const std::vector<long>& sizes) -> std::vector<GridCellDefinition>
+	{
+		std::vector<GridCellDefinition> definitions;
+		for (const auto size : sizes)
+		{
+			definitions.emplace_back(FixedSize{ size });
+		}
+
+		return definitions;
+	}
+
+	const RegisterTest matchesSetPlacement{ "GridLayout", "BitmapPlacementMatchesSetPlacement", []
+	{
+		std::mt19937 random{ 1234 };
+		for (auto round = 0; round < 200; round++)
+		{
+			const auto placementType = round % 2 == 0 ? GridCellPlacementType::Packed : GridCellPlacementType::Appended;
+			const auto requests = RandomRequests(random, 1 + round % 60);
+
+			const auto grid = MakeGrid(placementType);
+			SetPlacementReference reference{ ColumnCount, placementType };
+			for (auto i = 0; i < round % 5; i++)
+			{
+				const auto row = std::uniform_int_distribution{ 0L, 10L }(random);
+				const auto column = std::uniform_int_distribution{ 0L, ColumnCount - 1 }(random);
+				Check(grid->InsertBlankCell(row, column).has_value(), "blank cell was inserted");
+				reference.InsertBlankCell(row, column);
+			}
+
+			std::vector<LayoutSpacer> spacers(requests.size());
+			AddItems(*grid, spacers, requests);
+			grid->UpdateLayout();
+
+			const auto expected = reference.Place(requests);
+			for (const auto& [spacer, placement] : std::views::zip(spacers, expected))
+			{
+				CheckEqual(PlacementOf(spacer), placement);
+			}
+		}
+	} };
+
+	const RegisterTest wideSpansCrossWords{ "GridLayout", "SpansAcrossBitmapWords", []
+	{
+		constexpr auto WideColumns = 150L;
+
+		auto grid = std::make_unique<GridLayout>(RectF{ 0, 0, WideColumns * CellSize, 10 * CellSize });
+		grid->SetColumnDefinitions(std::vector<GridCellDefinition>(WideColumns, GridCellDefinition{ FixedSize{ CellSize } }));
+		Check(grid->SetAutoCellSize(FixedSize{ CellSize }).has_value(), "auto cells are fixed");
+
+		// The first row is blocked before and across the word boundary at column 128
+		std::vector<LayoutSpacer> spacers(3);
+		spacers.reserve(5);
+		grid->AddItem(spacers[0], GridItemProperties{ 0, 60, 1, 10 });
+		grid->AddItem(spacers[1], GridItemProperties{ 0, 127, 1, 2 });
+		grid->AddItem(spacers[2], GridItemProperties{ AUTO_PLACE, AUTO_PLACE, 1, 70 });
+		grid->UpdateLayout();
+
+		CheckEqual(PlacementOf(spacers[2]), Placement{ 0, 129, 1, 70 });
+
+		grid->AddItem(spacers.emplace_back(), GridItemProperties{ AUTO_PLACE, AUTO_PLACE, 1, 60 });
+		grid->AddItem(spacers.emplace_back(), GridItemProperties{ AUTO_PLACE, AUTO_PLACE, 1, 58 });
+		grid->UpdateLayout();
+		CheckEqual(PlacementOf(spacers[3]), Placement{ 0, 0, 1, 60 });
+		CheckEqual(PlacementOf(spacers[4]), Placement{ 1, 0, 1, 58 });
+	} };
+
+	const RegisterBenchmark autoPlacement{ "GridLayout", "AutoPlaceTenThousandItems", []
+	{
+		constexpr auto ItemCount = 10'000ULL;
+
+		std::mt19937 random{ 42 };
+		std::uniform_int_distribution span{ 1L, 3L };
+		std::vector<Placement> requests;
+		for (std::size_t i = 0; i < ItemCount; i++)
+		{
+			requests.push_back(Placement{ AUTO_PLACE, AUTO_PLACE, span(random), span(random) });
+		}
+
+		const auto grid = MakeGrid(GridCellPlacementType::Packed);
+		std::vector<LayoutSpacer> spacers(requests.size());
+		AddItems(*grid, spacers, requests);
+		grid->UpdateLayout();
+
+		const auto bitmap = Measure("bitmap occupancy, 10k items in 12 columns", 10, [&grid]
+		{
+			grid->InvalidateArrange();
+			grid->UpdateLayout();
+		});
+		const auto set = Measure("std::set occupancy, 10k items in 12 columns", 1, [&requests]
+		{
+			SetPlacementReference reference{ ColumnCount, GridCellPlacementType::Packed };
+			DoNotOptimize(reference.Place(requests));
+		});
+
+		std::println("  {:.1f}x faster than the set", set.GetNanosecondsPerIteration() / bitmap.GetNanosecondsPerIteration());
+		Check(bitmap.GetNanosecondsPerIteration() < set.GetNanosecondsPerIteration(), "the bitmap beats the set");
+	} };
+
+	const RegisterTest trackOffsets{ "GridLayout", "TrackOffsetsMatchSummedTrackSizes", []
+	{
+		constexpr auto RowCount = 30;
+		constexpr auto Columns = 20;
+		constexpr auto Gap = 3L;
+		constexpr GridLayoutPadding Padding{ .top = 7, .left = 11, .bottom = 2, .right = 5 };
+
+		std::mt19937 random{ 7 };
+		const auto rowSizes = RandomTrackSizes(random, RowCount);
+		const auto columnSizes = RandomTrackSizes(random, Columns);
+
+		GridLayout grid{ RectF{ 0, 0, 2000, 2000 } };
+		grid.SetRowDefinitions(ToDefinitions(rowSizes));
+		grid.SetColumnDefinitions(ToDefinitions(columnSizes));
+		grid.SetGap(Gap);
+		grid.SetPadding(Padding);
+
+		std::uniform_int_distribution span{ 1L, 4L };
+		std::vector<Placement> placements;
+		for (auto i = 0; i < 200; i++)
+		{
+			const auto rowSpan = span(random);
+			const auto columnSpan = span(random);
+			placements.push_back(Placement{
+				std::uniform_int_distribution{ 0L, RowCount - rowSpan }(random),
+				std::uniform_int_distribution{ 0L, Columns - columnSpan }(random),
+				rowSpan, columnSpan
+			});
+		}
+		std::vector<LayoutSpacer> spacers(placements.size());
+		AddItems(grid, spacers, placements);
+		grid.UpdateLayout();
+
+		for (const auto& [spacer, placement] : std::views::zip(spacers, placements))
+		{
+			CheckEqual(spacer.GetRect(), static_cast<RectF>(AccumulatedRect(rowSizes, columnSizes, Gap, Padding, placement)));
+		}
+	} };
+
+	const RegisterBenchmark largeGrid{ "GridLayout", "LargeGridTrackOffsets", []
+	{
+		constexpr auto RowCount = 500L;
+		constexpr auto Columns = 50L;
+
+		std::mt19937 random{ 3 };
+		const auto rowSizes = RandomTrackSizes(random, RowCount);
+		const auto columnSizes = RandomTrackSizes(random, Columns);
+
+		GridLayout grid{ RectF{ 0, 0, 4000, 40000 } };
+		grid.SetRowDefinitions(ToDefinitions(rowSizes));
+		grid.SetColumnDefinitions(ToDefinitions(columnSizes));
+		grid.SetGap(2);
+
+		std::vector<Placement> placements;
+		for (auto row = 0L; row < RowCount; row++)
+		{
+			for (auto column = 0L; column < Columns; column++)
+			{
+				placements.push_back(Placement{ row, column, 1, 1 });
+			}
+		}
+		std::vector<LayoutSpacer> spacers(placements.size());
+		AddItems(grid, spacers, placements);
+		grid.UpdateLayout();
+
+		Unused(Measure("500x50 tracks, 25k items, whole pass", 10, [&grid]
+		{
+			grid.InvalidateArrange();
+			grid.UpdateLayout();
+		}));
+
+		// Only the rect computation of the pass, once with the sizes summed per item and once with prefix sums
+		const auto summed = Measure("25k item rects, summed per item", 10, [&]
+		{
+			auto checksum = 0L;
+			for (const auto& placement : placements)
+			{
+				checksum += AccumulatedRect(rowSizes, columnSizes, 2, GridLayoutPadding{ }, placement).right;
+			}
+			DoNotOptimize(checksum);
+		});
+		const auto prefixed = Measure("25k item rects, prefix sums", 10, [&]
+		{
+			std::vector<long> rowOffsets(rowSizes.size() + 1);
+			std::vector<long> columnOffsets(columnSizes.size() + 1);
+			std::inclusive_scan(rowSizes.begin(), rowSizes.end(), rowOffsets.begin() + 1, [](const long sum, const long size) { return sum + size + 2; }, 0L);
+			std::inclusive_scan(columnSizes.begin(), columnSizes.end(), columnOffsets.begin() + 1, [](const long sum, const long size) { return sum + size + 2; }, 0L);
+
+			auto checksum = 0L;
+			for (const auto& [row, column, rowSpan, columnSpan] : placements)
+			{
+				checksum += columnOffsets[column + columnSpan] - 2;
+			}
+			DoNotOptimize(checksum);
+		});
+
+		std::println("  prefix sums are {:.1f}x faster than summing per item",
+		             summed.GetNanosecondsPerIteration() / prefixed.GetNanosecondsPerIteration());
+		CheckEqual(spacers.back().GetRect(), static_cast<RectF>(AccumulatedRect(rowSizes, columnSizes, 2, GridLayoutPadding{ }, placements.back())));
+	} };
+}
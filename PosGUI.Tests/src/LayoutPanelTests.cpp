@@ -0,0 +1,210 @@
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.StackLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Spacer that counts how often a panel asked for its desired size
+	class CountingItem
+	{
+		public:
+		explicit CountingItem(const SizeF desiredSize) noexcept :
+			spacer{ desiredSize }
+		{
+		}
+
+		auto MoveAndResize(const RectF newRect) noexcept -> void { spacer.MoveAndResize(newRect); }
+		auto MoveAndResize(const PointF point, const SizeF size) noexcept -> void { spacer.MoveAndResize(point, size); }
+		auto Move(const PointF point) noexcept -> void { spacer.Move(point); }
+		auto Resize(const SizeF size) noexcept -> void { spacer.Resize(size); }
+
+		[[nodiscard]] auto GetRect() const noexcept -> RectF { return spacer.GetRect(); }
+		[[nodiscard]] auto GetSize() const noexcept -> SizeF { return spacer.GetSize(); }
+		[[nodiscard]] auto GetPosition() const noexcept -> PointF { return spacer.GetPosition(); }
+
+		[[nodiscard]] auto Measure(const SizeF availableSize) noexcept -> SizeF
+		{
+			measureCount++;
+			return spacer.Measure(availableSize);
+		}
+		[[nodiscard]] auto GetMeasureVersion() const noexcept { return spacer.GetMeasureVersion(); }
+
+		auto SetDesiredSize(const SizeF size) noexcept -> void { spacer.SetDesiredSize(size); }
+		[[nodiscard]] auto GetMeasureCount() const noexcept { return measureCount; }
+
+		private:
+		LayoutSpacer spacer;
+		int measureCount = 0;
+	};
+
+	// Panel that leaves its items where they are, only exposes the index lookup
+	class IndexedPanel final : public LayoutPanel
+	{
+		public:
+		IndexedPanel() noexcept :
+			LayoutPanel{ RectF{ } }
+		{
+		}
+
+		auto RearrangeItems() noexcept -> void override
+		{
+		}
+
+		using LayoutPanel::GetItemIndex;
+	};
+
+	[[nodiscard]] auto MakeStack() noexcept
+	{
+		return std::make_unique<StackLayout>(
+			RectF{ 0, 0, 400, 400 }, LayoutOrientation::Horizontal,
+			MainAxisAlignment::Start, CrossAxisAlignment::Start);
+	}
+
+	const RegisterTest invalidationReachesAncestors{ "LayoutPanel", "InvalidationAdvancesEveryAncestorVersion", []
+	{
+		const auto root = MakeStack();
+		const auto middle = MakeStack();
+		const auto leaf = MakeStack();
+		const auto sibling = MakeStack();
+		middle->AddItem(*leaf);
+		root->AddItem(*middle);
+		root->AddItem(*sibling);
+		root->UpdateLayout();
+
+		const auto rootVersion = root->GetMeasureVersion();
+		const auto middleVersion = middle->GetMeasureVersion();
+		const auto siblingVersion = sibling->GetMeasureVersion();
+
+		leaf->SetMainAxisGap(4);
+		Check(root->GetMeasureVersion() > rootVersion, "the root saw the change");
+		Check(middle->GetMeasureVersion() > middleVersion, "the middle panel saw the change");
+		CheckEqual(sibling->GetMeasureVersion(), siblingVersion);
+		Check(root->IsLayoutDirty(), "the root has pending work");
+	} };
+
+	const RegisterTest removalAdvancesVersion{ "LayoutPanel", "RemovalAdvancesVersion", []
+	{
+		const auto root = MakeStack();
+		const auto child = MakeStack();
+		root->AddItem(*child);
+		child->SetMainAxisGap(2);
+
+		const auto version = root->GetMeasureVersion();
+		Check(root->RemoveItem(0).has_value(), "the child was removed");
+		Check(root->GetMeasureVersion() > version, "the version never goes back on removal");
+
+		// A detached panel no longer reaches its old parent
+		const auto detachedVersion = root->GetMeasureVersion();
+		child->SetMainAxisGap(3);
+		CheckEqual(root->GetMeasureVersion(), detachedVersion);
+	} };
+
+	const RegisterTest measureIsCached{ "LayoutPanel", "NestedMeasureIsCachedUntilInvalidated", []
+	{
+		const auto root = MakeStack();
+		const auto middle = MakeStack();
+		CountingItem item{ SizeF{ 20, 10 } };
+		middle->AddItem(item);
+		root->AddItem(*middle);
+
+		root->UpdateLayout();
+		const auto measured = item.GetMeasureCount();
+		Check(measured > 0, "the item was measured");
+
+		root->InvalidateArrange();
+		root->UpdateLayout();
+		CheckEqual(item.GetMeasureCount(), measured);
+
+		item.SetDesiredSize(SizeF{ 30, 10 });
+		Check(middle->InvalidateItemMeasure(0).has_value(), "the item was invalidated");
+		Check(root->IsLayoutDirty(), "the root has pending work");
+		root->UpdateLayout();
+		Check(item.GetMeasureCount() > measured, "the item was measured again");
+		CheckNear(item.GetSize().cx, 30.0F, 0.001F);
+	} };
+
+	const RegisterTest duplicateItemIndex{ "LayoutPanel", "DuplicateItemKeepsFirstIndex", []
+	{
+		const auto panel = std::make_unique<IndexedPanel>();
+		LayoutSpacer first;
+		LayoutSpacer duplicate;
+		panel->AddItem(first);
+		panel->AddItem(duplicate);
+		panel->AddItem(duplicate);
+
+		CheckEqual(*panel->GetItemIndex(MakeLayoutItem(duplicate)), 1ULL);
+
+		// Removing the first occurrence hands the index to the one left
+		Check(panel->RemoveItem(1).has_value(), "the first occurrence was removed");
+		CheckEqual(*panel->GetItemIndex(MakeLayoutItem(duplicate)), 1ULL);
+
+		Check(panel->RemoveItem(0).has_value(), "the first item was removed");
+		CheckEqual(*panel->GetItemIndex(MakeLayoutItem(duplicate)), 0ULL);
+
+		Check(panel->RemoveItem(0).has_value(), "the last occurrence was removed");
+		Check(!panel->GetItemIndex(MakeLayoutItem(duplicate)).has_value(), "the item is gone");
+	} };
+
+	const RegisterTest itemIndexMatchesSearch{ "LayoutPanel", "ItemIndexMatchesLinearSearch", []
+	{
+		std::mt19937 random{ 3 };
+		std::array<LayoutSpacer, 8> spacers;
+		const auto panel = std::make_unique<IndexedPanel>();
+
+		for (auto step = 0; step < 2'000; step++)
+		{
+			if (const auto count = panel->GetItemCount();
+				count == 0 || random() % 3 != 0)
+			{
+				panel->AddItem(spacers[random() % spacers.size()]);
+			}
+			else
+			{
+				Check(panel->RemoveItem(random() % count).has_value(), "the item was removed");
+			}
+
+			for (auto& spacer : spacers)
+			{
+				const auto item = MakeLayoutItem(spacer);
+				const auto& items = panel->GetItems();
+				const auto found = std::ranges::find(items, item);
+				const auto index = panel->GetItemIndex(item);
+
+				CheckEqual(index.has_value(), found != items.end());
+				if (index.has_value())
+				{
+					CheckEqual(*index, static_cast<std::size_t>(std::distance(items.begin(), found)));
+				}
+			}
+		}
+	} };
+
+	const RegisterBenchmark wideVersion{ "LayoutPanel", "MeasureVersionOfWidePanel", []
+	{
+		constexpr auto ItemCount = 10'000ULL;
+
+		const auto root = MakeStack();
+		const auto panel = MakeStack();
+		std::vector<LayoutSpacer> spacers(ItemCount, LayoutSpacer{ SizeF{ 1, 1 } });
+		for (auto& spacer : spacers)
+		{
+			panel->AddItem(spacer);
+		}
+		root->AddItem(*panel);
+
+		const auto result = Measure("GetMeasureVersion of a 10k item panel", 1'000'000, [&root]
+		{
+			DoNotOptimize(root->GetMeasureVersion());
+		});
+		Check(result.GetNanosecondsPerIteration() < 1'000.0, "the version does not walk the items");
+	} };
+}
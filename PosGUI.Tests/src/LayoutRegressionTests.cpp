@@ -0,0 +1,318 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.StackLayout;
+import PGUI.UI.Layout.GridLayout;
+import PGUI.UI.Layout.DockLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Stands in for an element, counts the measure and arrange calls the panels make
+	class MockItem
+	{
+		public:
+		explicit MockItem(const SizeF desiredSize) noexcept :
+			desiredSize{ desiredSize }
+		{
+		}
+
+		auto MoveAndResize(const RectF newRect) noexcept -> void
+		{
+			rect = newRect;
+			arrangeCount++;
+		}
+		auto MoveAndResize(const PointF point, const SizeF size) noexcept -> void { MoveAndResize(RectF{ point, size }); }
+		auto Move(const PointF point) noexcept -> void
+		{
+			rect.Move(point);
+			arrangeCount++;
+		}
+		auto Resize(const SizeF size) noexcept -> void
+		{
+			rect.Resize(size);
+			arrangeCount++;
+		}
+
+		[[nodiscard]] auto GetRect() const noexcept -> RectF { return rect; }
+		[[nodiscard]] auto GetSize() const noexcept -> SizeF { return rect.Size(); }
+		[[nodiscard]] auto GetPosition() const noexcept -> PointF { return rect.TopLeft(); }
+
+		[[nodiscard]] auto Measure(const SizeF) noexcept -> SizeF
+		{
+			measureCount++;
+			return desiredSize;
+		}
+		[[nodiscard]] auto GetMeasureVersion() const noexcept { return measureVersion; }
+
+		auto SetDesiredSize(const SizeF size) noexcept -> void
+		{
+			desiredSize = size;
+			measureVersion++;
+		}
+
+		[[nodiscard]] auto GetMeasureCount() const noexcept { return measureCount; }
+		[[nodiscard]] auto GetArrangeCount() const noexcept { return arrangeCount; }
+
+		private:
+		RectF rect;
+		SizeF desiredSize;
+		std::uint64_t measureVersion = 0;
+		std::size_t measureCount = 0;
+		std::size_t arrangeCount = 0;
+	};
+
+	// Owns a panel tree and its items, the first panel is the root
+	class Scenario
+	{
+		public:
+		template <typename Panel, typename... Args>
+		auto AddPanel(Args&&... args) -> Panel&
+		{
+			auto panel = std::make_unique<Panel>(std::forward<Args>(args)...);
+			auto& added = *panel;
+			panels.push_back(MoveChecked(panel));
+
+			return added;
+		}
+
+		auto AddItem(const SizeF desiredSize) -> MockItem& { return items.emplace_back(desiredSize); }
+
+		[[nodiscard]] auto GetRoot() const noexcept -> LayoutPanel& { return *panels.front(); }
+
+		auto InvalidatePanels() const noexcept -> void
+		{
+			for (const auto& panel : panels)
+			{
+				panel->InvalidateArrange();
+			}
+		}
+
+		[[nodiscard]] auto GetMeasureCount() const noexcept
+		{
+			return std::ranges::fold_left(items | std::views::transform(&MockItem::GetMeasureCount), std::size_t{ 0 }, std::plus{ });
+		}
+		[[nodiscard]] auto GetArrangeCount() const noexcept
+		{
+			return std::ranges::fold_left(items | std::views::transform(&MockItem::GetArrangeCount), std::size_t{ 0 }, std::plus{ });
+		}
+
+		private:
+		std::vector<std::unique_ptr<LayoutPanel>> panels;
+		// Items are referenced by the panels, so they must not move
+		std::deque<MockItem> items;
+	};
+
+	// Stacks nested in each other with alternating orientation, every level holds an item and the next level
+	[[nodiscard]] auto MakeDeepNesting(const std::size_t depth) -> std::unique_ptr<Scenario>
+	{
+		auto scenario = std::make_unique<Scenario>();
+		auto* parent = &scenario->AddPanel<StackLayout>(
+			RectF{ 0, 0, 800, 600 }, LayoutOrientation::Vertical,
+			MainAxisAlignment::Start, CrossAxisAlignment::Stretch, WrapMode::NoWrap,
+			StackLayoutPadding{ 2, 2, 2, 2 }, 1.0F);
+
+		for (std::size_t level = 0; level < depth; level++)
+		{
+			const auto orientation = level % 2 == 0 ? LayoutOrientation::Horizontal : LayoutOrientation::Vertical;
+			const auto alignment = static_cast<CrossAxisAlignment>(level % 4);
+			auto& child = scenario->AddPanel<StackLayout>(
+				RectF{ }, orientation, MainAxisAlignment::Start, alignment, WrapMode::NoWrap,
+				StackLayoutPadding{ 1, 1, 1, 1 }, 2.0F);
+
+			parent->AddItem(scenario->AddItem(SizeF{ static_cast<float>(8 + level % 5), 6 }));
+			parent->AddItem(child);
+			parent = &child;
+		}
+		parent->AddItem(scenario->AddItem(SizeF{ 12, 12 }));
+
+		return scenario;
+	}
+
+	// Mixed fixed and fractional columns with auto placed items, some of them spanning
+	[[nodiscard]] auto MakeWideGrid(const long columnCount, const std::size_t itemCount) -> std::unique_ptr<Scenario>
+	{
+		auto scenario = std::make_unique<Scenario>();
+		auto& grid = scenario->AddPanel<GridLayout>(RectF{ 0, 0, static_cast<float>(columnCount) * 20.0F, 4000 });
+
+		std::vector<GridCellDefinition> columns;
+		for (const auto column : std::views::iota(0L, columnCount))
+		{
+			columns.emplace_back(column % 3 == 0 ?
+				                     GridCellDefinition{ FractionalSize{ static_cast<float>(1 + column % 2) } } :
+				                     GridCellDefinition{ FixedSize{ 16 } });
+		}
+		grid.SetColumnDefinitions(columns);
+		grid.SetGap(2);
+		Check(grid.SetAutoCellSize(FixedSize{ 18 }).has_value(), "auto rows are fixed");
+
+		for (std::size_t i = 0; i < itemCount; i++)
+		{
+			const auto rowSpan = i % 11 == 0 ? 2L : 1L;
+			const auto columnSpan = i % 7 == 0 ? 2L : 1L;
+			grid.AddItem(scenario->AddItem(SizeF{ 10, 10 }), GridItemProperties{ AUTO_PLACE, AUTO_PLACE, rowSpan, columnSpan });
+		}
+
+		return scenario;
+	}
+
+	// Column of wrapping rows, every row breaks its items into many lines
+	[[nodiscard]] auto MakeWrapHeavyStacks(const std::size_t rowCount, const std::size_t itemsPerRow) -> std::unique_ptr<Scenario>
+	{
+		auto scenario = std::make_unique<Scenario>();
+		auto& column = scenario->AddPanel<StackLayout>(
+			RectF{ 0, 0, 640, 100000 }, LayoutOrientation::Vertical,
+			MainAxisAlignment::Start, CrossAxisAlignment::Stretch);
+
+		for (std::size_t row = 0; row < rowCount; row++)
+		{
+			auto& wrap = scenario->AddPanel<StackLayout>(
+				RectF{ }, LayoutOrientation::Horizontal,
+				static_cast<MainAxisAlignment>(row % 6), CrossAxisAlignment::Center, WrapMode::Wrap,
+				StackLayoutPadding{ 4, 4, 4, 4 }, 3.0F, 5.0F);
+			column.AddItem(wrap);
+
+			for (std::size_t i = 0; i < itemsPerRow; i++)
+			{
+				const auto index = row * itemsPerRow + i;
+				wrap.AddItem(scenario->AddItem(SizeF{
+					static_cast<float>(10 + index * 37 % 50),
+					static_cast<float>(8 + index * 13 % 20)
+				}));
+			}
+		}
+
+		return scenario;
+	}
+
+	// Docks filled by the next dock, each level docks its sides in a different priority order
+	[[nodiscard]] auto MakeDockChain(const std::size_t depth, const float thickness) -> std::unique_ptr<Scenario>
+	{
+		constexpr auto Sides = std::array{
+			DockPosition::Top, DockPosition::Left, DockPosition::Right, DockPosition::Bottom
+		};
+		constexpr auto Priorities = std::array{
+			DockPriority::First, DockPriority::Second, DockPriority::Third, DockPriority::Fourth
+		};
+
+		auto scenario = std::make_unique<Scenario>();
+		auto* dock = &scenario->AddPanel<DockLayout>(RectF{ 0, 0, 1000, 800 });
+		Check(dock->SetMaxDockSize(DockPosition::Top, thickness * 0.5F).has_value(), "max size was set");
+		Check(dock->SetMaxDockSize(DockPosition::Left, thickness * 1.5F).has_value(), "max size was set");
+
+		for (std::size_t level = 0; level < depth; level++)
+		{
+			for (std::size_t side = 0; side < Sides.size(); side++)
+			{
+				dock->SetDockPriority(Sides[(level + side) % Sides.size()], Priorities[side]);
+			}
+			for (const auto [index, side] : Sides | std::views::enumerate)
+			{
+				const auto extent = thickness * static_cast<float>(1 + (static_cast<std::size_t>(index) + level) % 3);
+				dock->AddItem(scenario->AddItem(SizeF{ extent, extent }), side);
+			}
+			dock->AddItem(scenario->AddItem(SizeF{ }), DockPosition::None);
+
+			auto& child = scenario->AddPanel<DockLayout>(RectF{ });
+			dock->AddItem(child, DockPosition::Fill);
+			dock = &child;
+		}
+		dock->AddItem(scenario->AddItem(SizeF{ }), DockPosition::Fill);
+
+		return scenario;
+	}
+
+	// The dumps only hold digits, signs and words, so narrowing them is lossless
+	[[nodiscard]] auto DumpRects(const LayoutPanel& panel) -> std::string
+	{
+		return DumpLayoutRects(panel, 3) |
+		       std::views::transform([](const wchar_t character) { return static_cast<char>(character); }) |
+		       std::ranges::to<std::string>();
+	}
+
+	auto CheckScenarioGolden(const std::string_view fileName, const Scenario& scenario) -> void
+	{
+		scenario.GetRoot().UpdateLayout();
+		const auto first = DumpRects(scenario.GetRoot());
+		CheckGolden(fileName, first);
+
+		// A full relayout from the same inputs has to land on the same rects
+		scenario.InvalidatePanels();
+		scenario.GetRoot().UpdateLayout();
+		Check(DumpRects(scenario.GetRoot()) == first, "relayout is stable");
+	}
+
+	auto BenchmarkScenario(const std::string_view name, const std::function<std::unique_ptr<Scenario>()>& make) -> void
+	{
+		std::unique_ptr<Scenario> scenario;
+		Unused(Measure(std::format("{}: build and first layout", name), 1, [&scenario, &make]
+		{
+			scenario = make();
+			scenario->GetRoot().UpdateLayout();
+		}));
+
+		const auto report = ProfileLayoutPass(scenario->GetRoot());
+		std::println("  {} panels, {} items, {} bytes of item storage",
+		             report.panelCount, report.itemCount, report.itemStorageBytes);
+
+		constexpr auto Passes = 20ULL;
+		const auto measuresBefore = scenario->GetMeasureCount();
+		const auto arrangesBefore = scenario->GetArrangeCount();
+		Unused(Measure(std::format("{}: relayout every panel", name), Passes, [&scenario]
+		{
+			scenario->InvalidatePanels();
+			scenario->GetRoot().UpdateLayout();
+		}));
+		std::println("  {} item measures and {} item arranges per relayout",
+		             (scenario->GetMeasureCount() - measuresBefore) / Passes,
+		             (scenario->GetArrangeCount() - arrangesBefore) / Passes);
+	}
+
+	const RegisterTest deepNestingGolden{ "LayoutRegression", "DeepNesting", []
+	{
+		CheckScenarioGolden("DeepNesting.txt", *MakeDeepNesting(12));
+	} };
+
+	const RegisterTest wideGridGolden{ "LayoutRegression", "WideGrid", []
+	{
+		CheckScenarioGolden("WideGrid.txt", *MakeWideGrid(24, 60));
+	} };
+
+	const RegisterTest wrapHeavyGolden{ "LayoutRegression", "WrapHeavyStacks", []
+	{
+		CheckScenarioGolden("WrapHeavyStacks.txt", *MakeWrapHeavyStacks(3, 30));
+	} };
+
+	const RegisterTest dockChainGolden{ "LayoutRegression", "DockChainWithPriorities", []
+	{
+		CheckScenarioGolden("DockChainWithPriorities.txt", *MakeDockChain(6, 10.0F));
+	} };
+
+	const RegisterTest cleanPassIsFree{ "LayoutRegression", "CleanPassTouchesNoItems", []
+	{
+		const auto scenario = MakeWrapHeavyStacks(3, 30);
+		scenario->GetRoot().UpdateLayout();
+
+		const auto measures = scenario->GetMeasureCount();
+		const auto arranges = scenario->GetArrangeCount();
+		scenario->GetRoot().UpdateLayout();
+		CheckEqual(scenario->GetMeasureCount(), measures);
+		CheckEqual(scenario->GetArrangeCount(), arranges);
+	} };
+
+	const RegisterBenchmark scenarios{ "LayoutRegression", "Scenarios", []
+	{
+		BenchmarkScenario("deep nesting, 1000 levels", [] { return MakeDeepNesting(1'000); });
+		BenchmarkScenario("wide grid, 200 columns and 10000 items", [] { return MakeWideGrid(200, 10'000); });
+		BenchmarkScenario("wrap heavy stacks, 100 rows of 200 items", [] { return MakeWrapHeavyStacks(100, 200); });
+		BenchmarkScenario("dock chain, 1000 levels", [] { return MakeDockChain(1'000, 0.1F); });
+	} };
+}
@@ -0,0 +1,87 @@
+import std;
+
+import PGUI.DataBinding.Property;
+import PGUI.DataBinding.LazyDerivedProperty;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest recomputesOnlyWhenRead{ "LazyDerivedProperty", "RecomputesOnlyWhenRead", []
+	{
+		Property<int> source{ 1 };
+		auto computeCount = 0;
+		const LazyDerivedProperty<int> derived{ [&computeCount](const int value)
+		{
+			computeCount++;
+			return value * 2;
+		}, source };
+
+		source.Set(2);
+		source.Set(3);
+		Check(derived.IsStale(), "changes only mark the value stale");
+		CheckEqual(computeCount, 0);
+
+		CheckEqual(*derived.Get(), 6);
+		CheckEqual(*derived.Get(), 6);
+		CheckEqual(computeCount, 1);
+	} };
+
+	const RegisterTest nestedGetDoesNotDeadlock{ "LazyDerivedProperty", "GetWhileHoldingProxyDoesNotDeadlock", []
+	{
+		Property<int> source{ 1 };
+		const LazyDerivedProperty<int> derived{ [](const int value) { return value * 2; }, source };
+		CheckEqual(*derived.Get(), 2);
+
+		{
+			const auto outer = derived.Get();
+			source.Set(5);
+
+			// Refreshing would need the exclusive lock the outer proxy blocks
+			const auto inner = derived.Get();
+			CheckEqual(*inner, 2);
+		}
+		CheckEqual(*derived.Get(), 10);
+	} };
+
+	const RegisterTest observerReadsDuringPublish{ "LazyDerivedProperty", "ObserverCanReadDuringPublish", []
+	{
+		Property<int> source{ 1 };
+		LazyDerivedProperty<int> derived{ [](const int value) { return value + 1; }, source };
+
+		std::vector<int> seen;
+		Unused(derived.AddObserver([&derived, &seen](const auto& value)
+		{
+			seen.push_back(*value);
+			seen.push_back(*derived.Get());
+		}));
+		source.Set(2);
+		source.Set(3);
+
+		CheckEqual(seen, std::vector{ 3, 3, 4, 4 });
+	} };
+
+	const RegisterTest unknownObserverKeepsCount{ "LazyDerivedProperty", "RemovingUnknownObserverKeepsItEager", []
+	{
+		Property<int> source{ 1 };
+		LazyDerivedProperty<int> derived{ [](const int value) { return value; }, source };
+
+		auto notified = 0;
+		const auto id = derived.AddObserver([&notified](const auto&) { notified++; });
+		derived.RemoveObserver(id + 1);
+		derived.RemoveObserver(id + 1);
+
+		source.Set(2);
+		Check(!derived.IsStale(), "an observed value is refreshed eagerly");
+		CheckEqual(notified, 1);
+
+		derived.RemoveObserver(id);
+		derived.RemoveObserver(id);
+		source.Set(3);
+		Check(derived.IsStale(), "without observers the value is lazy again");
+		CheckEqual(notified, 1);
+	} };
+}
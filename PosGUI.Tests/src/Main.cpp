@@ -0,0 +1,80 @@
+import std;
+
+import PGUI.Tests.Framework;
+
+// Usage: PosGUI.Tests [--benchmarks] [--update-golden] [--golden <directory>] [filter]
+// Tests always run, benchmarks only with --benchmarks. The filter matches "Suite.Name" substrings.
+auto main(const int argc, char* argv[]) -> int
+{
+	using namespace PGUI::Tests;
+
+	auto runBenchmarks = false;
+	std::string_view filter;
+#ifdef PGUI_TESTS_GOLDEN_DIR
+	SetGoldenDirectory(PGUI_TESTS_GOLDEN_DIR);
+#endif
+
+	for (auto i = 1; i < argc; i++)
+	{
+		if (const auto argument = std::string_view{ argv[i] };
+			argument == "--benchmarks")
+		{
+			runBenchmarks = true;
+		}
+		else if (argument == "--update-golden")
+		{
+			SetUpdateGolden(true);
+		}
+		else if (argument == "--golden" && i + 1 < argc)
+		{
+			SetGoldenDirectory(argv[++i]);
+		}
+		else
+		{
+			filter = argument;
+		}
+	}
+
+	auto testCases = GetTestCases();
+	std::ranges::stable_sort(testCases, { }, [](const TestCase& testCase) { return testCase.suite; });
+
+	auto passed = 0;
+	auto failed = 0;
+	for (const auto& [suite, name, function, kind] : testCases)
+	{
+		if (kind == TestKind::Benchmark && !runBenchmarks)
+		{
+			continue;
+		}
+		if (const auto fullName = std::format("{}.{}", suite, name);
+			!filter.empty() && !fullName.contains(filter))
+		{
+			continue;
+		}
+
+		std::println("[ RUN  ] {}.{}", suite, name);
+		try
+		{
+			function();
+			std::println("[  OK  ] {}.{}", suite, name);
+			passed++;
+		}
+		catch (const CheckFailure& failure)
+		{
+			std::println("[ FAIL ] {}.{}\n  {}({}): {}",
+			             suite, name,
+			             failure.location.file_name(), failure.location.line(),
+			             failure.message);
+			failed++;
+		}
+		catch (const std::exception& exception)
+		{
+			std::println("[ FAIL ] {}.{}\n  exception: {}", suite, name, exception.what());
+			failed++;
+		}
+	}
+
+	std::println("{} passed, {} failed", passed, failed);
+
+	return failed == 0 ? 0 : 1;
+}
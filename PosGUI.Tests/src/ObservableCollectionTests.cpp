@@ -0,0 +1,134 @@
+import std;
+
+import PGUI.DataBinding.ObservableCollection;
+import PGUI.ErrorHandling;
+import PGUI.Utils;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	struct RecordedChange
+	{
+		CollectionChangeType type;
+		std::size_t index;
+		std::size_t count;
+		std::vector<int> oldItems;
+		std::vector<int> newItems;
+
+		auto operator==(const RecordedChange&) const -> bool = default;
+	};
+
+	template <typename Collection>
+	auto Record(Collection& collection, std::vector<RecordedChange>& recorded) noexcept
+	{
+		return collection.AddObserver([&recorded](const auto&, const std::span<const CollectionChange<int>> changes)
+		{
+			for (const auto& change : changes)
+			{
+				recorded.emplace_back(
+					change.type, change.index, change.count,
+					change.oldItems,
+					std::vector<int>{ change.newItems.begin(), change.newItems.end() });
+			}
+		});
+	}
+
+	const RegisterTest insertViewsItemsInPlace{ "ObservableCollection", "InsertViewsItemsInPlace", []
+	{
+		ObservableCollection<int> collection{ 1, 2 };
+		auto inPlace = false;
+		Unused(collection.AddObserver([&inPlace](const auto& items, const auto changes)
+		{
+			const auto& change = changes.front();
+			inPlace = change.newItems.data() == items->data() + change.index && change.detachedItems.empty();
+		}));
+
+		const std::array inserted{ 7, 8, 9 };
+		Check(collection.InsertRange(1, inserted).has_value(), "insert succeeded");
+		Check(inPlace, "newItems views the collection");
+	} };
+
+	const RegisterTest changesKeepTheirItems{ "ObservableCollection", "BatchedChangesKeepTheirItems", []
+	{
+		ObservableCollection<int> collection{ 1, 2, 3 };
+		std::vector<RecordedChange> recorded;
+		Unused(Record(collection, recorded));
+
+		{
+			ObservableCollection<int>::Batch batch{ collection };
+			collection.PushBack(4);
+			Check(collection.Insert(0, 0).has_value(), "insert succeeded");
+			Check(collection.Replace(4, 5).has_value(), "replace succeeded");
+			Check(collection.Erase(1, 2).has_value(), "erase succeeded");
+			Check(collection.Move(0, 2).has_value(), "move succeeded");
+		}
+
+		CheckEqual(*collection.Get(), std::vector{ 3, 5, 0 });
+		const std::vector<RecordedChange> expected{
+			{ CollectionChangeType::Insert, 3, 1, { }, { 4 } },
+			{ CollectionChangeType::Insert, 0, 1, { }, { 0 } },
+			{ CollectionChangeType::Replace, 4, 1, { 4 }, { 5 } },
+			{ CollectionChangeType::Remove, 1, 2, { 1, 2 }, { } },
+			{ CollectionChangeType::Move, 0, 1, { }, { } }
+		};
+		Check(recorded == expected, "changes replay the batch");
+	} };
+
+	const RegisterTest resetDropsEarlierChanges{ "ObservableCollection", "ResetDropsEarlierChanges", []
+	{
+		ObservableCollection<int> collection{ 1 };
+		std::vector<RecordedChange> recorded;
+		Unused(Record(collection, recorded));
+
+		{
+			ObservableCollection<int>::Batch batch{ collection };
+			collection.PushBack(2);
+			collection.Assign(std::vector{ 5, 6 });
+			collection.PushBack(7);
+		}
+
+		const std::vector<RecordedChange> expected{
+			{ CollectionChangeType::Reset, 0, 2, { }, { } },
+			{ CollectionChangeType::Insert, 2, 1, { }, { 7 } }
+		};
+		Check(recorded == expected, "reset is the first change");
+	} };
+
+	const RegisterTest outOfRangeIsRejected{ "ObservableCollection", "OutOfRangeIsRejected", []
+	{
+		ObservableCollection<int> collection{ 1 };
+
+		Check(collection.Insert(2, 0).error().Code() == ErrorCode::OutOfRange, "out of range");
+		Check(collection.Erase(0, 2).error().Code() == ErrorCode::OutOfRange, "out of range");
+		Check(collection.Replace(1, 0).error().Code() == ErrorCode::OutOfRange, "out of range");
+	} };
+
+	const RegisterBenchmark changeRecords{ "ObservableCollection", "ChangeRecordAllocations", []
+	{
+		constexpr auto ItemCount = 10'000ULL;
+		const auto item = std::string(64, 'x');
+
+		ObservableCollection<std::string> collection;
+		Unused(collection.AddObserver([](const auto&, const auto changes) { DoNotOptimize(changes); }));
+		collection.Assign(std::vector(ItemCount, item));
+
+		auto index = 0ULL;
+		const auto insert = Measure("Insert with observer", ItemCount, [&]
+		{
+			Unused(collection.Insert(index++ % collection.Size(), item));
+		});
+		index = 0;
+		const auto replace = Measure("Replace with observer", ItemCount, [&]
+		{
+			Unused(collection.Replace(index++ % collection.Size(), std::string(64, 'y')));
+		});
+
+		// Change records don't copy the new items, Replace still owns the item it took out
+		std::println("  allocations per change: insert {:.2f}, replace {:.2f}",
+		             insert.GetAllocationsPerIteration(), replace.GetAllocationsPerIteration());
+	} };
+}
@@ -0,0 +1,99 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.DataBinding.PropertyTable;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest reusesReleasedSlots{ "PropertyTable", "ReusesReleasedSlots", []
+	{
+		PropertyTable<int> table;
+		std::optional<StoredProperty<int>> first{ std::in_place, table, 1 };
+		const StoredProperty second{ table, 2 };
+		const auto firstIndex = first->GetIndex();
+
+		first.reset();
+		CheckEqual(table.GetSize(), 1ULL);
+
+		const StoredProperty third{ table, 3 };
+		CheckEqual(third.GetIndex(), firstIndex);
+		CheckEqual(*third, 3);
+		CheckEqual(*second, 2);
+	} };
+
+	const RegisterTest releaseDuringNotify{ "PropertyTable", "ReleasingFromObserverKeepsEventAlive", []
+	{
+		PropertyTable<int> table;
+		std::optional<StoredProperty<int>> property{ std::in_place, table, 0 };
+
+		std::vector<int> seen;
+		Unused(property->AddObserver([&](const int value)
+		{
+			seen.push_back(value);
+			// Erases the entry's observers from the table while they are being invoked
+			property.reset();
+		}));
+		Unused(property->AddObserver([&seen](const int value) { seen.push_back(value * 10); }));
+
+		property->Set(1);
+		Check(!property.has_value(), "the property was released");
+		CheckEqual(seen, std::vector{ 1, 10 });
+		CheckEqual(table.GetSize(), 0ULL);
+	} };
+
+	const RegisterTest clearDuringNotify{ "PropertyTable", "ClearingFromObserverKeepsEventAlive", []
+	{
+		PropertyTable<int> table;
+		StoredProperty property{ table, 0 };
+
+		auto notified = 0;
+		Unused(property.AddObserver([&](int)
+		{
+			notified++;
+			property.ClearObservers();
+		}));
+
+		property.Set(1);
+		property.Set(2);
+		CheckEqual(notified, 1);
+	} };
+
+	const RegisterTest observersOnlyForObserved{ "PropertyTable", "OnlyObservedEntriesCostObserverMemory", []
+	{
+		PropertyTable<int> table;
+		std::vector<StoredProperty<int>> properties;
+		for (auto i = 0; i < 1000; i++)
+		{
+			properties.emplace_back(table, i);
+		}
+		const auto unobserved = table.GetMemoryUsage().observerBytes;
+
+		Unused(properties.front().AddObserver([](int) { }));
+		Check(table.GetMemoryUsage().observerBytes > unobserved, "an observed entry is accounted for");
+	} };
+
+	const RegisterBenchmark millionEntries{ "PropertyTable", "MillionEntriesMemory", []
+	{
+		constexpr auto EntryCount = 1'000'000ULL;
+
+		PropertyTable<std::uint64_t> table;
+		std::vector<StoredProperty<std::uint64_t>> properties;
+		properties.reserve(EntryCount);
+
+		const AllocationScope allocations;
+		for (auto i = 0ULL; i < EntryCount; i++)
+		{
+			properties.emplace_back(table, i);
+		}
+		const auto usage = table.GetMemoryUsage();
+
+		std::println("  {} entries: {:.1f} table bytes per entry, {} heap bytes, {} allocations",
+		             EntryCount, usage.BytesPerEntry(), allocations.GetPeakBytes(), allocations.GetAllocations());
+		Check(usage.BytesPerEntry() < 2.0 * sizeof(std::uint64_t), "unobserved entries only cost their value");
+	} };
+}
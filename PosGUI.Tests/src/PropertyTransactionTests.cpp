@@ -0,0 +1,121 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.DataBinding.Property;
+import PGUI.DataBinding.DerivedProperty;
+import PGUI.DataBinding.PropertyTransaction;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	const RegisterTest notifiesOnceWithFinalValue{ "PropertyTransaction", "NotifiesOnceWithFinalValue", []
+	{
+		Property<int> first{ 0 };
+		Property<int> second{ 0 };
+		std::vector<std::pair<char, int>> seen;
+		Unused(first.AddObserver([&seen](const auto& value) { seen.emplace_back('f', *value); }));
+		Unused(second.AddObserver([&seen](const auto& value) { seen.emplace_back('s', *value); }));
+
+		{
+			PropertyTransaction transaction;
+			second.Set(1);
+			for (auto i = 1; i <= 10; i++)
+			{
+				first.Set(i);
+			}
+			second.Set(2);
+			Check(seen.empty(), "nothing is notified before the commit");
+		}
+
+		// In the order the properties were first changed
+		CheckEqual(seen, std::vector<std::pair<char, int>>{ { 's', 2 }, { 'f', 10 } });
+	} };
+
+	const RegisterTest nestedCommitsAtOutermost{ "PropertyTransaction", "NestedCommitsOnlyAtOutermost", []
+	{
+		Property<int> property{ 0 };
+		std::vector<int> seen;
+		Unused(property.AddObserver([&seen](const auto& value) { seen.push_back(*value); }));
+
+		{
+			PropertyTransaction outer;
+			{
+				PropertyTransaction inner;
+				property.Set(1);
+				inner.Commit();
+				Check(seen.empty(), "committing the inner transaction only ends it");
+				property.Set(2);
+			}
+			Check(seen.empty(), "the inner scope ending flushes nothing");
+			Check(PropertyTransaction::IsActive(), "the outer transaction is still open");
+		}
+
+		CheckEqual(seen, std::vector{ 2 });
+		Check(!PropertyTransaction::IsActive(), "no transaction is left open");
+
+		property.Set(3);
+		CheckEqual(seen, std::vector{ 2, 3 });
+	} };
+
+	const RegisterTest derivedRecomputesOnCommit{ "PropertyTransaction", "DerivedRecomputesOnceOnCommit", []
+	{
+		Property<int> width{ 1 };
+		Property<int> height{ 1 };
+		auto computeCount = 0;
+		DerivedProperty<int> area{ [&computeCount](const int w, const int h)
+		{
+			computeCount++;
+			return w * h;
+		}, width, height };
+
+		std::vector<int> seen;
+		Unused(area.AddObserver([&seen](const auto& value) { seen.push_back(*value); }));
+
+		computeCount = 0;
+		{
+			PropertyTransaction transaction;
+			for (auto i = 2; i <= 5; i++)
+			{
+				width.Set(i);
+				height.Set(i * 2);
+			}
+			CheckEqual(computeCount, 0);
+		}
+
+		CheckEqual(computeCount, 1);
+		CheckEqual(*area.Get(), 50);
+		CheckEqual(seen, std::vector{ 50 });
+	} };
+
+	const RegisterTest otherThreadsNotDeferred{ "PropertyTransaction", "OtherThreadsNotifyImmediately", []
+	{
+		Property<int> local{ 0 };
+		Property<int> shared{ 0 };
+		std::atomic<int> localNotified = 0;
+		std::atomic<int> sharedNotified = 0;
+		Unused(local.AddObserver([&localNotified](const auto&) { localNotified++; }));
+		Unused(shared.AddObserver([&sharedNotified](const auto&) { sharedNotified++; }));
+
+		{
+			PropertyTransaction transaction;
+			local.Set(1);
+			auto activeElsewhere = true;
+			std::jthread{ [&shared, &activeElsewhere]
+			{
+				activeElsewhere = PropertyTransaction::IsActive();
+				shared.Set(1);
+			} }.join();
+
+			Check(!activeElsewhere, "the transaction belongs to the thread that opened it");
+			CheckEqual(sharedNotified.load(), 1);
+			CheckEqual(localNotified.load(), 0);
+		}
+
+		CheckEqual(localNotified.load(), 1);
+		CheckEqual(sharedNotified.load(), 1);
+	} };
+}
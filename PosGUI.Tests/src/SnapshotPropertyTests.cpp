@@ -0,0 +1,189 @@
+import std;
+
+import PGUI.Mutex;
+import PGUI.Utils;
+import PGUI.DataBinding.Property;
+import PGUI.DataBinding.SnapshotProperty;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::DataBinding;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Spans several machine words so a torn read shows up as mismatching fields
+	struct Bounds
+	{
+		double left = 0;
+		double top = 0;
+		double right = 0;
+		double bottom = 0;
+
+		auto operator<=>(const Bounds&) const = default;
+
+		[[nodiscard]] auto IsConsistent() const noexcept
+		{
+			return top == left && right == left && bottom == left;
+		}
+	};
+
+	[[nodiscard]] auto MakeBounds(const double value) noexcept
+	{
+		return Bounds{ value, value, value, value };
+	}
+
+	// Runs readers against one writer and returns whether every read was consistent
+	template <typename Read, typename Write>
+	auto ReadWhileWriting(const std::size_t readerCount, Read read, Write write) -> bool
+	{
+		std::atomic<bool> consistent = true;
+		std::atomic<bool> done = false;
+		{
+			std::vector<std::jthread> readers;
+			for (std::size_t i = 0; i < readerCount; i++)
+			{
+				readers.emplace_back([&]
+				{
+					while (!done.load(std::memory_order_relaxed))
+					{
+						if (!read())
+						{
+							consistent = false;
+						}
+					}
+				});
+			}
+			for (auto i = 1; i <= 20'000; i++)
+			{
+				write(i);
+			}
+			done = true;
+		}
+
+		return consistent;
+	}
+
+	const RegisterTest seqLockRoundTrip{ "SnapshotProperty", "SeqLockVersionsOnlyChanges", []
+	{
+		SeqLockProperty<Bounds> property{ MakeBounds(1) };
+		auto notified = 0;
+		Unused(property.AddObserver([&notified](const Bounds& value)
+		{
+			Check(value == MakeBounds(2), "observers see the new value");
+			notified++;
+		}));
+
+		const auto version = property.GetVersion();
+		property.Set(MakeBounds(1));
+		CheckEqual(property.GetVersion(), version);
+
+		property.Set(MakeBounds(2));
+		CheckEqual(property.GetVersion(), version + 1);
+		Check(property.Get() == MakeBounds(2), "the value was stored");
+		CheckEqual(notified, 1);
+	} };
+
+	const RegisterTest seqLockNoTornReads{ "SnapshotProperty", "SeqLockReadsAreNeverTorn", []
+	{
+		SeqLockProperty<Bounds> property;
+		Check(ReadWhileWriting(3,
+			[&property] { return property.Get().IsConsistent(); },
+			[&property](const int i) { property.Set(MakeBounds(i)); }),
+			"every read saw one whole write");
+	} };
+
+	const RegisterTest rcuSnapshotOutlivesWrites{ "SnapshotProperty", "RcuSnapshotOutlivesWrites", []
+	{
+		RcuProperty<std::vector<int>> property{ std::vector{ 1, 2, 3 } };
+		const auto snapshot = property.Get();
+
+		property.Update([](std::vector<int>& values) { values.push_back(4); });
+		property.Set(std::vector{ 5 });
+
+		CheckEqual(*snapshot, std::vector{ 1, 2, 3 });
+		CheckEqual(*property.Get(), std::vector{ 5 });
+		CheckEqual(property.GetVersion(), 2ULL);
+	} };
+
+	const RegisterTest rcuNoTornReads{ "SnapshotProperty", "RcuReadsAreNeverTorn", []
+	{
+		RcuProperty<Bounds> property;
+		Check(ReadWhileWriting(3,
+			[&property] { return property.Get()->IsConsistent(); },
+			[&property](const int i) { property.Set(MakeBounds(i)); }),
+			"every read saw one whole write");
+	} };
+
+	// Reads per second with readerCount threads reading while one thread keeps writing
+	template <typename Read, typename Write>
+	auto MeasureReads(const std::string_view name, const std::size_t readerCount, Read read, Write write) -> void
+	{
+		constexpr auto Duration = std::chrono::milliseconds{ 200 };
+
+		std::atomic<std::uint64_t> reads = 0;
+		std::atomic<std::uint64_t> writes = 0;
+		std::atomic<bool> done = false;
+		{
+			std::vector<std::jthread> threads;
+			for (std::size_t i = 0; i < readerCount; i++)
+			{
+				threads.emplace_back([&]
+				{
+					auto count = 0ULL;
+					while (!done.load(std::memory_order_relaxed))
+					{
+						DoNotOptimize(read());
+						count++;
+					}
+					reads += count;
+				});
+			}
+			threads.emplace_back([&]
+			{
+				auto count = 0ULL;
+				while (!done.load(std::memory_order_relaxed))
+				{
+					write(static_cast<double>(count++));
+				}
+				writes += count;
+			});
+
+			std::this_thread::sleep_for(Duration);
+			done = true;
+		}
+
+		const auto seconds = std::chrono::duration<double>{ Duration }.count();
+		std::println("  {:<24} {} readers {:>12.3e} reads/s {:>12.3e} writes/s",
+		             name, readerCount, static_cast<double>(reads) / seconds, static_cast<double>(writes) / seconds);
+	}
+
+	const RegisterBenchmark readWhileWriting{ "SnapshotProperty", "ReadWhileWriting", []
+	{
+		for (const auto readerCount : { 1ULL, 4ULL })
+		{
+			SeqLockProperty<Bounds> seqLock;
+			MeasureReads("SeqLockProperty", readerCount,
+				[&seqLock] { return seqLock.Get().left; },
+				[&seqLock](const double value) { seqLock.Set(MakeBounds(value)); });
+
+			RcuProperty<Bounds> rcu;
+			MeasureReads("RcuProperty", readerCount,
+				[&rcu] { return rcu.Get()->left; },
+				[&rcu](const double value) { rcu.Set(MakeBounds(value)); });
+
+			Property<Bounds> srw;
+			MeasureReads("Property<SRWMutex>", readerCount,
+				[&srw] { return srw.Get()->left; },
+				[&srw](const double value) { srw.Set(MakeBounds(value)); });
+		}
+
+		// NullMutex is not thread safe, it only gives the uncontended single thread baseline
+		PropertyNM<Bounds> unlocked;
+		Measure("Property<NullMutex> Get", 10'000'000, [&unlocked] { DoNotOptimize(unlocked.Get()->left); });
+		SeqLockProperty<Bounds> seqLock;
+		Measure("SeqLockProperty Get", 10'000'000, [&seqLock] { DoNotOptimize(seqLock.Get().left); });
+		RcuProperty<Bounds> rcu;
+		Measure("RcuProperty Get", 10'000'000, [&rcu] { DoNotOptimize(rcu.Get()->left); });
+	} };
+}
@@ -0,0 +1,95 @@
+module PGUI.Tests.Framework;
+
+import std;
+
+namespace PGUI::Tests
+{
+	namespace
+	{
+		auto goldenDirectory = std::filesystem::path{ "golden" };
+		auto updateGolden = false;
+	}
+
+	auto GetTestCases() noexcept -> std::vector<TestCase>&
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	RegisterTest::RegisterTest(const std::string_view suite, const std::string_view name, const TestFunction function) noexcept
+	{
+		GetTestCases().emplace_back(suite, name, function, TestKind::Test);
+	}
+
+	RegisterBenchmark::RegisterBenchmark(const std::string_view suite, const std::string_view name, const TestFunction function) noexcept
+	{
+		GetTestCases().emplace_back(suite, name, function, TestKind::Benchmark);
+	}
+
+	auto Check(const bool condition, const std::string_view expression, const std::source_location& location) -> void
+	{
+		if (!condition)
+		{
+			throw CheckFailure{ std::string{ expression }, location };
+		}
+	}
+
+	auto CheckNear(const double actual, const double expected, const double tolerance, const std::source_location& location) -> void
+	{
+		if (std::abs(actual - expected) > tolerance)
+		{
+			throw CheckFailure{ std::format("expected {} +- {} but got {}", expected, tolerance, actual), location };
+		}
+	}
+
+	auto Report(const BenchmarkResult& result) -> void
+	{
+		std::println("  {:<48} {:>12.1f} ns/iter {:>10.2f} allocs/iter {:>12} bytes peak",
+		             result.name,
+		             result.GetNanosecondsPerIteration(),
+		             result.GetAllocationsPerIteration(),
+		             result.peakBytes);
+	}
+
+	auto CheckGolden(const std::string_view fileName, const std::string_view actual, const std::source_location& location) -> void
+	{
+		const auto path = goldenDirectory / fileName;
+		if (updateGolden)
+		{
+			std::filesystem::create_directories(path.parent_path());
+			std::ofstream file{ path, std::ios::binary };
+			file << actual;
+			return;
+		}
+
+		std::ifstream file{ path, std::ios::binary };
+		if (!file)
+		{
+			throw CheckFailure{ std::format("missing golden file {}, run with --update-golden", path.string()), location };
+		}
+
+		const auto expected = std::string{ std::istreambuf_iterator{ file }, std::istreambuf_iterator<char>{ } };
+		if (expected == actual)
+		{
+			return;
+		}
+
+		const auto [expectedEnd, actualEnd] = std::ranges::mismatch(expected, actual);
+		const auto offset = std::distance(expected.begin(), expectedEnd);
+		const auto line = std::ranges::count(expected.begin(), expectedEnd, '\n') + 1;
+		throw CheckFailure{
+			std::format("output differs from {} at line {} (byte {})", path.string(), line, offset),
+			location
+		};
+	}
+
+	auto SetGoldenDirectory(std::filesystem::path directory) noexcept -> void
+	{
+		goldenDirectory = std::move(directory);
+	}
+
+	auto SetUpdateGolden(const bool update) noexcept -> void
+	{
+		updateGolden = update;
+	}
+}
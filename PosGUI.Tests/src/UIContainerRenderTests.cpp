@@ -0,0 +1,121 @@
+#define WIN32_LEAN_AND_MEAN
+#include <d2d1_3.h>
+
+import std;
+
+import PGUI.ComPtr;
+import PGUI.Shape;
+import PGUI.UI.Graphics;
+import PGUI.UI.DXDevices;
+import PGUI.UI.D2D.D2DEnums;
+import PGUI.UI.UICore;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI;
+using namespace PGUI::Tests;
+
+namespace
+{
+	constexpr auto TargetSize = 400U;
+
+	class CountingElement final : public UIElement
+	{
+		public:
+		explicit CountingElement(const RectF& rect) noexcept :
+			UIElement{ rect }
+		{
+		}
+
+		auto Render(const Graphics&) noexcept -> void override
+		{
+			renderCount++;
+		}
+
+		int renderCount = 0;
+	};
+
+	// Offscreen bitmap target, so rendering runs without a window
+	[[nodiscard]] auto CreateHeadlessContext() -> ComPtr<ID2D1DeviceContext7>
+	{
+		if (DXDevices::D2D1Device().get() == nullptr)
+		{
+			DXDevices::InitDevices();
+		}
+
+		ComPtr<ID2D1DeviceContext7> context;
+		Check(SUCCEEDED(DXDevices::D2D1Device()->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, context.put())),
+		      "the device context was created");
+
+		ComPtr<ID2D1Bitmap1> target;
+		const auto properties = D2D1::BitmapProperties1(
+			D2D1_BITMAP_OPTIONS_TARGET,
+			D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+		Check(SUCCEEDED(context->CreateBitmap(D2D1::SizeU(TargetSize, TargetSize), nullptr, 0, properties, target.put())),
+		      "the target bitmap was created");
+		context->SetTarget(target.get());
+
+		return context;
+	}
+
+	const RegisterTest renderSkipsHiddenChildren{ "UIContainer", "RenderSkipsChildrenOutsideTheVisibleArea", []
+	{
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 400, 400 });
+
+		const std::array children{
+			*container->CreateChildElement<CountingElement>(RectF{ 0, 0, 100, 100 }),
+			*container->CreateChildElement<CountingElement>(RectF{ 150, 150, 250, 250 }),
+			*container->CreateChildElement<CountingElement>(RectF{ 300, 300, 400, 400 }),
+			// Outside the container, never drawn even where the target would show it
+			*container->CreateChildElement<CountingElement>(RectF{ 500, 500, 600, 600 })
+		};
+
+		const auto context = CreateHeadlessContext();
+		const Graphics graphics{ context };
+		const auto render = [&]
+		{
+			for (const auto child : children)
+			{
+				child->renderCount = 0;
+			}
+			container->Render(graphics);
+
+			return children
+			       | std::views::transform([](const auto child) { return child->renderCount; })
+			       | std::ranges::to<std::vector>();
+		};
+
+		context->BeginDraw();
+		for (const auto indexed : { false, true })
+		{
+			container->EnableSpatialIndex(indexed);
+
+			CheckEqual(render(), std::vector{ 1, 1, 1, 0 });
+
+			// Only what a damage clip leaves open is drawn
+			graphics.PushAxisAlignedClip(RectF{ 0, 0, 120, 120 }, D2D::AntiAliasingMode::Aliased);
+			CheckEqual(render(), std::vector{ 1, 0, 0, 0 });
+			graphics.PushAxisAlignedClip(RectF{ 200, 200, 260, 260 }, D2D::AntiAliasingMode::Aliased);
+			CheckEqual(render(), std::vector{ 0, 0, 0, 0 });
+			graphics.PopAxisAlignedClip();
+			graphics.PopAxisAlignedClip();
+
+			graphics.PushAxisAlignedClip(RectF{ 200, 200, 260, 260 }, D2D::AntiAliasingMode::Aliased);
+			CheckEqual(render(), std::vector{ 0, 1, 0, 0 });
+			graphics.PopAxisAlignedClip();
+
+			// Scrolled so the target shows 300 to 700, the container still ends at 400
+			graphics.PushTranslation(PointF{ -300, -300 });
+			CheckEqual(render(), std::vector{ 0, 0, 1, 0 });
+			graphics.PopTransform();
+
+			// A transform that collapses everything leaves nothing visible
+			graphics.PushScale(SizeF{ 0, 0 });
+			CheckEqual(render(), std::vector{ 0, 0, 0, 0 });
+			graphics.PopTransform();
+		}
+		Check(SUCCEEDED(context->EndDraw()), "drawing finished");
+	} };
+}
@@ -0,0 +1,299 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Shape;
+import PGUI.UI.UICore;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.StackLayout;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	class ZIndexedElement final : public UIElement
+	{
+		public:
+		explicit ZIndexedElement(const RectF& rect) noexcept :
+			UIElement{ rect }
+		{
+		}
+
+		using UIElement::SetZIndex;
+	};
+
+	template <typename T>
+	concept CanSetThroughZIndexEvent = requires(const T& element)
+	{
+		element.ZIndexEvent().Set(ZIndices::Normal);
+	};
+
+	class RedrawingElement final : public UIElement
+	{
+		public:
+		explicit RedrawingElement(const RectF& rect) noexcept :
+			UIElement{ rect }
+		{
+		}
+
+		using UIElement::RequestRedraw;
+	};
+
+	const RegisterTest zIndexReordersChildren{ "UIContainer", "ZIndexChangeReordersChildren", []
+	{
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 100, 100 });
+
+		const auto bottom = container->CreateChildElement<ZIndexedElement>(RectF{ 0, 0, 100, 100 });
+		const auto top = container->CreateChildElement<ZIndexedElement>(RectF{ 0, 0, 100, 100 });
+		Check(bottom.has_value() && top.has_value(), "children were created");
+
+		CheckEqual(container->GetElementAtPosition(PointF{ 50, 50 }).value(), static_cast<RawUIElementPtr<>>(*top));
+		(*bottom)->SetZIndex(ZIndices::Tooltip);
+		// Hit testing brings the z-order up to date
+		Check(container->HitTest(PointF{ 50, 50 }), "the point is inside the container");
+		CheckEqual(container->GetElementAtPosition(PointF{ 50, 50 }).value(), static_cast<RawUIElementPtr<>>(*bottom));
+
+		// The event only observes, so the parent can not miss a change made through it
+		static_assert(!CanSetThroughZIndexEvent<ZIndexedElement>);
+		std::vector<ZIndex> seen;
+		const auto topEvent = (*top)->ZIndexEvent();
+		const auto id = topEvent.AddObserver([&seen](const ZIndex& value) { seen.push_back(value); });
+		(*top)->SetZIndex(ZIndices::Debug);
+		CheckEqual(seen, std::vector{ ZIndices::Debug });
+		CheckEqual(topEvent.Get(), ZIndices::Debug);
+		CheckEqual(container->GetElementAtPosition(PointF{ 50, 50 }).value(), static_cast<RawUIElementPtr<>>(*top));
+
+		topEvent.RemoveObserver(id);
+		(*top)->SetZIndex(ZIndices::Normal);
+		CheckEqual(seen, std::vector{ ZIndices::Debug });
+		CheckEqual(container->GetElementAtPosition(PointF{ 50, 50 }).value(), static_cast<RawUIElementPtr<>>(*bottom));
+	} };
+
+	const RegisterTest redrawClippedPerLevel{ "UIContainer", "RedrawIsClippedByEveryAncestor", []
+	{
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto root = UIElement::Create<UIContainer>(RectF{ 0, 0, 100, 100 });
+
+		std::vector<RectF> requested;
+		root->RedrawRequestedEvent().AddCallback([&requested](RawUIElementPtr<>, const RectF area)
+		{
+			requested.push_back(area);
+		});
+
+		const auto middle = root->CreateChildElement<UIContainer>(RectF{ 20, 20, 60, 60 });
+		Check(middle.has_value(), "the middle container was created");
+		const auto child = (*middle)->CreateChildElement<RedrawingElement>(RectF{ 50, 50, 90, 90 });
+		Check(child.has_value(), "the child was created");
+
+		// The middle container cuts the child's area down before the root sees it
+		requested.clear();
+		(*child)->RequestRedraw();
+		CheckEqual(requested.size(), 1ULL);
+		Check(requested.front() == RectF{ 50, 50, 60, 60 }, "the area is clipped to the middle container");
+
+		// Outside the middle container there is nothing to repaint, even though the root would contain it
+		requested.clear();
+		(*child)->RequestRedraw(RectF{ 70, 70, 80, 80 });
+		Check(requested.empty(), "the hidden area never reaches the root");
+	} };
+
+	const RegisterTest layoutReachesNestedPanels{ "UIContainer", "UpdateLayoutReachesNestedPanels", []
+	{
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto root = UIElement::Create<UIContainer>(RectF{ 0, 0, 100, 100 });
+		const auto nested = root->CreateChildElement<UIContainer>(RectF{ 0, 0, 100, 100 });
+		Check(nested.has_value(), "the nested container was created");
+
+		auto panel = std::make_unique<StackLayout>(
+			RectF{ 0, 0, 100, 100 }, LayoutOrientation::Horizontal,
+			MainAxisAlignment::Start, CrossAxisAlignment::Start);
+		const auto stack = panel.get();
+		(*nested)->SetLayoutPanel(MoveChecked(panel));
+		Check(stack->IsLayoutDirty(), "the new panel waits for a layout pass");
+
+		// The host runs this once per frame, rendering no longer lays out
+		root->UpdateLayout();
+		Check(!stack->IsLayoutDirty(), "the pass reached the nested panel");
+
+		stack->SetMainAxisGap(4);
+		Check(stack->IsLayoutDirty(), "the gap invalidated the panel");
+		root->UpdateLayout();
+		Check(!stack->IsLayoutDirty(), "the next pass found the panel again");
+	} };
+
+	const RegisterTest indexedHitTestMatchesScan{ "UIContainer", "IndexedHitTestMatchesBruteForce", []
+	{
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 1000, 1000 });
+		container->EnableSpatialIndex(true);
+
+		std::mt19937 random{ 13 };
+		std::uniform_real_distribution position{ 0.0F, 960.0F };
+		std::uniform_real_distribution extent{ 1.0F, 40.0F };
+		const auto randomRect = [&]
+		{
+			const PointF topLeft{ position(random), position(random) };
+			return RectF{ topLeft, SizeF{ extent(random), extent(random) } };
+		};
+
+		// Children in drawing order, sorted by z-index the same way the container sorts them
+		std::vector<RawUIElementPtr<ZIndexedElement>> model;
+		const auto expectedAt = [&model](const PointF point) -> RawUIElementPtr<>
+		{
+			const auto iter = std::ranges::find_if(
+				model | std::views::reverse,
+				[point](const auto element) { return element->GetRect().Contains(point); });
+			return iter != std::ranges::rend(model) ? *iter : nullptr;
+		};
+
+		for (auto step = 1; step <= 3'000; step++)
+		{
+			if (const auto operation = random() % 10;
+				model.size() < 20 || operation < 3)
+			{
+				model.push_back(*container->CreateChildElement<ZIndexedElement>(randomRect()));
+			}
+			else if (operation < 6)
+			{
+				model[random() % model.size()]->MoveAndResize(randomRect());
+			}
+			else if (operation < 8)
+			{
+				const auto element = model[random() % model.size()];
+				element->SetZIndex(random() % 4);
+				std::ranges::stable_sort(model, { }, [](const auto child) { return child->GetZIndex(); });
+				// Sorting is lazy, bringing it up to date after every change keeps it in step with the model
+				DoNotOptimize(container->HitTest(PointF{ 0, 0 }));
+			}
+			else
+			{
+				const auto iter = model.begin() + static_cast<std::ptrdiff_t>(random() % model.size());
+				Check(container->RemoveChildElement(*iter).has_value(), "the child was removed");
+				model.erase(iter);
+			}
+
+			for (auto query = 0; query < 20; query++)
+			{
+				const PointF point{ position(random), position(random) };
+				CheckEqual(container->GetElementAtPosition(point).value_or(nullptr), expectedAt(point));
+			}
+		}
+
+		// The scan without the index agrees as well
+		container->EnableSpatialIndex(false);
+		for (auto query = 0; query < 1'000; query++)
+		{
+			const PointF point{ position(random), position(random) };
+			CheckEqual(container->GetElementAtPosition(point).value_or(nullptr), expectedAt(point));
+		}
+	} };
+
+	const RegisterBenchmark millionChildren{ "UIContainer", "MillionChildrenMemory", []
+	{
+		constexpr auto ChildCount = 1'000'000ULL;
+
+		UIElementPropertyStore store;
+		{
+			UIElementPropertyStore::Scope scope{ store };
+			const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 100, 100 });
+
+			const AllocationScope allocations;
+			for (auto i = 0ULL; i < ChildCount; i++)
+			{
+				Unused(container->CreateChildElement<UIElement>(RectF{ 0, 0, 1, 1 }));
+			}
+			const auto usage = store.GetMemoryUsage();
+
+			std::println("  {} children: {:.1f} heap bytes and {:.2f} allocations per child, store {:.1f} bytes per element",
+			             ChildCount,
+			             static_cast<double>(allocations.GetPeakBytes()) / ChildCount,
+			             static_cast<double>(allocations.GetAllocations()) / ChildCount,
+			             usage.BytesPerEntry());
+			Check(usage.observerBytes < 1024, "children don't register per element observers");
+		}
+		CheckEqual(store.GetElementCount(), 0ULL);
+	} };
+
+	const RegisterBenchmark removeAndReorder{ "UIContainer", "RemoveAndReorderHundredThousandChildren", []
+	{
+		constexpr auto ChildCount = 100'000ULL;
+		constexpr auto RemovalCount = 50'000ULL;
+
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 100, 100 });
+
+		std::vector<RawUIElementPtr<ZIndexedElement>> elements;
+		elements.reserve(ChildCount);
+		for (auto i = 0ULL; i < ChildCount; i++)
+		{
+			elements.push_back(*container->CreateChildElement<ZIndexedElement>(RectF{ 0, 0, 1, 1 }));
+		}
+
+		std::mt19937 random{ 7 };
+		// Raising a child near the top only moves the few children above it
+		Unused(Measure("raise a child near the top of 100k", 1'000, [&]
+		{
+			const auto element = elements[ChildCount - 1 - random() % 16];
+			element->SetZIndex(element->GetZIndex() + 1);
+			DoNotOptimize(container->HitTest(PointF{ 50, 50 }));
+		}));
+
+		Unused(Measure("remove a random child of 100k", RemovalCount, [&]
+		{
+			const auto count = container->GetChildElementCount();
+			Unused(container->RemoveChildElement(random() % count));
+		}));
+
+		CheckEqual(container->GetLinearElementCount(), ChildCount - RemovalCount);
+		for (auto i = 0ULL; i < ChildCount - RemovalCount; i += 997)
+		{
+			const auto element = container->GetElementAtIndex(i).value();
+			CheckEqual(container->GetElementIndex(element).value(), i);
+			CheckEqual(container->GetElementAtLinearIndex(i).value(), element);
+		}
+	} };
+
+	const RegisterBenchmark hitTestWithIndex{ "UIContainer", "HitTestFiftyThousandChildren", []
+	{
+		constexpr auto ChildCount = 50'000ULL;
+		constexpr auto QueryCount = 2'000ULL;
+
+		UIElementPropertyStore store;
+		UIElementPropertyStore::Scope scope{ store };
+		const auto container = UIElement::Create<UIContainer>(RectF{ 0, 0, 10'000, 10'000 });
+
+		std::mt19937 random{ 11 };
+		std::uniform_real_distribution position{ 0.0F, 9'980.0F };
+		for (auto i = 0ULL; i < ChildCount; i++)
+		{
+			Unused(container->CreateChildElement<UIElement>(RectF{ PointF{ position(random), position(random) }, SizeF{ 20, 20 } }));
+		}
+
+		std::vector<PointF> points(QueryCount);
+		std::ranges::generate(points, [&] { return PointF{ position(random), position(random) }; });
+
+		auto next = 0ULL;
+		const auto scan = Measure("hit test among 50k children, linear scan", QueryCount, [&]
+		{
+			DoNotOptimize(container->GetElementAtPosition(points[next++ % QueryCount]));
+		});
+
+		container->EnableSpatialIndex(true);
+		const auto indexed = Measure("hit test among 50k children, spatial index", QueryCount, [&]
+		{
+			DoNotOptimize(container->GetElementAtPosition(points[next++ % QueryCount]));
+		});
+
+		std::println("  the index answers {:.1f}x faster",
+		             scan.GetNanosecondsPerIteration() / indexed.GetNanosecondsPerIteration());
+	} };
+}
@@ -0,0 +1,163 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Shape;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.VirtualizingStackLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	constexpr auto Estimate = 17.3F;
+
+	// Hands out spacers from a small pool, only the realized window is alive at a time
+	class SpacerPool
+	{
+		public:
+		[[nodiscard]] auto Realize(const std::size_t index) noexcept -> std::optional<LayoutItem>
+		{
+			auto& spacer = spacers[index % spacers.size()];
+			spacer.SetDesiredSize(SizeF{ 100, Estimate });
+			return MakeLayoutItem(spacer);
+		}
+
+		private:
+		std::array<LayoutSpacer, 256> spacers;
+	};
+
+	[[nodiscard]] auto MakeList(SpacerPool& pool, const std::size_t count) -> std::unique_ptr<VirtualizingStackLayout>
+	{
+		return std::make_unique<VirtualizingStackLayout>(
+			RectF{ 0, 0, 100, 600 }, LayoutOrientation::Vertical, count,
+			[](std::size_t) { return Estimate; },
+			[&pool](const std::size_t index) { return pool.Realize(index); });
+	}
+
+	const RegisterTest offsetsFarDown{ "VirtualizingStackLayout", "OffsetsStayExactFarDownLongLists", []
+	{
+		constexpr auto Count = 4'000'000ULL;
+
+		SpacerPool pool;
+		const auto list = MakeList(pool, Count);
+
+		for (const auto index : { 1'000ULL, 1'500'000ULL, Count - 1 })
+		{
+			const auto expected = static_cast<float>(static_cast<double>(Estimate) * static_cast<double>(index));
+			CheckEqual(*list->GetItemOffset(index), expected);
+		}
+		CheckEqual(list->GetContentExtent(), static_cast<float>(static_cast<double>(Estimate) * Count));
+	} };
+
+	const RegisterTest extentUpdatesDontDrift{ "VirtualizingStackLayout", "ExtentUpdatesDontDrift", []
+	{
+		constexpr auto Count = 1'000ULL;
+
+		SpacerPool pool;
+		const auto list = MakeList(pool, Count);
+
+		std::mt19937 random{ 9 };
+		std::uniform_real_distribution extent{ 1.0F, 500.0F };
+		std::uniform_int_distribution<std::size_t> index{ 0, Count - 1 };
+		std::vector<float> exact(Count, Estimate);
+		for (auto i = 0; i < 200'000; i++)
+		{
+			const auto target = index(random);
+			exact[target] = extent(random);
+			Check(list->SetItemExtent(target, exact[target]).has_value(), "extent was set");
+		}
+
+		for (const auto i : std::array<std::size_t, 3>{ 0, 17, Count - 1 })
+		{
+			CheckEqual(*list->GetItemExtent(i), exact[i]);
+		}
+		const auto total = std::accumulate(exact.begin(), exact.end(), 0.0);
+		CheckNear(list->GetContentExtent(), total, total * 1e-6);
+	} };
+
+	const RegisterTest scrollFarDown{ "VirtualizingStackLayout", "ScrollFarDownArrangesAtViewport", []
+	{
+		constexpr auto Count = 4'000'000ULL;
+		constexpr auto Target = 3'000'000ULL;
+
+		SpacerPool pool;
+		const auto list = MakeList(pool, Count);
+		Check(list->ScrollToIndex(Target).has_value(), "scrolled");
+		list->UpdateLayout();
+
+		const auto& realized = list->GetRealizedItems();
+		Check(realized.contains(Target), "the target item is realized");
+
+		CheckEqual(realized.at(Target).GetRect().top, 0.0F);
+		for (const auto& [index, item] : realized)
+		{
+			const auto expected = static_cast<double>(index) - static_cast<double>(Target);
+			CheckNear(item.GetRect().top, expected * Estimate, 0.01);
+			CheckNear(item.GetRect().Height(), Estimate, 0.0001);
+		}
+	} };
+
+	const RegisterTest scrollNearEnd{ "VirtualizingStackLayout", "ScrollNearEndKeepsExactOffset", []
+	{
+		constexpr auto Count = 5'000'000ULL;
+
+		SpacerPool pool;
+		const auto list = MakeList(pool, Count);
+
+		// Offsets this far down are over 80M, where neighbouring floats are 8 apart
+		for (const auto target : { Count - 100, Count - 7, Count - 1 })
+		{
+			Check(list->ScrollToIndex(target).has_value(), "scrolled");
+			list->UpdateLayout();
+			CheckNear(list->GetScrollOffset(), static_cast<double>(Estimate) * static_cast<double>(target), 0.001);
+
+			const auto& realized = list->GetRealizedItems();
+			Check(realized.contains(target), "the target item is realized");
+			CheckEqual(realized.at(target).GetRect().top, 0.0F);
+			if (realized.contains(target - 1))
+			{
+				CheckNear(realized.at(target - 1).GetRect().top, -Estimate, 0.01);
+			}
+		}
+
+		// Handing the narrowed viewport back, for example to resize it, keeps the exact offset
+		const auto offset = list->GetScrollOffset();
+		auto viewport = list->GetViewport();
+		viewport.right += 50;
+		list->SetViewport(viewport);
+		CheckEqual(list->GetScrollOffset(), offset);
+		list->UpdateLayout();
+		CheckEqual(list->GetRealizedItems().at(Count - 1).GetRect().top, 0.0F);
+	} };
+
+	const RegisterBenchmark scrollMillion{ "VirtualizingStackLayout", "ScrollMillionItems", []
+	{
+		constexpr auto Count = 1'000'000ULL;
+
+		SpacerPool pool;
+		const auto list = MakeList(pool, Count);
+		list->UpdateLayout();
+
+		std::mt19937 random{ 1 };
+		std::uniform_int_distribution<std::size_t> index{ 0, Count - 1 };
+		std::uniform_real_distribution extent{ 10.0F, 40.0F };
+		Unused(Measure("scroll to a random item and lay out, 1M items", 10'000, [&]
+		{
+			Unused(list->ScrollToIndex(index(random)));
+			list->UpdateLayout();
+		}));
+		Unused(Measure("set a random extent, 1M items", 1'000'000, [&]
+		{
+			Unused(list->SetItemExtent(index(random), extent(random)));
+		}));
+		Unused(Measure("index at a random offset, 1M items", 1'000'000, [&]
+		{
+			DoNotOptimize(list->GetIndexAtOffset(std::uniform_real_distribution{ 0.0F, list->GetContentExtent() }(random)));
+		}));
+	} };
+}
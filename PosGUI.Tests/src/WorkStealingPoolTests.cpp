@@ -0,0 +1,163 @@
+import std;
+
+import PGUI.Utils;
+import PGUI.Shape;
+import PGUI.WorkStealingPool;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.StackLayout;
+import PGUI.UI.Layout.LayoutDiagnostics;
+import PGUI.Tests.Framework;
+
+using namespace PGUI;
+using namespace PGUI::UI::Layout;
+using namespace PGUI::Tests;
+
+namespace
+{
+	// Root stack of rows, each row a stack of columns, each column a stack of spacers
+	class PanelTree
+	{
+		public:
+		PanelTree(const std::size_t rowCount, const std::size_t columnCount, const std::size_t spacerCount) :
+			root{
+				RectF{ 0, 0, 4000, 4000 }, LayoutOrientation::Vertical,
+				MainAxisAlignment::Start, CrossAxisAlignment::Stretch
+			}
+		{
+			rows.reserve(rowCount);
+			columns.reserve(rowCount * columnCount);
+			spacers.reserve(rowCount * columnCount * spacerCount);
+
+			for (std::size_t row = 0; row < rowCount; row++)
+			{
+				auto& rowPanel = *rows.emplace_back(std::make_unique<StackLayout>(
+					RectF{ }, LayoutOrientation::Horizontal, MainAxisAlignment::SpaceBetween, CrossAxisAlignment::Stretch));
+				root.AddItem(rowPanel);
+
+				for (std::size_t column = 0; column < columnCount; column++)
+				{
+					auto& columnPanel = *columns.emplace_back(std::make_unique<StackLayout>(
+						RectF{ }, LayoutOrientation::Vertical, MainAxisAlignment::SpaceEvenly, CrossAxisAlignment::Center));
+					rowPanel.AddItem(columnPanel);
+
+					for (std::size_t i = 0; i < spacerCount; i++)
+					{
+						const auto size = static_cast<float>((row + column + i) % 7 + 1);
+						columnPanel.AddItem(spacers.emplace_back(SizeF{ size, size }));
+					}
+				}
+			}
+		}
+
+		[[nodiscard]] auto GetRoot() noexcept -> StackLayout& { return root; }
+
+		[[nodiscard]] auto GetNodeCount() const noexcept
+		{
+			return 1 + rows.size() + columns.size() + spacers.size();
+		}
+
+		auto InvalidateColumns() noexcept -> void
+		{
+			for (const auto& column : columns)
+			{
+				column->InvalidateArrange();
+			}
+		}
+
+		private:
+		StackLayout root;
+		std::vector<std::unique_ptr<StackLayout>> rows;
+		std::vector<std::unique_ptr<StackLayout>> columns;
+		std::vector<LayoutSpacer> spacers;
+	};
+
+	const RegisterTest nestedGroupsFinish{ "WorkStealingPool", "NestedGroupsFinishWithOneWorker", []
+	{
+		WorkStealingPool pool{ 1 };
+		std::atomic<int> leafCount = 0;
+		{
+			TaskGroup outer{ pool };
+			for (auto i = 0; i < 16; i++)
+			{
+				outer.Run([&pool, &leafCount]
+				{
+					TaskGroup inner{ pool };
+					for (auto j = 0; j < 16; j++)
+					{
+						inner.Run([&leafCount]
+						{
+							std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+							leafCount.fetch_add(1, std::memory_order_relaxed);
+						});
+					}
+				});
+			}
+		}
+		CheckEqual(leafCount.load(), 256);
+	} };
+
+	const RegisterTest waitSleepsOnLongTask{ "WorkStealingPool", "WaitSleepsWhileGroupRunsElsewhere", []
+	{
+		WorkStealingPool pool{ 1 };
+		std::atomic<bool> finished = false;
+
+		TaskGroup group{ pool };
+		group.Run([&finished]
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+			finished.store(true, std::memory_order_release);
+		});
+		// Makes sure the worker took the task, otherwise Wait would just run it itself
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+
+		const auto cpuStart = std::clock();
+		group.Wait();
+		const auto cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+		Check(finished.load(std::memory_order_acquire), "the task finished before Wait returned");
+		// Spinning through the 90ms left would burn about that much processor time
+		Check(cpuSeconds < 0.03, "the waiting thread slept");
+	} };
+
+	const RegisterTest parallelMatchesSerial{ "WorkStealingPool", "ParallelLayoutMatchesSerial", []
+	{
+		PanelTree serial{ 8, 8, 8 };
+		serial.GetRoot().UpdateLayout();
+
+		WorkStealingPool pool{ 4 };
+		PanelTree parallel{ 8, 8, 8 };
+		parallel.GetRoot().UpdateLayout(pool);
+		CheckEqual(DumpLayoutRects(parallel.GetRoot(), 3), DumpLayoutRects(serial.GetRoot(), 3));
+
+		parallel.InvalidateColumns();
+		parallel.GetRoot().UpdateLayout(pool);
+		CheckEqual(DumpLayoutRects(parallel.GetRoot(), 3), DumpLayoutRects(serial.GetRoot(), 3));
+	} };
+
+	const RegisterBenchmark threadScaling{ "WorkStealingPool", "LayoutScalingOnHundredThousandNodes", []
+	{
+		// 1 + 64 + 2048 + 98304 nodes
+		PanelTree tree{ 64, 32, 48 };
+		std::println("  {} nodes", tree.GetNodeCount());
+
+		tree.GetRoot().UpdateLayout();
+		const auto serial = Measure("serial pass over every column", 20, [&tree]
+		{
+			tree.InvalidateColumns();
+			tree.GetRoot().UpdateLayout();
+		});
+
+		for (const auto threadCount : std::array<std::size_t, 5>{ 1, 2, 4, 8, 16 })
+		{
+			// The thread calling UpdateLayout helps as well, a pool of one worker still runs two threads
+			WorkStealingPool pool{ threadCount };
+			const auto parallel = Measure(std::format("parallel pass, {} workers", threadCount), 20, [&tree, &pool]
+			{
+				tree.InvalidateColumns();
+				tree.GetRoot().UpdateLayout(pool);
+			});
+			std::println("  {:.2f}x the serial pass", serial.GetNanosecondsPerIteration() / parallel.GetNanosecondsPerIteration());
+		}
+	} };
+}
@@ -0,0 +1,111 @@
+export module PGUI.DataBinding.CollectionBinder;
+
+import std;
+
+import PGUI.Event;
+import PGUI.Utils;
+import PGUI.DataBinding.ObservableCollection;
+
+export namespace PGUI::DataBinding
+{
+	// Mirrors the source collection into the target by replaying its change records,
+	// so the target only touches the affected items
+	template <typename SourceType, typename TargetType>
+	class CollectionBinder
+	{
+		using Converter = std::function<TargetType(const SourceType&)>;
+
+		public:
+		CollectionBinder(ObservableCollection<SourceType>& source, ObservableCollection<TargetType>& target) noexcept
+			requires std::convertible_to<SourceType, TargetType> :
+			CollectionBinder{ source, target, [](const SourceType& value)
+			{
+				return static_cast<TargetType>(value);
+			} }
+		{
+		}
+
+		template <std::invocable<const SourceType&> Func>
+			requires std::convertible_to<std::invoke_result_t<Func, const SourceType&>, TargetType>
+		CollectionBinder(ObservableCollection<SourceType>& source, ObservableCollection<TargetType>& target,
+		                 Func converter) noexcept :
+			source{ source }, target{ target }, converter{ MoveChecked(converter) }
+		{
+			target.Assign(*source.Get() | std::views::transform(this->converter));
+
+			observerId = source.AddObserver([this](const auto& items, const auto changes)
+			{
+				Apply(*items, changes);
+			});
+		}
+
+		CollectionBinder(const CollectionBinder&) noexcept = delete;
+		CollectionBinder(CollectionBinder&&) noexcept = delete;
+		auto operator=(const CollectionBinder&) noexcept -> CollectionBinder& = delete;
+		auto operator=(CollectionBinder&&) noexcept -> CollectionBinder& = delete;
+
+		~CollectionBinder() noexcept
+		{
+			source.get().RemoveObserver(observerId);
+		}
+
+		private:
+		std::reference_wrapper<ObservableCollection<SourceType>> source;
+		std::reference_wrapper<ObservableCollection<TargetType>> target;
+		Converter converter;
+		CallbackId observerId{ };
+
+		auto Apply(
+			const std::vector<SourceType>& items,
+			const std::span<const CollectionChange<SourceType>> changes) noexcept -> void
+		{
+			auto& targetCollection = target.get();
+
+			if (changes.empty())
+			{
+				return;
+			}
+			if (changes.front().type == CollectionChangeType::Reset)
+			{
+				targetCollection.Assign(items | std::views::transform(converter));
+				return;
+			}
+
+			typename ObservableCollection<TargetType>::Batch batch{ targetCollection };
+			for (const auto& change : changes)
+			{
+				switch (change.type)
+				{
+					case CollectionChangeType::Insert:
+					{
+						Unused(targetCollection.InsertRange(change.index, change.newItems | std::views::transform(converter)));
+						break;
+					}
+					case CollectionChangeType::Remove:
+					{
+						Unused(targetCollection.Erase(change.index, change.count));
+						break;
+					}
+					case CollectionChangeType::Move:
+					{
+						Unused(targetCollection.Move(change.index, change.newIndex));
+						break;
+					}
+					case CollectionChangeType::Replace:
+					{
+						for (const auto& [offset, item] : change.newItems | std::views::enumerate)
+						{
+							Unused(targetCollection.Replace(change.index + static_cast<std::size_t>(offset), converter(item)));
+						}
+						break;
+					}
+					case CollectionChangeType::Reset:
+					{
+						targetCollection.Assign(items | std::views::transform(converter));
+						break;
+					}
+				}
+			}
+		}
+	};
+}
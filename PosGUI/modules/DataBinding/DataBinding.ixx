@@ -7,6 +7,13 @@ export import PGUI.DataBinding.OneWayBinder;
 export import PGUI.DataBinding.TwoWayBinder;
 export import PGUI.DataBinding.ValidatedProperty;
 export import PGUI.DataBinding.DerivedProperty;
+export import PGUI.DataBinding.LazyDerivedProperty;
+export import PGUI.DataBinding.ObservableCollection;
+export import PGUI.DataBinding.SnapshotProperty;
+export import PGUI.DataBinding.CollectionBinder;
+export import PGUI.DataBinding.PropagationScheduler;
+export import PGUI.DataBinding.PropertyTransaction;
+export import PGUI.DataBinding.PropertyTable;
 
 export namespace PGUI::DataBinding
 {
@@ -41,4 +48,19 @@ export namespace PGUI::DataBinding
 	{
 		return TwoWayBinder{ property1, property2, converter1, converter2 };
 	}
+
+	template <typename SourceType, typename TargetType>
+	[[nodiscard]] auto Bind(ObservableCollection<SourceType>& source, ObservableCollection<TargetType>& target)
+	{
+		return CollectionBinder{ source, target };
+	}
+
+	template <typename SourceType, typename TargetType, typename Func>
+		requires std::invocable<Func, const SourceType&> &&
+		         std::convertible_to<std::invoke_result_t<Func, const SourceType&>, TargetType>
+	[[nodiscard]] auto Bind(ObservableCollection<SourceType>& source, ObservableCollection<TargetType>& target,
+	                        const Func& converter)
+	{
+		return CollectionBinder{ source, target, converter };
+	}
 }
@@ -4,32 +4,31 @@ import std;
 
 import PGUI.Event;
 import PGUI.Mutex;
+import PGUI.Utils;
 import PGUI.DataBinding.Property;
+import PGUI.DataBinding.PropagationScheduler;
 
 export namespace PGUI::DataBinding
 {
+	// Recomputed through the PropagationScheduler, so in a diamond the value is derived once
+	// per change wave from fully updated dependencies
 	template <typename T, typename Mutex = Mutex::SRWMutex>
-	class DerivedProperty final : public Property<T, Mutex>
+	class DerivedProperty final : public Property<T, Mutex>, public PropagationNode
 	{
 		public:
 		template <typename Deriver, typename... Dependencies>
 			requires std::invocable<Deriver, const Dependencies::ValueType&...> &&
 			         std::convertible_to<std::invoke_result_t<Deriver, const Dependencies::ValueType&...>, T>
 		explicit DerivedProperty(const Deriver& deriver,
-		                         Dependencies&... dependencies) noexcept
-		{
-			auto update = [this, deriver, &dependencies...]
-			{
-				Property<T, Mutex>::Set(deriver(dependencies.Get()...));
-			};
-
-			(unsubscribers.push_back(
-				[&dep = dependencies, 
-				id = dependencies.AddObserver([update](const auto&) { update(); })]
+		                         Dependencies&... dependencies) noexcept :
+			PropagationNode{ std::max({ std::size_t{ 0 }, PropagationRank(dependencies)... }) + 1 },
+			compute{ [deriver, &dependencies...]
 			{
-				dep.RemoveObserver(id);
-			}), ...);
-			update();
+				return static_cast<T>(deriver(dependencies.Get()...));
+			} }
+		{
+			(Subscribe(dependencies), ...);
+			Unused(Property<T, Mutex>::SetValue(compute()));
 		};
 
 		DerivedProperty(const DerivedProperty&) noexcept = delete;
@@ -67,8 +66,54 @@ export namespace PGUI::DataBinding
 			return Property<T, Mutex>::operator<=>(val);
 		}
 
+		protected:
+		auto RecomputeValue() noexcept -> bool override
+		{
+			return Property<T, Mutex>::SetValue(compute());
+		}
+
+		auto PublishValue() noexcept -> void override
+		{
+			Property<T, Mutex>::NotifyObservers();
+		}
+
+		// Reached when the value is set directly instead of being recomputed
+		auto NotifyObservers() noexcept -> void override
+		{
+			PropagationScope scope;
+			PropagationScheduler::MarkDependentsDirty(*this);
+			Property<T, Mutex>::NotifyObservers();
+		}
+
 		private:
+		std::move_only_function<T()> compute;
 		std::vector<std::move_only_function<void()>> unsubscribers;
+
+		template <typename Dependency>
+		auto Subscribe(Dependency& dependency) noexcept -> void
+		{
+			// Derived dependencies mark this dirty during the wave, before any observer runs
+			if constexpr (std::derived_from<Dependency, PropagationNode>)
+			{
+				dependency.AddDependent(*this);
+				unsubscribers.push_back([this, &dependency]
+				{
+					dependency.RemoveDependent(*this);
+				});
+			}
+			else
+			{
+				unsubscribers.push_back(
+					[&dependency,
+					id = dependency.AddObserver([this](const auto&)
+					{
+						PropagationScheduler::MarkDirty(*this);
+					})]
+				{
+					dependency.RemoveObserver(id);
+				});
+			}
+		}
 	};
 
 	template <typename T>
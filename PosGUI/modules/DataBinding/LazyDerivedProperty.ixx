@@ -0,0 +1,264 @@
+export module PGUI.DataBinding.LazyDerivedProperty;
+
+import std;
+
+import PGUI.Event;
+import PGUI.Mutex;
+import PGUI.Utils;
+import PGUI.DataBinding.PropagationScheduler;
+
+export namespace PGUI::DataBinding
+{
+	namespace Detail
+	{
+		// Shared mutex that remembers which threads hold it shared,
+		// so a thread still holding an AccessorProxy can be kept from taking it exclusively
+		template <Mutex::SharedMutexType Mutex>
+		class ReaderTrackingMutex
+		{
+			public:
+			auto lock() noexcept -> void { mutex.lock(); }
+			auto unlock() noexcept -> void { mutex.unlock(); }
+			[[nodiscard]] auto try_lock() noexcept -> bool { return mutex.try_lock(); }
+
+			auto lock_shared() noexcept -> void
+			{
+				mutex.lock_shared();
+				heldShared.push_back(this);
+			}
+			auto unlock_shared() noexcept -> void
+			{
+				const auto iter = std::ranges::find(heldShared, this);
+				*iter = heldShared.back();
+				heldShared.pop_back();
+				mutex.unlock_shared();
+			}
+			[[nodiscard]] auto try_lock_shared() noexcept -> bool
+			{
+				if (!mutex.try_lock_shared())
+				{
+					return false;
+				}
+				heldShared.push_back(this);
+
+				return true;
+			}
+
+			[[nodiscard]] auto IsHeldSharedByThisThread() const noexcept -> bool
+			{
+				return std::ranges::find(heldShared, this) != heldShared.end();
+			}
+
+			private:
+			Mutex mutex;
+			static inline thread_local std::vector<const ReaderTrackingMutex*> heldShared;
+		};
+	}
+
+	// Derived value that is only recomputed when read.
+	// A dependency change just marks it stale, the next Get() compares dependency versions
+	// and runs the deriver only if one of them actually changed.
+	// While it has observers it is kept up to date eagerly like DerivedProperty.
+	template <std::default_initializable T, Mutex::SharedMutexType Mutex = Mutex::SRWMutex>
+	class LazyDerivedProperty final : public PropagationNode
+	{
+		public:
+		using ValueType = T;
+		using MutexType = Mutex;
+
+		using AccessorProxyType = AccessorProxy<T, Detail::ReaderTrackingMutex<Mutex>>;
+
+		using EventType = EventT<Mutex, const AccessorProxyType&>;
+
+		template <typename Deriver, typename... Dependencies>
+			requires std::invocable<Deriver, const Dependencies::ValueType&...> &&
+			         std::convertible_to<std::invoke_result_t<Deriver, const Dependencies::ValueType&...>, T>
+		explicit LazyDerivedProperty(const Deriver& deriver,
+		                             Dependencies&... dependencies) noexcept :
+			PropagationNode{ std::max({ std::size_t{ 0 }, PropagationRank(dependencies)... }) + 1 },
+			compute{ [deriver, &dependencies...]
+			{
+				return static_cast<T>(deriver(dependencies.Get()...));
+			} },
+			inputsChanged{ [&dependencies..., seenVersions = std::optional<std::array<std::uint64_t, sizeof...(Dependencies)>>{ }]() mutable
+			{
+				const std::array<std::uint64_t, sizeof...(Dependencies)> versions{ dependencies.GetVersion()... };
+				if (seenVersions == versions)
+				{
+					return false;
+				}
+				seenVersions = versions;
+
+				return true;
+			} }
+		{
+			(Subscribe(dependencies), ...);
+		}
+
+		LazyDerivedProperty(const LazyDerivedProperty&) noexcept = delete;
+		LazyDerivedProperty(LazyDerivedProperty&&) noexcept = delete;
+		auto operator=(const LazyDerivedProperty&) noexcept -> LazyDerivedProperty& = delete;
+		auto operator=(LazyDerivedProperty&&) noexcept -> LazyDerivedProperty& = delete;
+
+		~LazyDerivedProperty() noexcept override
+		{
+			for (auto& unsubscriber : unsubscribers)
+			{
+				unsubscriber();
+			}
+		}
+
+		[[nodiscard]] auto Get() const noexcept
+		{
+			Unused(Refresh());
+			return AccessorProxyType{ value, mutex };
+		}
+
+		[[nodiscard]] auto GetVersion() const noexcept
+		{
+			Unused(Refresh());
+			return version.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] auto IsStale() const noexcept
+		{
+			return stale.load(std::memory_order_acquire);
+		}
+
+		auto AddObserver(CallbackType<const AccessorProxyType&> auto callback) noexcept
+		{
+			observerCount.fetch_add(1, std::memory_order_relaxed);
+			return valueChangedEvent.AddCallback(callback);
+		}
+
+		auto RemoveObserver(CallbackId id) noexcept -> void
+		{
+			if (valueChangedEvent.RemoveCallback(id))
+			{
+				observerCount.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		auto ClearObservers() noexcept -> void
+		{
+			observerCount.store(0, std::memory_order_relaxed);
+			valueChangedEvent.ClearCallbacks();
+		}
+
+		auto operator*() const noexcept -> AccessorProxyType
+		{
+			return Get();
+		}
+
+		protected:
+		auto RecomputeValue() noexcept -> bool override
+		{
+			stale.store(true, std::memory_order_release);
+			if (!HasObservers())
+			{
+				// Only pass the staleness on, dependents pull the value when they need it
+				return HasDependents();
+			}
+
+			return Refresh();
+		}
+
+		auto PublishValue() noexcept -> void override
+		{
+			if (!HasObservers())
+			{
+				return;
+			}
+
+			PropagationScope scope;
+			valueChangedEvent.Invoke(Get());
+		}
+
+		private:
+		mutable T value{ };
+		mutable Detail::ReaderTrackingMutex<Mutex> mutex;
+		mutable std::atomic<std::uint64_t> version = 0;
+		mutable std::atomic<bool> stale = true;
+		std::atomic<std::size_t> observerCount = 0;
+		mutable std::move_only_function<T()> compute;
+		mutable std::move_only_function<bool()> inputsChanged;
+		std::vector<std::move_only_function<void()>> unsubscribers;
+		EventType valueChangedEvent{ };
+
+		[[nodiscard]] auto HasObservers() const noexcept -> bool
+		{
+			return observerCount.load(std::memory_order_relaxed) != 0;
+		}
+
+		[[nodiscard]] auto IsObserved() const noexcept -> bool
+		{
+			return HasObservers() || HasDependents();
+		}
+
+		// Returns true if the value changed
+		auto Refresh() const noexcept -> bool
+		{
+			if (!stale.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			// A read while this thread still holds an AccessorProxy, e.g. Get() from an observer.
+			// It keeps seeing the value it already holds and a later read refreshes it.
+			if (mutex.IsHeldSharedByThisThread())
+			{
+				return false;
+			}
+
+			std::scoped_lock lock{ mutex };
+			if (!stale.exchange(false, std::memory_order_acq_rel) || !inputsChanged())
+			{
+				return false;
+			}
+
+			auto newValue = compute();
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (value == newValue)
+				{
+					return false;
+				}
+			}
+			value = MoveChecked(newValue);
+			version.fetch_add(1, std::memory_order_release);
+
+			return true;
+		}
+
+		template <typename Dependency>
+		auto Subscribe(Dependency& dependency) noexcept -> void
+		{
+			if constexpr (std::derived_from<Dependency, PropagationNode>)
+			{
+				dependency.AddDependent(*this);
+				unsubscribers.push_back([this, &dependency]
+				{
+					dependency.RemoveDependent(*this);
+				});
+			}
+			else
+			{
+				unsubscribers.push_back(
+					[&dependency,
+					id = dependency.AddObserver([this](const auto&)
+					{
+						stale.store(true, std::memory_order_release);
+						if (IsObserved())
+						{
+							PropagationScheduler::MarkDirty(*this);
+						}
+					})]
+				{
+					dependency.RemoveObserver(id);
+				});
+			}
+		}
+	};
+
+	template <typename T>
+	using LazyDerivedPropertyNM = LazyDerivedProperty<T, Mutex::NullMutex>;
+}
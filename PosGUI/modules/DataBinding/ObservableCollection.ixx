@@ -0,0 +1,436 @@
+export module PGUI.DataBinding.ObservableCollection;
+
+import std;
+
+import PGUI.ErrorHandling;
+import PGUI.Utils;
+import PGUI.Event;
+import PGUI.Mutex;
+import PGUI.DataBinding.PropagationScheduler;
+import PGUI.DataBinding.PropertyTransaction;
+
+export namespace PGUI::DataBinding
+{
+	enum class CollectionChangeType
+	{
+		Insert,
+		Remove,
+		Move,
+		Replace,
+		Reset
+	};
+
+	// index is where the change starts, for Move it is the source and newIndex the destination.
+	// Insert views the inserted items through newItems, Remove owns the removed ones in oldItems,
+	// Replace has both. newItems is only valid during the notification.
+	// Reset carries nothing, the collection itself has to be read again,
+	// it is always the first change of a notification since it supersedes everything before it.
+	template <typename T>
+	struct CollectionChange
+	{
+		CollectionChangeType type = CollectionChangeType::Reset;
+		std::size_t index = 0;
+		std::size_t newIndex = 0;
+		std::size_t count = 0;
+		std::vector<T> oldItems;
+		std::span<const T> newItems;
+		// Backs newItems once a later change of the same notification moved the items
+		std::vector<T> detachedItems;
+	};
+
+	template <typename T, Mutex::SharedMutexType Mutex = Mutex::SRWMutex>
+	class ObservableCollection
+	{
+		public:
+		using ValueType = T;
+		using MutexType = Mutex;
+		using ContainerType = std::vector<T>;
+		using ChangeType = CollectionChange<T>;
+
+		using AccessorProxyType = AccessorProxy<ContainerType, Mutex>;
+
+		using EventType = EventT<Mutex, const AccessorProxyType&, std::span<const ChangeType>>;
+
+		// Changes made while a batch is alive are delivered together in one notification
+		class Batch
+		{
+			public:
+			explicit Batch(ObservableCollection& collection) noexcept :
+				collection{ collection }
+			{
+				collection.batchDepth.fetch_add(1, std::memory_order_acq_rel);
+			}
+
+			~Batch() noexcept
+			{
+				if (collection.get().batchDepth.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					collection.get().RequestNotify();
+				}
+			}
+
+			Batch(const Batch&) = delete;
+			Batch(Batch&&) = delete;
+			auto operator=(const Batch&) -> Batch& = delete;
+			auto operator=(Batch&&) -> Batch& = delete;
+
+			private:
+			std::reference_wrapper<ObservableCollection> collection;
+		};
+
+		ObservableCollection() noexcept = default;
+
+		explicit(false) ObservableCollection(std::initializer_list<T> items) noexcept :
+			items{ items }
+		{
+		}
+
+		template <std::ranges::input_range Range>
+			requires std::convertible_to<std::ranges::range_reference_t<Range>, T>
+		explicit ObservableCollection(Range&& range) noexcept :
+			items{ std::forward<Range>(range) | std::ranges::to<ContainerType>() }
+		{
+		}
+
+		ObservableCollection(const ObservableCollection&) = delete;
+		ObservableCollection(ObservableCollection&&) = delete;
+		auto operator=(const ObservableCollection&) -> ObservableCollection& = delete;
+		auto operator=(ObservableCollection&&) -> ObservableCollection& = delete;
+
+		~ObservableCollection() noexcept
+		{
+			PropertyTransaction::Cancel(this);
+		}
+
+		[[nodiscard]] auto Get() const noexcept
+		{
+			return AccessorProxyType{ items, mutex };
+		}
+
+		[[nodiscard]] auto Size() const noexcept
+		{
+			std::shared_lock lock{ mutex };
+			return items.size();
+		}
+
+		[[nodiscard]] auto IsEmpty() const noexcept
+		{
+			std::shared_lock lock{ mutex };
+			return items.empty();
+		}
+
+		[[nodiscard]] auto At(std::size_t index) const noexcept -> Result<T>
+		{
+			std::shared_lock lock{ mutex };
+			if (index >= items.size())
+			{
+				return Unexpected{ Error{ ErrorCode::OutOfRange } };
+			}
+
+			return items[index];
+		}
+
+		auto PushBack(const T& item) noexcept -> void
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				DetachLastChange();
+				items.push_back(item);
+				PushAttachedChange(ChangeType{
+					.type = CollectionChangeType::Insert,
+					.index = items.size() - 1,
+					.count = 1
+				});
+			}
+			RequestNotify();
+		}
+
+		auto Insert(std::size_t index, const T& item) noexcept -> Result<void>
+		{
+			return InsertRange(index, std::span{ &item, 1 });
+		}
+
+		template <std::ranges::forward_range Range>
+			requires std::convertible_to<std::ranges::range_reference_t<Range>, T>
+		auto InsertRange(std::size_t index, Range&& range) noexcept -> Result<void>
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				if (index > items.size())
+				{
+					return Unexpected{ Error{ ErrorCode::OutOfRange } };
+				}
+
+				const auto count = static_cast<std::size_t>(std::ranges::distance(range));
+				if (count == 0)
+				{
+					return EmptyResult;
+				}
+
+				DetachLastChange();
+				items.insert_range(std::next(items.begin(), static_cast<std::ptrdiff_t>(index)), std::forward<Range>(range));
+				PushAttachedChange(ChangeType{
+					.type = CollectionChangeType::Insert,
+					.index = index,
+					.count = count
+				});
+			}
+			RequestNotify();
+
+			return EmptyResult;
+		}
+
+		template <std::ranges::input_range Range>
+			requires std::convertible_to<std::ranges::range_reference_t<Range>, T>
+		auto AppendRange(Range&& range) noexcept -> void
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				DetachLastChange();
+				const auto index = items.size();
+				std::ranges::copy(std::forward<Range>(range), std::back_inserter(items));
+				if (items.size() == index)
+				{
+					return;
+				}
+
+				PushAttachedChange(ChangeType{
+					.type = CollectionChangeType::Insert,
+					.index = index,
+					.count = items.size() - index
+				});
+			}
+			RequestNotify();
+		}
+
+		auto Erase(std::size_t index, std::size_t count = 1) noexcept -> Result<void>
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				if (index >= items.size() || count > items.size() - index)
+				{
+					return Unexpected{ Error{ ErrorCode::OutOfRange } };
+				}
+				if (count == 0)
+				{
+					return EmptyResult;
+				}
+
+				DetachLastChange();
+				const auto first = std::next(items.begin(), static_cast<std::ptrdiff_t>(index));
+				const auto last = std::next(first, static_cast<std::ptrdiff_t>(count));
+
+				std::vector<T> removed{ std::make_move_iterator(first), std::make_move_iterator(last) };
+				items.erase(first, last);
+				pendingChanges.push_back(ChangeType{
+					.type = CollectionChangeType::Remove,
+					.index = index,
+					.count = count,
+					.oldItems = MoveChecked(removed)
+				});
+			}
+			RequestNotify();
+
+			return EmptyResult;
+		}
+
+		// newIndex is the position of the item after the move
+		auto Move(std::size_t index, std::size_t newIndex) noexcept -> Result<void>
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				if (index >= items.size() || newIndex >= items.size())
+				{
+					return Unexpected{ Error{ ErrorCode::OutOfRange } };
+				}
+				if (index == newIndex)
+				{
+					return EmptyResult;
+				}
+
+				DetachLastChange();
+				const auto source = std::next(items.begin(), static_cast<std::ptrdiff_t>(index));
+				const auto destination = std::next(items.begin(), static_cast<std::ptrdiff_t>(newIndex));
+				if (index < newIndex)
+				{
+					std::rotate(source, std::next(source), std::next(destination));
+				}
+				else
+				{
+					std::rotate(destination, source, std::next(source));
+				}
+
+				pendingChanges.push_back(ChangeType{
+					.type = CollectionChangeType::Move,
+					.index = index,
+					.newIndex = newIndex,
+					.count = 1
+				});
+			}
+			RequestNotify();
+
+			return EmptyResult;
+		}
+
+		auto Replace(std::size_t index, const T& item) noexcept -> Result<void>
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				if (index >= items.size())
+				{
+					return Unexpected{ Error{ ErrorCode::OutOfRange } };
+				}
+
+				auto& current = items[index];
+				if constexpr (std::equality_comparable<T>)
+				{
+					if (current == item)
+					{
+						return EmptyResult;
+					}
+				}
+
+				DetachLastChange();
+				std::vector<T> removed;
+				removed.push_back(std::exchange(current, item));
+				PushAttachedChange(ChangeType{
+					.type = CollectionChangeType::Replace,
+					.index = index,
+					.count = 1,
+					.oldItems = MoveChecked(removed)
+				});
+			}
+			RequestNotify();
+
+			return EmptyResult;
+		}
+
+		template <std::ranges::input_range Range>
+			requires std::convertible_to<std::ranges::range_reference_t<Range>, T>
+		auto Assign(Range&& range) noexcept -> void
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				items = std::forward<Range>(range) | std::ranges::to<ContainerType>();
+				PushReset();
+			}
+			RequestNotify();
+		}
+
+		auto Clear() noexcept -> void
+		{
+			{
+				std::scoped_lock lock{ mutex };
+				items.clear();
+				PushReset();
+			}
+			RequestNotify();
+		}
+
+		auto AddObserver(CallbackType<const AccessorProxyType&, std::span<const ChangeType>> auto callback) noexcept
+		{
+			return collectionChangedEvent.AddCallback(callback);
+		}
+
+		auto RemoveObserver(CallbackId id) noexcept -> void
+		{
+			collectionChangedEvent.RemoveCallback(id);
+		}
+
+		auto ClearObservers() noexcept -> void
+		{
+			collectionChangedEvent.ClearCallbacks();
+		}
+
+		private:
+		ContainerType items;
+		mutable Mutex mutex;
+		// Notifications only hold mutex shared, this keeps two of them from taking the same changes
+		Mutex notifyMutex;
+		std::atomic<std::size_t> batchDepth = 0;
+		std::vector<ChangeType> pendingChanges;
+		// The last pending change still views its new items in place
+		bool lastChangeAttached = false;
+		EventType collectionChangedEvent{ };
+
+		// Everything recorded before a reset is meaningless to observers
+		auto PushReset() noexcept -> void
+		{
+			pendingChanges.clear();
+			pendingChanges.push_back(ChangeType{ .type = CollectionChangeType::Reset, .count = items.size() });
+			lastChangeAttached = false;
+		}
+
+		auto PushAttachedChange(ChangeType&& change) noexcept -> void
+		{
+			pendingChanges.push_back(MoveChecked(change));
+			lastChangeAttached = true;
+		}
+
+		// Called before the items are modified, the last change copies out the items it views
+		// since they are about to move. A change is copied at most once, and only inside batches.
+		auto DetachLastChange() noexcept -> void
+		{
+			if (!std::exchange(lastChangeAttached, false))
+			{
+				return;
+			}
+
+			auto& change = pendingChanges.back();
+			const auto first = std::next(items.begin(), static_cast<std::ptrdiff_t>(change.index));
+			change.detachedItems.assign(first, std::next(first, static_cast<std::ptrdiff_t>(change.count)));
+			change.newItems = change.detachedItems;
+		}
+
+		auto RequestNotify() noexcept -> void
+		{
+			if (batchDepth.load(std::memory_order_acquire) != 0)
+			{
+				return;
+			}
+			if (!PropertyTransaction::Defer(this, [this] { NotifyObservers(); }))
+			{
+				NotifyObservers();
+			}
+		}
+
+		auto NotifyObservers() noexcept -> void
+		{
+			// Outlives the proxy so changes made by observers propagate once the collection is unlocked
+			PropagationScope scope;
+
+			// Writers are kept out until the observers are done, so the last change can view the items in place
+			const auto proxy = Get();
+
+			std::vector<ChangeType> changes;
+			auto attached = false;
+			{
+				std::scoped_lock lock{ notifyMutex };
+				changes.swap(pendingChanges);
+				attached = std::exchange(lastChangeAttached, false);
+			}
+			if (changes.empty())
+			{
+				return;
+			}
+			if (attached)
+			{
+				auto& change = changes.back();
+				change.newItems = std::span{ items }.subspan(change.index, change.count);
+			}
+
+			collectionChangedEvent.Invoke(proxy, std::span<const ChangeType>{ changes });
+
+			// Hand the buffer back so the next change doesn't allocate it again
+			changes.clear();
+			std::scoped_lock lock{ notifyMutex };
+			if (pendingChanges.empty())
+			{
+				pendingChanges.swap(changes);
+			}
+		}
+	};
+
+	template <typename T>
+	using ObservableCollectionNM = ObservableCollection<T, Mutex::NullMutex>;
+}
@@ -0,0 +1,84 @@
+export module PGUI.DataBinding.PropagationScheduler;
+
+import std;
+
+export namespace PGUI::DataBinding
+{
+	// A value computed from other values, implemented by DerivedProperty and LazyDerivedProperty.
+	// Rank is one more than the highest rank of its dependencies, plain properties have rank 0.
+	class PropagationNode
+	{
+		friend class PropagationScheduler;
+
+		public:
+		virtual ~PropagationNode() noexcept;
+
+		PropagationNode(const PropagationNode&) = delete;
+		PropagationNode(PropagationNode&&) = delete;
+		auto operator=(const PropagationNode&) -> PropagationNode& = delete;
+		auto operator=(PropagationNode&&) -> PropagationNode& = delete;
+
+		[[nodiscard]] auto GetRank() const noexcept { return rank; }
+
+		auto AddDependent(PropagationNode& dependent) noexcept -> void;
+		auto RemoveDependent(PropagationNode& dependent) noexcept -> void;
+
+		protected:
+		explicit PropagationNode(std::size_t rank) noexcept;
+
+		[[nodiscard]] auto HasDependents() const noexcept -> bool;
+
+		// Recomputes the value without notifying anyone, returns true if it changed
+		virtual auto RecomputeValue() noexcept -> bool = 0;
+		virtual auto PublishValue() noexcept -> void = 0;
+
+		private:
+		std::size_t rank;
+		mutable std::mutex dependentsMutex;
+		std::vector<PropagationNode*> dependents;
+	};
+
+	template <typename Dependency>
+	[[nodiscard]] auto PropagationRank([[maybe_unused]] const Dependency& dependency) noexcept -> std::size_t
+	{
+		if constexpr (std::derived_from<Dependency, PropagationNode>)
+		{
+			return dependency.GetRank();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	// Per thread scheduler for change waves.
+	// Dirty nodes are recomputed once each in rank order, observers are notified only after
+	// the whole wave settled so they never see a half updated graph.
+	class PropagationScheduler
+	{
+		friend class PropagationScope;
+
+		public:
+		static auto MarkDirty(PropagationNode& node) noexcept -> void;
+		static auto MarkDependentsDirty(const PropagationNode& node) noexcept -> void;
+		static auto Cancel(const PropagationNode& node) noexcept -> void;
+
+		private:
+		static auto Enqueue(PropagationNode& node) noexcept -> void;
+		static auto Drain() noexcept -> void;
+	};
+
+	// Defers draining the scheduler until the outermost scope on this thread ends,
+	// Property opens one around every change notification
+	class PropagationScope
+	{
+		public:
+		PropagationScope() noexcept;
+		~PropagationScope() noexcept;
+
+		PropagationScope(const PropagationScope&) = delete;
+		PropagationScope(PropagationScope&&) = delete;
+		auto operator=(const PropagationScope&) -> PropagationScope& = delete;
+		auto operator=(PropagationScope&&) -> PropagationScope& = delete;
+	};
+}
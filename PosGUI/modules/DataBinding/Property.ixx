@@ -6,6 +6,8 @@ import PGUI.ErrorHandling;
 import PGUI.Utils;
 import PGUI.Event;
 import PGUI.Mutex;
+import PGUI.DataBinding.PropagationScheduler;
+import PGUI.DataBinding.PropertyTransaction;
 
 export namespace PGUI::DataBinding
 {
@@ -35,7 +37,10 @@ export namespace PGUI::DataBinding
 		{
 		}
 
-		virtual ~Property() = default;
+		virtual ~Property()
+		{
+			PropertyTransaction::Cancel(this);
+		}
 
 		virtual auto operator=(const Property& other) noexcept(std::is_nothrow_copy_assignable_v<T>) -> Property&
 		{
@@ -62,34 +67,18 @@ export namespace PGUI::DataBinding
 
 		virtual auto Set(const T& newValue) noexcept(std::is_nothrow_copy_assignable_v<T>) -> void
 		{
+			if (SetValue(newValue))
 			{
-				std::scoped_lock lock{ mutex };
-				if constexpr (std::equality_comparable<T>)
-				{
-					if (value == newValue)
-					{
-						return;
-					}
-				}
-				value = newValue;
+				RequestNotify();
 			}
-			valueChangedEvent.Invoke(Get());
 		}
 
 		virtual auto Set(T&& newValue) noexcept(std::is_nothrow_move_assignable_v<T>) -> void
 		{
+			if (SetValue(MoveChecked(newValue)))
 			{
-				std::scoped_lock lock{ mutex };
-				if constexpr (std::equality_comparable<T>)
-				{
-					if (value == newValue)
-					{
-						return;
-					}
-				}
-				value = MoveChecked(newValue);
+				RequestNotify();
 			}
-			valueChangedEvent.Invoke(Get());
 		}
 
 		auto MoveValue() noexcept(std::is_nothrow_move_constructible_v<T>) -> T
@@ -98,6 +87,12 @@ export namespace PGUI::DataBinding
 			return MoveChecked(value);
 		}
 
+		// Incremented on every change, lets lazy dependents tell whether their inputs changed
+		[[nodiscard]] auto GetVersion() const noexcept
+		{
+			return version.load(std::memory_order_acquire);
+		}
+
 		auto AddObserver(CallbackType<const AccessorProxyType&> auto callback) noexcept
 		{
 			return valueChangedEvent.AddCallback(callback);
@@ -140,9 +135,60 @@ export namespace PGUI::DataBinding
 			return AccessorProxyType{ value, mutex };
 		}
 
+		protected:
+		// Stores the value without notifying, returns true if it changed
+		auto SetValue(const T& newValue) noexcept(std::is_nothrow_copy_assignable_v<T>) -> bool
+		{
+			std::scoped_lock lock{ mutex };
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (value == newValue)
+				{
+					return false;
+				}
+			}
+			value = newValue;
+			version.fetch_add(1, std::memory_order_release);
+
+			return true;
+		}
+
+		auto SetValue(T&& newValue) noexcept(std::is_nothrow_move_assignable_v<T>) -> bool
+		{
+			std::scoped_lock lock{ mutex };
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (value == newValue)
+				{
+					return false;
+				}
+			}
+			value = MoveChecked(newValue);
+			version.fetch_add(1, std::memory_order_release);
+
+			return true;
+		}
+
+		virtual auto NotifyObservers() noexcept -> void
+		{
+			// Derived properties that depend on this are recomputed once the outermost notification ends
+			PropagationScope scope;
+			valueChangedEvent.Invoke(Get());
+		}
+
+		// Notifies right away, or once the PropertyTransaction active on this thread commits
+		auto RequestNotify() noexcept -> void
+		{
+			if (!PropertyTransaction::Defer(this, [this] { NotifyObservers(); }))
+			{
+				NotifyObservers();
+			}
+		}
+
 		private:
 		T value;
 		mutable Mutex mutex;
+		std::atomic<std::uint64_t> version = 0;
 		EventType valueChangedEvent{ };
 	};
 
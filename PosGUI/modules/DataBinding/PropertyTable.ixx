@@ -0,0 +1,338 @@
+export module PGUI.DataBinding.PropertyTable;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.Event;
+import PGUI.DataBinding.PropagationScheduler;
+import PGUI.DataBinding.PropertyTransaction;
+
+export namespace PGUI::DataBinding
+{
+	struct PropertyTableMemoryUsage
+	{
+		std::size_t entryCount = 0;
+		std::size_t valueBytes = 0;
+		std::size_t observerBytes = 0;
+		std::size_t bookkeepingBytes = 0;
+
+		[[nodiscard]] auto TotalBytes() const noexcept
+		{
+			return valueBytes + observerBytes + bookkeepingBytes;
+		}
+		[[nodiscard]] auto BytesPerEntry() const noexcept
+		{
+			return entryCount == 0 ? 0.0 : static_cast<double>(TotalBytes()) / static_cast<double>(entryCount);
+		}
+
+		auto operator+=(const PropertyTableMemoryUsage& other) noexcept -> PropertyTableMemoryUsage&
+		{
+			entryCount = std::max(entryCount, other.entryCount);
+			valueBytes += other.valueBytes;
+			observerBytes += other.observerBytes;
+			bookkeepingBytes += other.bookkeepingBytes;
+
+			return *this;
+		}
+	};
+
+	// Index addressed storage for the values of many properties of the same kind.
+	// Values are kept in one contiguous array and observer lists only exist for entries that
+	// have observers, so an unobserved property costs just its value.
+	// Not synchronized, meant for state owned by a single (UI) thread.
+	// Debug builds terminate if entries are allocated or released on any other thread.
+	template <typename T>
+	class PropertyTable
+	{
+		public:
+		using Index = std::uint32_t;
+		using EventType = EventNM<const T&>;
+
+		PropertyTable() noexcept = default;
+
+		PropertyTable(const PropertyTable&) = delete;
+		PropertyTable(PropertyTable&&) = delete;
+		auto operator=(const PropertyTable&) -> PropertyTable& = delete;
+		auto operator=(PropertyTable&&) -> PropertyTable& = delete;
+
+		~PropertyTable() noexcept = default;
+
+		[[nodiscard]] auto Allocate(const T& initialValue) noexcept -> Index
+		{
+			CheckOwnerThread();
+			liveCount++;
+
+			if (!freeIndices.empty())
+			{
+				const auto index = freeIndices.back();
+				freeIndices.pop_back();
+				values[index] = initialValue;
+
+				return index;
+			}
+
+			values.push_back(initialValue);
+			return static_cast<Index>(values.size() - 1);
+		}
+
+		auto Release(const Index index) noexcept -> void
+		{
+			CheckOwnerThread();
+			observers.erase(index);
+			freeIndices.push_back(index);
+			liveCount--;
+		}
+
+		[[nodiscard]] auto GetValue(const Index index) const noexcept -> T
+		{
+			return values[index];
+		}
+
+		// Stores the value without notifying, returns true if it changed
+		auto SetValue(const Index index, const T& newValue) noexcept -> bool
+		{
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (values[index] == newValue)
+				{
+					return false;
+				}
+			}
+			values[index] = newValue;
+			version++;
+
+			return true;
+		}
+
+		// Shared by every entry, advances whenever any of them changes
+		[[nodiscard]] auto GetVersion() const noexcept { return version; }
+
+		auto Notify(const Index index) noexcept -> void
+		{
+			if (const auto iter = observers.find(index);
+				iter != observers.end())
+			{
+				// Observers may release or clear the entry, which erases it from the map
+				const auto event = iter->second;
+
+				PropagationScope scope;
+				event->Invoke(GetValue(index));
+			}
+		}
+
+		auto AddObserver(const Index index, CallbackType<const T&> auto callback) noexcept
+		{
+			auto& event = observers[index];
+			if (!event)
+			{
+				event = std::make_shared<EventType>();
+			}
+
+			return event->AddCallback(callback);
+		}
+
+		auto RemoveObserver(const Index index, const CallbackId id) noexcept -> void
+		{
+			if (const auto iter = observers.find(index);
+				iter != observers.end())
+			{
+				iter->second->RemoveCallback(id);
+			}
+		}
+
+		auto ClearObservers(const Index index) noexcept -> void
+		{
+			observers.erase(index);
+		}
+
+		[[nodiscard]] auto GetSize() const noexcept { return liveCount; }
+		[[nodiscard]] auto GetCapacity() const noexcept { return values.capacity(); }
+
+		// Approximate, node and bucket overhead of the observer map is estimated
+		[[nodiscard]] auto GetMemoryUsage() const noexcept -> PropertyTableMemoryUsage
+		{
+			PropertyTableMemoryUsage usage{ .entryCount = liveCount };
+
+			if constexpr (std::same_as<T, bool>)
+			{
+				constexpr auto bitsPerByte = std::size_t{ std::numeric_limits<unsigned char>::digits };
+				usage.valueBytes = (values.capacity() + bitsPerByte - 1) / bitsPerByte;
+			}
+			else
+			{
+				usage.valueBytes = values.capacity() * sizeof(T);
+			}
+
+			constexpr auto nodeSize = sizeof(typename decltype(observers)::value_type) + 2 * sizeof(void*);
+			constexpr auto eventSize = sizeof(EventType) + 2 * sizeof(long);
+			usage.observerBytes = observers.size() * (nodeSize + eventSize) + observers.bucket_count() * sizeof(void*);
+			usage.bookkeepingBytes = freeIndices.capacity() * sizeof(Index);
+
+			return usage;
+		}
+
+		private:
+		std::vector<T> values;
+		std::vector<Index> freeIndices;
+		std::unordered_map<Index, std::shared_ptr<EventType>> observers;
+		std::size_t liveCount = 0;
+		std::uint64_t version = 0;
+		std::thread::id ownerThread = std::this_thread::get_id();
+
+		auto CheckOwnerThread() const noexcept -> void
+		{
+			if constexpr (IsDebugBuild)
+			{
+				if (std::this_thread::get_id() != ownerThread)
+				{
+					std::terminate();
+				}
+			}
+		}
+	};
+
+	// Property whose value lives in a PropertyTable, the handle itself is only a table pointer and an index.
+	// Offers the same surface as Property except that Get() returns the value by copy.
+	template <typename T>
+	class StoredProperty
+	{
+		public:
+		using ValueType = T;
+		using TableType = PropertyTable<T>;
+
+		explicit StoredProperty(TableType& table, const T& initialValue = T{ }) noexcept :
+			table{ &table }, index{ table.Allocate(initialValue) }
+		{
+		}
+
+		StoredProperty(const StoredProperty&) = delete;
+		auto operator=(const StoredProperty&) -> StoredProperty& = delete;
+
+		StoredProperty(StoredProperty&& other) noexcept :
+			table{ std::exchange(other.table, nullptr) }, index{ other.index }
+		{
+		}
+		auto operator=(StoredProperty&& other) noexcept -> StoredProperty&
+		{
+			if (this != &other)
+			{
+				Release();
+				table = std::exchange(other.table, nullptr);
+				index = other.index;
+			}
+			return *this;
+		}
+
+		~StoredProperty() noexcept
+		{
+			Release();
+		}
+
+		[[nodiscard]] auto Get() const noexcept -> T
+		{
+			return table->GetValue(index);
+		}
+
+		auto Set(const T& newValue) noexcept -> void
+		{
+			if (!table->SetValue(index, newValue))
+			{
+				return;
+			}
+
+			// Captures the slot rather than this, so a pending notification survives moving the handle
+			if (!PropertyTransaction::Defer(this, [table = table, index = index] { table->Notify(index); }))
+			{
+				table->Notify(index);
+			}
+		}
+
+		auto AddObserver(CallbackType<const T&> auto callback) noexcept
+		{
+			return table->AddObserver(index, callback);
+		}
+
+		auto RemoveObserver(const CallbackId id) noexcept -> void
+		{
+			table->RemoveObserver(index, id);
+		}
+
+		auto ClearObservers() noexcept -> void
+		{
+			table->ClearObservers(index);
+		}
+
+		auto operator=(const T& val) noexcept -> StoredProperty&
+		{
+			Set(val);
+			return *this;
+		}
+
+		[[nodiscard]] auto operator*() const noexcept -> T
+		{
+			return Get();
+		}
+
+		// Table wide, so it may advance without this value changing
+		[[nodiscard]] auto GetVersion() const noexcept
+		{
+			return table->GetVersion();
+		}
+
+		[[nodiscard]] auto GetTable() const noexcept { return table; }
+		[[nodiscard]] auto GetIndex() const noexcept { return index; }
+
+		private:
+		TableType* table;
+		TableType::Index index;
+
+		auto Release() noexcept -> void
+		{
+			if (table != nullptr)
+			{
+				PropertyTransaction::Cancel(this);
+				table->Release(index);
+				table = nullptr;
+			}
+		}
+	};
+
+	// Lets others read and observe a StoredProperty without being able to set it,
+	// for values whose owner has to react to every change itself
+	template <typename T>
+	class StoredPropertyView
+	{
+		public:
+		using ValueType = T;
+		using TableType = PropertyTable<T>;
+
+		explicit StoredPropertyView(const StoredProperty<T>& property) noexcept :
+			table{ property.GetTable() }, index{ property.GetIndex() }
+		{
+		}
+
+		[[nodiscard]] auto Get() const noexcept -> T
+		{
+			return table->GetValue(index);
+		}
+
+		auto AddObserver(CallbackType<const T&> auto callback) const noexcept
+		{
+			return table->AddObserver(index, callback);
+		}
+
+		auto RemoveObserver(const CallbackId id) const noexcept -> void
+		{
+			table->RemoveObserver(index, id);
+		}
+
+		[[nodiscard]] auto operator*() const noexcept -> T
+		{
+			return Get();
+		}
+
+		private:
+		TableType* table;
+		TableType::Index index;
+	};
+}
@@ -0,0 +1,38 @@
+export module PGUI.DataBinding.PropertyTransaction;
+
+import std;
+
+export namespace PGUI::DataBinding
+{
+	// Defers property change notifications made on this thread until the outermost transaction commits.
+	// Each property notifies once with its final value, in the order it was first changed,
+	// and derived properties are recomputed once after all of them.
+	// Properties changed from other threads still notify immediately.
+	class PropertyTransaction
+	{
+		public:
+		using Notifier = std::move_only_function<void()>;
+
+		PropertyTransaction() noexcept;
+		~PropertyTransaction() noexcept;
+
+		PropertyTransaction(const PropertyTransaction&) = delete;
+		PropertyTransaction(PropertyTransaction&&) = delete;
+		auto operator=(const PropertyTransaction&) -> PropertyTransaction& = delete;
+		auto operator=(PropertyTransaction&&) -> PropertyTransaction& = delete;
+
+		// Only the outermost transaction flushes, committing a nested one just ends it early
+		auto Commit() noexcept -> void;
+
+		[[nodiscard]] static auto IsActive() noexcept -> bool;
+
+		// Returns false if no transaction is active, the caller should notify right away then
+		[[nodiscard]] static auto Defer(const void* key, Notifier&& notifier) noexcept -> bool;
+		static auto Cancel(const void* key) noexcept -> void;
+
+		private:
+		bool committed = false;
+
+		static auto Flush() noexcept -> void;
+	};
+}
@@ -0,0 +1,352 @@
+export module PGUI.DataBinding.SnapshotProperty;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.Event;
+import PGUI.DataBinding.PropagationScheduler;
+import PGUI.DataBinding.PropertyTransaction;
+
+export namespace PGUI::DataBinding
+{
+	// Property for trivially copyable values guarded by a sequence lock.
+	// Get() copies the value out and retries if a writer raced it, readers never block writers
+	// and never hold anything after they return. Writers are serialized among themselves.
+	template <typename T>
+		requires std::is_trivially_copyable_v<T> && std::default_initializable<T>
+	class SeqLockProperty
+	{
+		using Word = std::uintptr_t;
+		static constexpr auto WordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+		using Words = std::array<Word, WordCount>;
+
+		public:
+		using ValueType = T;
+
+		using EventType = EventSnapshot<const T&>;
+
+		SeqLockProperty() noexcept :
+			SeqLockProperty{ T{ } }
+		{
+		}
+
+		explicit(false) SeqLockProperty(const T& value) noexcept
+		{
+			Store(value);
+		}
+
+		SeqLockProperty(const SeqLockProperty&) = delete;
+		SeqLockProperty(SeqLockProperty&&) = delete;
+		auto operator=(const SeqLockProperty&) -> SeqLockProperty& = delete;
+		auto operator=(SeqLockProperty&&) -> SeqLockProperty& = delete;
+
+		~SeqLockProperty() noexcept
+		{
+			PropertyTransaction::Cancel(this);
+		}
+
+		[[nodiscard]] auto Get() const noexcept -> T
+		{
+			Words words{ };
+			while (true)
+			{
+				const auto before = sequence.load(std::memory_order_acquire);
+				if (before % 2 != 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				for (std::size_t i = 0; i < WordCount; i++)
+				{
+					words[i] = storage[i].load(std::memory_order_relaxed);
+				}
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				if (sequence.load(std::memory_order_relaxed) == before)
+				{
+					break;
+				}
+			}
+
+			T value;
+			std::memcpy(std::addressof(value), words.data(), sizeof(T));
+			return value;
+		}
+
+		auto Set(const T& newValue) noexcept -> void
+		{
+			{
+				std::scoped_lock lock{ writerMutex };
+				if constexpr (std::equality_comparable<T>)
+				{
+					if (Get() == newValue)
+					{
+						return;
+					}
+				}
+				Store(newValue);
+			}
+			RequestNotify();
+		}
+
+		// The sequence advances by two for every write so it doubles as a version
+		[[nodiscard]] auto GetVersion() const noexcept
+		{
+			return sequence.load(std::memory_order_acquire) / 2;
+		}
+
+		auto AddObserver(CallbackType<const T&> auto callback) noexcept
+		{
+			return valueChangedEvent.AddCallback(callback);
+		}
+
+		auto RemoveObserver(CallbackId id) noexcept -> void
+		{
+			valueChangedEvent.RemoveCallback(id);
+		}
+
+		auto ClearObservers() noexcept -> void
+		{
+			valueChangedEvent.ClearCallbacks();
+		}
+
+		auto operator=(const T& val) noexcept -> SeqLockProperty&
+		{
+			Set(val);
+			return *this;
+		}
+
+		[[nodiscard]] auto operator*() const noexcept -> T
+		{
+			return Get();
+		}
+
+		private:
+		std::atomic<std::uint64_t> sequence = 0;
+		std::array<std::atomic<Word>, WordCount> storage{ };
+		std::mutex writerMutex;
+		EventType valueChangedEvent{ };
+
+		auto Store(const T& value) noexcept -> void
+		{
+			Words words{ };
+			std::memcpy(words.data(), std::addressof(value), sizeof(T));
+
+			const auto current = sequence.load(std::memory_order_relaxed);
+			sequence.store(current + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			for (std::size_t i = 0; i < WordCount; i++)
+			{
+				storage[i].store(words[i], std::memory_order_relaxed);
+			}
+
+			sequence.store(current + 2, std::memory_order_release);
+		}
+
+		auto RequestNotify() noexcept -> void
+		{
+			if (!PropertyTransaction::Defer(this, [this] { NotifyObservers(); }))
+			{
+				NotifyObservers();
+			}
+		}
+
+		auto NotifyObservers() noexcept -> void
+		{
+			PropagationScope scope;
+			valueChangedEvent.Invoke(Get());
+		}
+	};
+
+	// Keeps a reader's snapshot of an RcuProperty alive, reads like AccessorProxy but holds no lock
+	template <typename T>
+	class SnapshotProxy
+	{
+		public:
+		explicit SnapshotProxy(std::shared_ptr<const T> snapshot) noexcept :
+			snapshot{ MoveChecked(snapshot) }
+		{
+		}
+
+		[[nodiscard]] auto operator->() const noexcept -> const T*
+		{
+			return snapshot.get();
+		}
+		[[nodiscard]] auto operator*() const noexcept -> const T&
+		{
+			return *snapshot;
+		}
+
+		[[nodiscard]] explicit(false) operator const T&() const noexcept
+		{
+			return *snapshot;
+		}
+
+		[[nodiscard]] auto Get() const noexcept -> const T&
+		{
+			return *snapshot;
+		}
+
+		[[nodiscard]] auto Share() const noexcept -> std::shared_ptr<const T>
+		{
+			return snapshot;
+		}
+
+		private:
+		std::shared_ptr<const T> snapshot;
+	};
+
+	// Property holding its value in an immutable shared block that Set replaces.
+	// Readers take a reference counted snapshot without locking, a snapshot kept for long
+	// only keeps the old value alive and never delays writers.
+	template <typename T>
+	class RcuProperty
+	{
+		public:
+		using ValueType = T;
+
+		using SnapshotProxyType = SnapshotProxy<T>;
+
+		using EventType = EventSnapshot<const SnapshotProxyType&>;
+
+		RcuProperty() noexcept(std::is_nothrow_default_constructible_v<T>) :
+			value{ std::make_shared<const T>() }
+		{
+		}
+
+		explicit(false) RcuProperty(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) :
+			value{ std::make_shared<const T>(value) }
+		{
+		}
+
+		RcuProperty(const RcuProperty&) = delete;
+		RcuProperty(RcuProperty&&) = delete;
+		auto operator=(const RcuProperty&) -> RcuProperty& = delete;
+		auto operator=(RcuProperty&&) -> RcuProperty& = delete;
+
+		~RcuProperty() noexcept
+		{
+			PropertyTransaction::Cancel(this);
+		}
+
+		[[nodiscard]] auto Get() const noexcept
+		{
+			return SnapshotProxyType{ value.load(std::memory_order_acquire) };
+		}
+
+		auto Set(const T& newValue) noexcept(std::is_nothrow_copy_constructible_v<T>) -> void
+		{
+			Publish(std::make_shared<const T>(newValue));
+		}
+
+		auto Set(T&& newValue) noexcept(std::is_nothrow_move_constructible_v<T>) -> void
+		{
+			Publish(std::make_shared<const T>(MoveChecked(newValue)));
+		}
+
+		// Applies func to a copy of the current value and publishes the result
+		template <std::invocable<T&> Func>
+		auto Update(Func&& func) noexcept -> void
+		{
+			bool changed;
+			{
+				std::scoped_lock lock{ writerMutex };
+				auto next = std::make_shared<T>(*value.load(std::memory_order_acquire));
+				std::invoke(std::forward<Func>(func), *next);
+				changed = Store(std::shared_ptr<const T>{ MoveChecked(next) });
+			}
+			if (changed)
+			{
+				RequestNotify();
+			}
+		}
+
+		[[nodiscard]] auto GetVersion() const noexcept
+		{
+			return version.load(std::memory_order_acquire);
+		}
+
+		auto AddObserver(CallbackType<const SnapshotProxyType&> auto callback) noexcept
+		{
+			return valueChangedEvent.AddCallback(callback);
+		}
+
+		auto RemoveObserver(CallbackId id) noexcept -> void
+		{
+			valueChangedEvent.RemoveCallback(id);
+		}
+
+		auto ClearObservers() noexcept -> void
+		{
+			valueChangedEvent.ClearCallbacks();
+		}
+
+		auto operator=(const T& val) noexcept(std::is_nothrow_copy_constructible_v<T>) -> RcuProperty&
+		{
+			Set(val);
+			return *this;
+		}
+
+		auto operator=(T&& val) noexcept(std::is_nothrow_move_constructible_v<T>) -> RcuProperty&
+		{
+			Set(MoveChecked(val));
+			return *this;
+		}
+
+		[[nodiscard]] auto operator*() const noexcept
+		{
+			return Get();
+		}
+
+		private:
+		std::atomic<std::shared_ptr<const T>> value;
+		std::atomic<std::uint64_t> version = 0;
+		std::mutex writerMutex;
+		EventType valueChangedEvent{ };
+
+		auto Publish(std::shared_ptr<const T> next) noexcept -> void
+		{
+			bool changed;
+			{
+				std::scoped_lock lock{ writerMutex };
+				changed = Store(MoveChecked(next));
+			}
+			if (changed)
+			{
+				RequestNotify();
+			}
+		}
+
+		// Expects writerMutex to be held, returns true if the value changed
+		auto Store(std::shared_ptr<const T> next) noexcept -> bool
+		{
+			if constexpr (std::equality_comparable<T>)
+			{
+				if (*value.load(std::memory_order_acquire) == *next)
+				{
+					return false;
+				}
+			}
+			value.store(MoveChecked(next), std::memory_order_release);
+			version.fetch_add(1, std::memory_order_release);
+
+			return true;
+		}
+
+		auto RequestNotify() noexcept -> void
+		{
+			if (!PropertyTransaction::Defer(this, [this] { NotifyObservers(); }))
+			{
+				NotifyObservers();
+			}
+		}
+
+		auto NotifyObservers() noexcept -> void
+		{
+			PropagationScope scope;
+			valueChangedEvent.Invoke(Get());
+		}
+	};
+}
@@ -0,0 +1,237 @@
+export module PGUI.Delegate;
+
+import std;
+import PGUI.Utils;
+
+export namespace PGUI
+{
+	constexpr auto DefaultDelegateBufferSize = 4 * sizeof(void*);
+
+	enum class DelegateOperation
+	{
+		Move,
+		Clone,
+		Destroy
+	};
+
+	template <std::size_t BufferSize, typename... Args>
+	class InlineDelegate
+	{
+		// Returns false if the callback cancelled the dispatch, non cancelling callbacks always return true
+		using Invoker = bool (*)(void*, Args...);
+		// nullptr means the stored callable is trivially copyable and can be memcpy'd
+		using Manager = bool (*)(DelegateOperation, void* source, void* destination) noexcept;
+
+		template <typename F>
+		static constexpr auto IsStoredInline =
+			sizeof(F) <= BufferSize &&
+			alignof(F) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<F>;
+
+		template <typename F>
+		static constexpr auto IsTrivial =
+			IsStoredInline<F> &&
+			std::is_trivially_copyable_v<F> &&
+			std::is_trivially_destructible_v<F>;
+
+		public:
+		InlineDelegate() noexcept = default;
+
+		template <typename Callable>
+			requires NotSameAs<std::remove_cvref_t<Callable>, InlineDelegate> &&
+			         std::invocable<std::decay_t<Callable>&, Args...>
+		explicit(false) InlineDelegate(Callable&& callable) noexcept
+		{
+			using F = std::decay_t<Callable>;
+
+			if constexpr (IsStoredInline<F>)
+			{
+				std::construct_at(reinterpret_cast<F*>(storage), std::forward<Callable>(callable));
+			}
+			else
+			{
+				*reinterpret_cast<F**>(storage) = new F{ std::forward<Callable>(callable) };
+			}
+
+			invoker = &Invoke<F>;
+			if constexpr (!IsTrivial<F>)
+			{
+				manager = &Manage<F>;
+			}
+		}
+
+		InlineDelegate(InlineDelegate&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+
+		auto operator=(InlineDelegate&& other) noexcept -> InlineDelegate&
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		InlineDelegate(const InlineDelegate&) = delete;
+		auto operator=(const InlineDelegate&) -> InlineDelegate& = delete;
+
+		~InlineDelegate() noexcept
+		{
+			Reset();
+		}
+
+		[[nodiscard]] auto Clone() const noexcept -> InlineDelegate
+		{
+			InlineDelegate clone;
+			if (invoker == nullptr)
+			{
+				return clone;
+			}
+
+			if (manager == nullptr)
+			{
+				std::memcpy(clone.storage, storage, BufferSize);
+			}
+			else if (!manager(DelegateOperation::Clone, storage, clone.storage))
+			{
+				return clone;
+			}
+
+			clone.invoker = invoker;
+			clone.manager = manager;
+
+			return clone;
+		}
+
+		auto Reset() noexcept -> void
+		{
+			if (manager != nullptr)
+			{
+				manager(DelegateOperation::Destroy, storage, nullptr);
+			}
+			invoker = nullptr;
+			manager = nullptr;
+		}
+
+		auto operator()(Args... args) const -> bool
+		{
+			return invoker(storage, args...);
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept
+		{
+			return invoker != nullptr;
+		}
+
+		private:
+		alignas(std::max_align_t) mutable std::byte storage[BufferSize]{ };
+		Invoker invoker = nullptr;
+		Manager manager = nullptr;
+
+		template <typename F>
+		[[nodiscard]] static auto Target(void* buffer) noexcept -> F&
+		{
+			if constexpr (IsStoredInline<F>)
+			{
+				return *std::launder(reinterpret_cast<F*>(buffer));
+			}
+			else
+			{
+				return **reinterpret_cast<F**>(buffer);
+			}
+		}
+
+		template <typename F>
+		static auto Invoke(void* buffer, Args... args) -> bool
+		{
+			if constexpr (std::is_same_v<bool, std::invoke_result_t<F&, Args...>>)
+			{
+				return std::invoke(Target<F>(buffer), args...);
+			}
+			else
+			{
+				std::invoke(Target<F>(buffer), args...);
+				return true;
+			}
+		}
+
+		template <typename F>
+		static auto Manage(const DelegateOperation operation, void* source, void* destination) noexcept -> bool
+		{
+			switch (operation)
+			{
+				case DelegateOperation::Move:
+				{
+					if constexpr (IsStoredInline<F>)
+					{
+						auto& target = Target<F>(source);
+						std::construct_at(reinterpret_cast<F*>(destination), std::move(target));
+						std::destroy_at(std::addressof(target));
+					}
+					else
+					{
+						*reinterpret_cast<F**>(destination) = std::exchange(*reinterpret_cast<F**>(source), nullptr);
+					}
+					return true;
+				}
+				case DelegateOperation::Clone:
+				{
+					if constexpr (!std::is_copy_constructible_v<F>)
+					{
+						return false;
+					}
+					else if constexpr (IsStoredInline<F>)
+					{
+						std::construct_at(reinterpret_cast<F*>(destination), Target<F>(source));
+						return true;
+					}
+					else
+					{
+						*reinterpret_cast<F**>(destination) = new F{ Target<F>(source) };
+						return true;
+					}
+				}
+				case DelegateOperation::Destroy:
+				{
+					if constexpr (IsStoredInline<F>)
+					{
+						std::destroy_at(std::addressof(Target<F>(source)));
+					}
+					else
+					{
+						delete *reinterpret_cast<F**>(source);
+					}
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		auto MoveFrom(InlineDelegate& other) noexcept -> void
+		{
+			if (other.invoker == nullptr)
+			{
+				return;
+			}
+
+			if (other.manager == nullptr)
+			{
+				std::memcpy(storage, other.storage, BufferSize);
+			}
+			else
+			{
+				other.manager(DelegateOperation::Move, other.storage, storage);
+			}
+
+			invoker = std::exchange(other.invoker, nullptr);
+			manager = std::exchange(other.manager, nullptr);
+		}
+	};
+
+	template <typename... Args>
+	using Delegate = InlineDelegate<DefaultDelegateBufferSize, Args...>;
+}
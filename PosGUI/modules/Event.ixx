@@ -1,11 +1,10 @@
-module;
-#include <winrt/base.h>
-
 export module PGUI.Event;
 
 import std;
 import PGUI.Mutex;
 import PGUI.Utils;
+import PGUI.Delegate;
+import PGUI.EventDispatcher;
 
 export namespace PGUI
 {
@@ -21,118 +20,394 @@ export namespace PGUI
 		std::invocable<T, Args...> &&
 		(std::is_same_v<bool, std::invoke_result_t<T, Args...>> ||
 			std::is_same_v<void, std::invoke_result_t<T, Args...>>);
-	using CallbackId = std::size_t;
+	using CallbackId = std::uint64_t;
 
-	template <typename MutexType, typename... Args>
-	class EventT
+	// Selects the copy-on-write callback storage for EventT.
+	// Callbacks are published as an immutable block, Invoke iterates the current block
+	// without taking any lock and MutexType only serializes AddCallback/RemoveCallback.
+	template <typename MutexType>
+	struct SnapshotCallbacks
 	{
-		public:
-		using CancellingCallback = std::function<bool(Args...)>;
-		using NonCancellingCallback = std::function<void(Args...)>;
-		using Callback = std::variant<NonCancellingCallback, CancellingCallback>;
+		using WriterMutexType = MutexType;
+	};
 
-		private:
-		struct CallbackData
+	namespace Detail
+	{
+		// Callbacks grouped into one bucket per CallbackPriority, addressed through a slot map.
+		// CallbackId packs the slot index with a generation so stale ids never hit a reused slot.
+		// Removal leaves a tombstone to keep insertion order, buckets are compacted once
+		// tombstones make up half of them.
+		template <typename Callback>
+		class CallbackTable
 		{
-			CallbackId id;
-			CallbackPriority priority;
-			Callback callback;
+			static constexpr auto PriorityCount = std::to_underlying(CallbackPriority::High) + 1;
+			static constexpr auto MinTombstonesToCompact = 16ULL;
+
+			struct Entry
+			{
+				CallbackId id;
+				Callback callback;
+
+				Entry(const CallbackId id, Callback&& callback) noexcept :
+					id{ id }, callback{ std::move(callback) }
+				{
+				}
+
+				// Copy-on-write storage duplicates the table, so copying clones the delegate
+				Entry(const Entry& other) noexcept :
+					id{ other.id }, callback{ other.callback.Clone() }
+				{
+				}
+				auto operator=(const Entry& other) noexcept -> Entry&
+				{
+					id = other.id;
+					callback = other.callback.Clone();
+
+					return *this;
+				}
+
+				Entry(Entry&&) noexcept = default;
+				auto operator=(Entry&&) noexcept -> Entry& = default;
+			};
+
+			struct Bucket
+			{
+				std::vector<Entry> entries;
+				std::size_t tombstones = 0;
+			};
+
+			struct Slot
+			{
+				std::uint32_t generation = 0;
+				std::uint32_t position = 0;
+				CallbackPriority priority = CallbackPriority::Normal;
+				bool occupied = false;
+			};
+
+			public:
+			auto Add(const CallbackPriority priority, Callback&& callback) noexcept -> CallbackId
+			{
+				std::uint32_t slotIndex;
+				if (!freeSlots.empty())
+				{
+					slotIndex = freeSlots.back();
+					freeSlots.pop_back();
+				}
+				else
+				{
+					slotIndex = static_cast<std::uint32_t>(slots.size());
+					slots.emplace_back();
+				}
+
+				auto& bucket = buckets[std::to_underlying(priority)];
+				auto& slot = slots[slotIndex];
+				slot.position = static_cast<std::uint32_t>(bucket.entries.size());
+				slot.priority = priority;
+				slot.occupied = true;
+
+				const auto id = MakeId(slot.generation, slotIndex);
+				bucket.entries.emplace_back(id, std::move(callback));
+				liveCount++;
+
+				return id;
+			}
+
+			auto Remove(const CallbackId id) noexcept -> bool
+			{
+				const auto slotIndex = SlotIndex(id);
+				if (slotIndex >= slots.size())
+				{
+					return false;
+				}
+
+				auto& slot = slots[slotIndex];
+				if (!slot.occupied || slot.generation != Generation(id))
+				{
+					return false;
+				}
+
+				auto& bucket = buckets[std::to_underlying(slot.priority)];
+				bucket.entries[slot.position].callback.Reset();
+				bucket.tombstones++;
+
+				slot.occupied = false;
+				slot.generation++;
+				freeSlots.push_back(slotIndex);
+				liveCount--;
 
-			auto operator<=>(const CallbackData& other) const noexcept -> auto
+				if (bucket.tombstones >= MinTombstonesToCompact &&
+					bucket.tombstones * 2 >= bucket.entries.size())
+				{
+					Compact(bucket);
+				}
+
+				return true;
+			}
+
+			auto Clear() noexcept -> void
+			{
+				for (auto& bucket : buckets)
+				{
+					for (const auto& entry : bucket.entries)
+					{
+						if (entry.callback)
+						{
+							auto& slot = slots[SlotIndex(entry.id)];
+							slot.occupied = false;
+							slot.generation++;
+							freeSlots.push_back(SlotIndex(entry.id));
+						}
+					}
+					bucket.entries.clear();
+					bucket.tombstones = 0;
+				}
+				liveCount = 0;
+			}
+
+			// Visits callbacks from the highest priority down in insertion order,
+			// stops as soon as func returns false
+			template <typename Func>
+			auto ForEach(Func&& func) const -> void
+			{
+				for (const auto& bucket : buckets | std::views::reverse)
+				{
+					for (const auto& entry : bucket.entries)
+					{
+						if (entry.callback && !std::invoke(func, entry.callback))
+						{
+							return;
+						}
+					}
+				}
+			}
+
+			[[nodiscard]] auto Size() const noexcept { return liveCount; }
+			[[nodiscard]] auto IsEmpty() const noexcept { return liveCount == 0; }
+
+			private:
+			std::array<Bucket, PriorityCount> buckets;
+			std::vector<Slot> slots;
+			std::vector<std::uint32_t> freeSlots;
+			std::size_t liveCount = 0;
+
+			[[nodiscard]] static constexpr auto MakeId(
+				const std::uint32_t generation, const std::uint32_t slotIndex) noexcept -> CallbackId
 			{
-				if (const auto cmp = std::to_underlying(priority) <=> std::to_underlying(other.priority);
-					cmp != 0)
+				return static_cast<CallbackId>(generation) << 32 | slotIndex;
+			}
+			[[nodiscard]] static constexpr auto SlotIndex(const CallbackId id) noexcept -> std::uint32_t
+			{
+				return static_cast<std::uint32_t>(id & 0xFFFFFFFF);
+			}
+			[[nodiscard]] static constexpr auto Generation(const CallbackId id) noexcept -> std::uint32_t
+			{
+				return static_cast<std::uint32_t>(id >> 32);
+			}
+
+			auto Compact(Bucket& bucket) noexcept -> void
+			{
+				std::size_t write = 0;
+				for (auto& entry : bucket.entries)
 				{
-					return cmp;
+					if (!entry.callback)
+					{
+						continue;
+					}
+
+					slots[SlotIndex(entry.id)].position = static_cast<std::uint32_t>(write);
+					if (&bucket.entries[write] != &entry)
+					{
+						bucket.entries[write] = std::move(entry);
+					}
+					write++;
 				}
-				
-				return id <=> other.id;
+
+				bucket.entries.erase(
+					std::next(bucket.entries.begin(), static_cast<std::ptrdiff_t>(write)),
+					bucket.entries.end());
+				bucket.tombstones = 0;
 			}
 		};
 
+		template <typename CallbackList, typename MutexType>
+		class LockedCallbackStorage
+		{
+			public:
+			template <typename Func>
+			auto Modify(Func&& func) noexcept -> void
+			{
+				std::scoped_lock lock{ mutex };
+				std::invoke(std::forward<Func>(func), callbacks);
+			}
+
+			template <typename Func>
+			auto Read(Func&& func) const noexcept -> void
+			{
+				std::scoped_lock lock{ mutex };
+				std::invoke(std::forward<Func>(func), std::as_const(callbacks));
+			}
+
+			[[nodiscard]] auto Capture() const noexcept -> std::shared_ptr<const CallbackList>
+			{
+				std::scoped_lock lock{ mutex };
+				if (callbacks.IsEmpty())
+				{
+					return nullptr;
+				}
+
+				return std::make_shared<const CallbackList>(callbacks);
+			}
+
+			auto Clear() noexcept -> void
+			{
+				std::scoped_lock lock{ mutex };
+				callbacks.Clear();
+			}
+
+			private:
+			mutable MutexType mutex;
+			CallbackList callbacks;
+		};
+
+		template <typename CallbackList, typename MutexType>
+		class SnapshotCallbackStorage
+		{
+			public:
+			template <typename Func>
+			auto Modify(Func&& func) noexcept -> void
+			{
+				std::scoped_lock lock{ writerMutex };
+
+				const auto current = block.load(std::memory_order_acquire);
+				auto next = current ? std::make_shared<CallbackList>(*current) : std::make_shared<CallbackList>();
+				std::invoke(std::forward<Func>(func), *next);
+
+				block.store(std::shared_ptr<const CallbackList>{ MoveChecked(next) }, std::memory_order_release);
+			}
+
+			template <typename Func>
+			auto Read(Func&& func) const noexcept -> void
+			{
+				if (const auto snapshot = block.load(std::memory_order_acquire);
+					snapshot)
+				{
+					std::invoke(std::forward<Func>(func), *snapshot);
+				}
+			}
+
+			// The published block is immutable so it can be shared without copying
+			[[nodiscard]] auto Capture() const noexcept -> std::shared_ptr<const CallbackList>
+			{
+				return block.load(std::memory_order_acquire);
+			}
+
+			// Goes through the table so the freed slots move to a new generation, dropping the block
+			// would hand out the old ids again
+			auto Clear() noexcept -> void
+			{
+				Modify([](CallbackList& callbacks) { callbacks.Clear(); });
+			}
+
+			private:
+			mutable MutexType writerMutex;
+			std::atomic<std::shared_ptr<const CallbackList>> block;
+		};
+
+		template <typename MutexType, typename CallbackList>
+		struct CallbackStorageSelector
+		{
+			using Type = LockedCallbackStorage<CallbackList, MutexType>;
+		};
+
+		template <typename MutexType, typename CallbackList>
+		struct CallbackStorageSelector<SnapshotCallbacks<MutexType>, CallbackList>
+		{
+			using Type = SnapshotCallbackStorage<CallbackList, MutexType>;
+		};
+	}
+
+	template <typename MutexType, typename... Args>
+	class EventT
+	{
+		public:
+		using Callback = Delegate<Args...>;
+
+		private:
+		using CallbackList = Detail::CallbackTable<Callback>;
+		using StorageType = Detail::CallbackStorageSelector<MutexType, CallbackList>::Type;
+
 		public:
 		template <CallbackType<Args...> Callable>
 		auto AddCallback(const Callable& callback, CallbackPriority priority = CallbackPriority::Normal) noexcept
 		{
-			using CallbackType = std::conditional_t<
-				std::is_same_v<bool, std::invoke_result_t<Callable, Args...>>,
-				CancellingCallback,
-				NonCancellingCallback>;
+			CallbackId id{ };
 
-			std::scoped_lock lock{ callbackMutex };
-
-			callbacks.emplace_back(nextCallbackId, priority, CallbackType{ callback });
-
-			std::ranges::stable_sort(callbacks, std::ranges::greater{ }, &CallbackData::priority);
+			callbackStorage.Modify([&id, priority, &callback](CallbackList& callbacks)
+			{
+				id = callbacks.Add(priority, Callback{ callback });
+			});
 
-			return nextCallbackId++;
+			return id;
 		}
 
-		auto RemoveCallback(CallbackId id) noexcept -> void
+		// Returns false if id didn't name a registered callback
+		auto RemoveCallback(CallbackId id) noexcept -> bool
 		{
-			std::scoped_lock lock{ callbackMutex };
-
-			std::erase_if(callbacks,
-				[id](const CallbackData& data) noexcept
+			auto removed = false;
+			callbackStorage.Modify([id, &removed](CallbackList& callbacks)
 			{
-				return data.id == id;
+				removed = callbacks.Remove(id);
 			});
+
+			return removed;
 		}
 
 		auto ClearCallbacks() noexcept -> void
 		{
-			std::scoped_lock lock{ callbackMutex };
-
-			callbacks.clear();
+			callbackStorage.Clear();
 		}
 
 		auto Invoke(Args... args) const noexcept -> void
 		{
-			std::scoped_lock lock{ callbackMutex };
-
-			for ([[maybe_unused]] const auto& [id, priority, callback] : callbacks)
+			callbackStorage.Read([&args...](const CallbackList& callbacks)
 			{
-				if (std::holds_alternative<CancellingCallback>(callback))
+				callbacks.ForEach([&args...](const Callback& callback)
 				{
-					auto& cancellingCallback = std::get<CancellingCallback>(callback);
-					if (!cancellingCallback(args...))
-					{
-						return;
-					}
-				}
-				else
-				{
-					auto& nonCancellingCallback = std::get<NonCancellingCallback>(callback);
-					nonCancellingCallback(args...);
-				}
-			}
-
+					return callback(args...);
+				});
+			});
 		}
 
+		// Queues a single batch that runs every callback in priority order on a dispatcher worker
 		auto InvokeAsync(Args... args) const noexcept -> void
 		{
-			std::scoped_lock lock{ callbackMutex };
-
-			for ([[maybe_unused]] const auto& [id, priority, callback] : callbacks)
+			if (auto batch = MakeBatch(args...);
+				batch)
 			{
-				[callbackCopy = callback, ...argsCopy = args] -> winrt::fire_and_forget
-				{
-					co_await winrt::resume_background();
+				GetDispatcher().Post(MoveChecked(batch));
+			}
+		}
 
-					if (std::holds_alternative<CancellingCallback>(callbackCopy))
-					{
-						auto& cancellingCallback = std::get<CancellingCallback>(callbackCopy);
-						Unused(cancellingCallback(argsCopy...));
-					}
-					else
-					{
-						auto& nonCancellingCallback = std::get<NonCancellingCallback>(callbackCopy);
-						nonCancellingCallback(argsCopy...);
-					}
-				}();
+		// Like InvokeAsync but if a batch of this event is still queued, it is replaced
+		// so only the latest argument set is delivered
+		auto InvokeAsyncCoalesced(Args... args) const noexcept -> void
+		{
+			if (auto batch = MakeBatch(args...);
+				batch)
+			{
+				GetDispatcher().PostCoalesced(dispatchKey, MoveChecked(batch));
 			}
 		}
 
+		auto SetDispatcher(EventDispatcher& newDispatcher) noexcept -> void
+		{
+			dispatcher = &newDispatcher;
+		}
+		[[nodiscard]] auto GetDispatcher() const noexcept -> EventDispatcher&
+		{
+			return dispatcher != nullptr ? *dispatcher : EventDispatcher::Default();
+		}
+
 		EventT() noexcept = default;
 
 		~EventT() noexcept = default;
@@ -152,9 +427,26 @@ export namespace PGUI
 		}
 
 		private:
-		CallbackId nextCallbackId = 0;
-		mutable MutexType callbackMutex;
-		std::vector<CallbackData> callbacks;
+		StorageType callbackStorage;
+		EventDispatcher* dispatcher = nullptr;
+		DispatchKey dispatchKey = EventDispatcher::NewDispatchKey();
+
+		[[nodiscard]] auto MakeBatch(Args... args) const noexcept -> EventDispatcher::Task
+		{
+			auto callbacks = callbackStorage.Capture();
+			if (!callbacks)
+			{
+				return nullptr;
+			}
+
+			return [callbacks = MoveChecked(callbacks), ...argsCopy = args] mutable
+			{
+				callbacks->ForEach([&argsCopy...](const Callback& callback)
+				{
+					return callback(argsCopy...);
+				});
+			};
+		}
 	};
 
 	// ReSharper disable IdentifierTypo
@@ -170,6 +462,8 @@ export namespace PGUI
 	using EventNM = EventT<Mutex::NullMutex, Args...>;
 	template <typename ...Args>
 	using EventKM = EventT<Mutex::KMutex, Args...>;
+	template <typename ...Args>
+	using EventSnapshot = EventT<SnapshotCallbacks<Mutex::CSMutex>, Args...>;
 
 	// ReSharper restore CppInconsistentNaming
 	// ReSharper restore IdentifierTypo
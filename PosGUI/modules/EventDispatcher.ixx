@@ -0,0 +1,100 @@
+export module PGUI.EventDispatcher;
+
+import std;
+
+export namespace PGUI
+{
+	using DispatchKey = std::uint64_t;
+	constexpr DispatchKey NoDispatchKey = 0;
+
+	// What happens to a task posted while the queue is full
+	enum class OverflowPolicy
+	{
+		// The new task is turned away
+		Reject,
+		// The oldest queued task is dropped to make room
+		DropOldest,
+		// Post waits up to the backpressure timeout for a worker to make room, then turns the task away.
+		// Posts from the dispatcher's own workers never wait, they could be the ones that have to make room
+		Wait
+	};
+
+	enum class PostResult
+	{
+		Queued,
+		// A queued task with the same key was replaced
+		Coalesced,
+		// Queued after the oldest task was dropped
+		DroppedOldest,
+		Rejected
+	};
+
+	// Bounded work queue served by a fixed set of worker threads.
+	// The queue never grows past its capacity, the overflow policy decides what gives way.
+	// Tasks never run on the posting thread.
+	class EventDispatcher
+	{
+		public:
+		using Task = std::move_only_function<void()>;
+
+		static constexpr std::size_t DefaultQueueCapacity = 1024;
+		static constexpr std::chrono::microseconds DefaultBackpressureTimeout{ 2000 };
+
+		explicit EventDispatcher(
+			std::size_t workerCount = DefaultWorkerCount(),
+			std::size_t queueCapacity = DefaultQueueCapacity,
+			OverflowPolicy overflowPolicy = OverflowPolicy::Reject,
+			std::chrono::microseconds backpressureTimeout = DefaultBackpressureTimeout) noexcept;
+
+		~EventDispatcher() noexcept;
+
+		EventDispatcher(const EventDispatcher&) = delete;
+		EventDispatcher(EventDispatcher&&) = delete;
+		auto operator=(const EventDispatcher&) -> EventDispatcher& = delete;
+		auto operator=(EventDispatcher&&) -> EventDispatcher& = delete;
+
+		[[nodiscard]] static auto Default() noexcept -> EventDispatcher&;
+		[[nodiscard]] static auto DefaultWorkerCount() noexcept -> std::size_t;
+		[[nodiscard]] static auto NewDispatchKey() noexcept -> DispatchKey;
+
+		// Returns false if the queue is full, the task is left untouched in that case
+		[[nodiscard]] auto TryPost(Task& task) noexcept -> bool;
+		// A rejected task is not moved from
+		auto Post(Task&& task) noexcept -> PostResult;
+
+		// If a task with the same key is still queued it is replaced, so only the latest one runs
+		auto PostCoalesced(DispatchKey key, Task&& task) noexcept -> PostResult;
+
+		[[nodiscard]] auto GetWorkerCount() const noexcept { return workers.size(); }
+		[[nodiscard]] auto GetQueueCapacity() const noexcept { return queueCapacity; }
+		[[nodiscard]] auto GetOverflowPolicy() const noexcept { return overflowPolicy; }
+		[[nodiscard]] auto GetPendingCount() const noexcept -> std::size_t;
+		// Number of tasks rejected or dropped because the queue was full
+		[[nodiscard]] auto GetDroppedCount() const noexcept -> std::size_t;
+
+		private:
+		struct QueuedTask
+		{
+			DispatchKey key;
+			Task task;
+		};
+
+		std::size_t queueCapacity;
+		OverflowPolicy overflowPolicy;
+		std::chrono::microseconds backpressureTimeout;
+		mutable std::mutex mutex;
+		std::condition_variable_any taskAvailable;
+		std::condition_variable spaceAvailable;
+		std::deque<QueuedTask> queue;
+		std::unordered_map<DispatchKey, std::uint64_t> coalescedSequences;
+		std::uint64_t headSequence = 0;
+		std::size_t droppedCount = 0;
+		std::vector<std::jthread> workers;
+
+		auto WorkerLoop(const std::stop_token& stopToken) noexcept -> void;
+		auto PopFront() noexcept -> Task;
+		// Applies the overflow policy, a task dropped to make room is moved into dropped
+		// so it can be destroyed outside the lock
+		auto MakeRoom(std::unique_lock<std::mutex>& lock, Task& dropped) noexcept -> PostResult;
+	};
+}
@@ -3,6 +3,9 @@ export module PGUI;
 export import PGUI.Window;
 export import PGUI.WindowClass;
 export import PGUI.MessageLoop;
+export import PGUI.Delegate;
+export import PGUI.EventDispatcher;
+export import PGUI.WorkStealingPool;
 export import PGUI.Event;
 export import PGUI.Mutex;
 export import PGUI.ErrorHandling;
@@ -160,7 +160,7 @@ export namespace PGUI
 		{
 			const auto det = m11* m22 - m12 * m21;
 
-			if (Abs(Determinant()) >= std::numeric_limits<float>::epsilon())
+			if (!IsInvertible())
 			{
 				return false;
 			}
@@ -194,64 +194,64 @@ export namespace PGUI::UI::D2D
 			return D2DLayer{ layer };
 		}
 
-		auto DrawLine(PointF p1, PointF p2, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawLine(PointF p1, PointF p2, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawLine(p1, p2, brush, strokeWidth);
 		}
 
-		auto DrawLine(LineSegmentF lineSegment, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawLine(LineSegmentF lineSegment, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawLine(lineSegment.start, lineSegment.end, brush, strokeWidth);
 		}
 
-		auto DrawRectangle(RectF rect, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawRectangle(RectF rect, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawRectangle(rect, brush, strokeWidth);
 		}
 
-		auto FillRectangle(RectF rect, Brush brush) const noexcept -> void
+		auto FillRectangle(RectF rect, const Brush& brush) const noexcept -> void
 		{
 			this->Get()->FillRectangle(rect, brush);
 		}
 
-		auto DrawRoundedRectangle(RoundedRect rect, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawRoundedRectangle(RoundedRect rect, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawRoundedRectangle(rect, brush, strokeWidth);
 		}
 
-		auto FillRoundedRectangle(RoundedRect rect, Brush brush) const noexcept -> void
+		auto FillRoundedRectangle(RoundedRect rect, const Brush& brush) const noexcept -> void
 		{
 			this->Get()->FillRoundedRectangle(rect, brush);
 		}
 
-		auto DrawEllipse(Ellipse ellipse, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawEllipse(Ellipse ellipse, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawEllipse(ellipse, brush, strokeWidth);
 		}
 
-		auto FillEllipse(Ellipse ellipse, Brush brush) const noexcept -> void
+		auto FillEllipse(Ellipse ellipse, const Brush& brush) const noexcept -> void
 		{
 			this->Get()->FillEllipse(ellipse, brush);
 		}
 
-		auto DrawGeometry(D2DGeometry<> geometry, Brush brush, float strokeWidth = 1.0F) const noexcept -> void
+		auto DrawGeometry(D2DGeometry<> geometry, const Brush& brush, float strokeWidth = 1.0F) const noexcept -> void
 		{
 			this->Get()->DrawGeometry(geometry.GetRaw(), brush, strokeWidth);
 		}
 
-		auto FillGeometry(D2DGeometry<> geometry, Brush brush /* Write BitmapBrush */) const noexcept -> void
+		auto FillGeometry(D2DGeometry<> geometry, const Brush& brush /* Write BitmapBrush */) const noexcept -> void
 		{
 			this->Get()->FillGeometry(geometry.GetRaw(), brush, nullptr);
 		}
 
-		auto DrawText(const wzstring_view text, const TextFormat& format, RectF textRect, Brush brush) const noexcept -> void
+		auto DrawText(const wzstring_view text, const TextFormat& format, RectF textRect, const Brush& brush) const noexcept -> void
 		{
 			const auto textFormatPtr = format.GetAs<IDWriteTextFormat>();
 			this->Get()->DrawText(text.data(), static_cast<UINT32>(text.size()),
 			                      textFormatPtr.get(), textRect, brush);
 		}
 
-		auto DrawText(const TextLayout& layout, PointF origin, Brush brush,
+		auto DrawText(const TextLayout& layout, PointF origin, const Brush& brush,
 		              const DrawTextOptions drawTextOptions = DrawTextOptions::EnableColorFont) const noexcept -> void
 		{
 			const auto textLayoutPtr = layout.GetAs<IDWriteTextLayout>();
@@ -281,7 +281,7 @@ export namespace PGUI::UI::D2D
 			                        ToUnderlying<D2D1_BITMAP_INTERPOLATION_MODE>(interpolationMode), srcRect);
 		}
 
-		auto FillOpacityMask(D2DBitmap bitmap, Brush brush,
+		auto FillOpacityMask(D2DBitmap bitmap, const Brush& brush,
 		                     RectF destinationRect, RectF sourceRect) const noexcept -> void
 		{
 			this->Get()->FillOpacityMask(bitmap.GetRaw(), brush,
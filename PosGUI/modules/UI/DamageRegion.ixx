@@ -0,0 +1,40 @@
+export module PGUI.UI.DamageRegion;
+
+import std;
+
+import PGUI.Shape;
+
+export namespace PGUI::UI
+{
+	// Area that needs to be repainted, kept as a short list of disjoint rects.
+	// Overlapping or touching rects are merged as they come in, once there are more
+	// than the allowed number the pair whose union wastes the least area is merged.
+	// Rects are disjoint so every pixel is repainted once even with translucent content.
+	class DamageRegion
+	{
+		public:
+		explicit DamageRegion(const std::size_t maxRects = 8) noexcept :
+			maxRects{ std::max(maxRects, 1ULL) }
+		{
+		}
+
+		auto Add(RectF rect) noexcept -> void;
+		auto Add(const DamageRegion& other) noexcept -> void;
+		auto Clear() noexcept -> void { rects.clear(); }
+
+		[[nodiscard]] auto IsEmpty() const noexcept { return rects.empty(); }
+		[[nodiscard]] auto GetRects() const noexcept -> std::span<const RectF> { return rects; }
+		[[nodiscard]] auto GetBounds() const noexcept -> RectF;
+		[[nodiscard]] auto GetArea() const noexcept -> float;
+		[[nodiscard]] auto Intersects(RectF rect) const noexcept -> bool;
+
+		// Drops everything outside of bounds
+		auto ClipTo(RectF bounds) noexcept -> void;
+
+		private:
+		std::vector<RectF> rects;
+		std::size_t maxRects;
+
+		auto MergeCheapestPair() noexcept -> void;
+	};
+}
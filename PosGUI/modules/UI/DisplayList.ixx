@@ -0,0 +1,227 @@
+export module PGUI.UI.DisplayList;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Brush;
+import PGUI.UI.TextLayout;
+import PGUI.UI.D2D.D2DEnums;
+
+export namespace PGUI::UI
+{
+	// Anything that can draw what a DisplayList recorded, Graphics or a mock that only logs the calls
+	template <typename T>
+	concept DisplayListTarget = requires(const T& target,
+	                                     const RectF rect, const RoundedRect roundedRect, const Ellipse ellipse,
+	                                     const PointF point, const Matrix3x2& transform, const float strokeWidth,
+	                                     const Brush& brush, const TextLayout& layout,
+	                                     const D2D::AntiAliasingMode antiAliasingMode)
+	{
+		target.FillRectangle(rect, brush);
+		target.DrawRectangle(rect, brush, strokeWidth);
+		target.FillRoundedRectangle(roundedRect, brush);
+		target.DrawRoundedRectangle(roundedRect, brush, strokeWidth);
+		target.FillEllipse(ellipse, brush);
+		target.DrawEllipse(ellipse, brush, strokeWidth);
+		target.DrawLine(point, point, brush, strokeWidth);
+		target.DrawText(layout, point, brush);
+		target.PushAxisAlignedClip(rect, antiAliasingMode);
+		target.PopAxisAlignedClip();
+		target.PushTransform(transform);
+		target.PopTransform();
+	};
+
+	// Recorded drawing commands of an element.
+	// Commands are packed into a flat byte buffer of trivially copyable records, brushes and
+	// text layouts are referenced through indices into side tables so the buffer itself holds no pointers.
+	// Resources are referenced, not copied, they have to stay alive and unchanged as long as the list is used.
+	class DisplayList
+	{
+		public:
+		DisplayList() noexcept = default;
+
+		auto FillRectangle(RectF rect, const Brush& brush) noexcept -> void;
+		auto DrawRectangle(RectF rect, const Brush& brush, float strokeWidth = 1.0F) noexcept -> void;
+		auto FillRoundedRectangle(RoundedRect rect, const Brush& brush) noexcept -> void;
+		auto DrawRoundedRectangle(RoundedRect rect, const Brush& brush, float strokeWidth = 1.0F) noexcept -> void;
+		auto FillEllipse(Ellipse ellipse, const Brush& brush) noexcept -> void;
+		auto DrawEllipse(Ellipse ellipse, const Brush& brush, float strokeWidth = 1.0F) noexcept -> void;
+		auto DrawLine(PointF p1, PointF p2, const Brush& brush, float strokeWidth = 1.0F) noexcept -> void;
+		auto DrawText(const TextLayout& layout, PointF origin, const Brush& brush) noexcept -> void;
+		auto PushAxisAlignedClip(RectF clipRect, D2D::AntiAliasingMode antiAliasingMode) noexcept -> void;
+		auto PopAxisAlignedClip() noexcept -> void;
+		auto PushTransform(const Matrix3x2& transform) noexcept -> void;
+		auto PopTransform() noexcept -> void;
+
+		// Keeps the allocated storage for the next recording
+		auto Clear() noexcept -> void;
+
+		[[nodiscard]] auto IsEmpty() const noexcept { return commandCount == 0; }
+		[[nodiscard]] auto GetCommandCount() const noexcept { return commandCount; }
+		[[nodiscard]] auto GetByteSize() const noexcept { return commands.size(); }
+		[[nodiscard]] auto GetCommandBytes() const noexcept -> std::span<const std::byte> { return commands; }
+
+		template <DisplayListTarget Target>
+		auto Replay(const Target& target) const -> void
+		{
+			auto position = commands.data();
+			const auto end = position + commands.size();
+			while (position != end)
+			{
+				switch (Read<Command>(position))
+				{
+					case Command::FillRectangle:
+					{
+						const auto data = Read<ShapeData<RectF>>(position);
+						target.FillRectangle(data.shape, *brushes[data.brush]);
+						break;
+					}
+					case Command::DrawRectangle:
+					{
+						const auto data = Read<StrokeData<RectF>>(position);
+						target.DrawRectangle(data.shape, *brushes[data.brush], data.strokeWidth);
+						break;
+					}
+					case Command::FillRoundedRectangle:
+					{
+						const auto data = Read<ShapeData<RoundedRect>>(position);
+						target.FillRoundedRectangle(data.shape, *brushes[data.brush]);
+						break;
+					}
+					case Command::DrawRoundedRectangle:
+					{
+						const auto data = Read<StrokeData<RoundedRect>>(position);
+						target.DrawRoundedRectangle(data.shape, *brushes[data.brush], data.strokeWidth);
+						break;
+					}
+					case Command::FillEllipse:
+					{
+						const auto data = Read<ShapeData<Ellipse>>(position);
+						target.FillEllipse(data.shape, *brushes[data.brush]);
+						break;
+					}
+					case Command::DrawEllipse:
+					{
+						const auto data = Read<StrokeData<Ellipse>>(position);
+						target.DrawEllipse(data.shape, *brushes[data.brush], data.strokeWidth);
+						break;
+					}
+					case Command::DrawLine:
+					{
+						const auto data = Read<LineData>(position);
+						target.DrawLine(data.p1, data.p2, *brushes[data.brush], data.strokeWidth);
+						break;
+					}
+					case Command::DrawText:
+					{
+						const auto data = Read<TextData>(position);
+						target.DrawText(*textLayouts[data.layout], data.origin, *brushes[data.brush]);
+						break;
+					}
+					case Command::PushAxisAlignedClip:
+					{
+						const auto data = Read<ClipData>(position);
+						target.PushAxisAlignedClip(data.clipRect, data.antiAliasingMode);
+						break;
+					}
+					case Command::PopAxisAlignedClip:
+					{
+						target.PopAxisAlignedClip();
+						break;
+					}
+					case Command::PushTransform:
+					{
+						target.PushTransform(Read<Matrix3x2>(position));
+						break;
+					}
+					case Command::PopTransform:
+					{
+						target.PopTransform();
+						break;
+					}
+				}
+			}
+		}
+
+		private:
+		enum class Command : std::uint8_t
+		{
+			FillRectangle,
+			DrawRectangle,
+			FillRoundedRectangle,
+			DrawRoundedRectangle,
+			FillEllipse,
+			DrawEllipse,
+			DrawLine,
+			DrawText,
+			PushAxisAlignedClip,
+			PopAxisAlignedClip,
+			PushTransform,
+			PopTransform
+		};
+
+		using ResourceIndex = std::uint32_t;
+
+		template <typename Shape>
+		struct ShapeData
+		{
+			Shape shape;
+			ResourceIndex brush;
+		};
+		template <typename Shape>
+		struct StrokeData
+		{
+			Shape shape;
+			ResourceIndex brush;
+			float strokeWidth;
+		};
+		struct LineData
+		{
+			PointF p1;
+			PointF p2;
+			ResourceIndex brush;
+			float strokeWidth;
+		};
+		struct TextData
+		{
+			PointF origin;
+			ResourceIndex layout;
+			ResourceIndex brush;
+		};
+		struct ClipData
+		{
+			RectF clipRect;
+			D2D::AntiAliasingMode antiAliasingMode;
+		};
+
+		std::vector<std::byte> commands;
+		std::vector<const Brush*> brushes;
+		std::vector<const TextLayout*> textLayouts;
+		std::size_t commandCount = 0;
+
+		// Records are unaligned in the buffer so they are always copied in and out
+		template <typename T> requires std::is_trivially_copyable_v<T>
+		static auto Read(const std::byte*& position) noexcept -> T
+		{
+			T value;
+			std::memcpy(&value, position, sizeof(T));
+			position += sizeof(T);
+
+			return value;
+		}
+
+		template <typename T> requires std::is_trivially_copyable_v<T>
+		auto Write(const Command command, const T& data) noexcept -> void
+		{
+			const auto offset = commands.size();
+			commands.resize(offset + sizeof(Command) + sizeof(T));
+			std::memcpy(commands.data() + offset, &command, sizeof(Command));
+			std::memcpy(commands.data() + offset + sizeof(Command), &data, sizeof(T));
+			commandCount++;
+		}
+		auto Write(Command command) noexcept -> void;
+
+		[[nodiscard]] auto GetBrushIndex(const Brush& brush) noexcept -> ResourceIndex;
+		[[nodiscard]] auto GetTextLayoutIndex(const TextLayout& layout) noexcept -> ResourceIndex;
+	};
+}
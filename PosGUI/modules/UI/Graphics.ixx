@@ -9,6 +9,7 @@ import PGUI.ComPtr;
 import PGUI.Shape;
 import PGUI.UI.D2D.DeviceContext;
 import PGUI.UI.D2D.D2DStructs;
+import PGUI.UI.D2D.D2DEnums;
 
 export namespace PGUI::UI
 {
@@ -41,7 +42,24 @@ export namespace PGUI::UI
 
 		auto PopTransform() const -> void;
 
+		// Transform and clip changes go through these so culling knows what is still on screen
+		auto SetTransform(const Matrix3x2& transform) const noexcept -> void;
+		auto ResetTransform() const noexcept -> void { SetTransform(Matrix3x2::Identity()); }
+		[[nodiscard]] auto GetTransform() const noexcept -> Matrix3x2;
+		auto PushAxisAlignedClip(RectF clipRect, D2D::AntiAliasingMode antiAliasingMode) const noexcept -> void;
+		auto PopAxisAlignedClip() const noexcept -> void;
+
+		// Part of the target left visible by the clips, in target coordinates, empty when nothing is
+		[[nodiscard]] auto GetVisibleBounds() const noexcept -> std::optional<RectF>;
+		// Same in the coordinates of the current transform
+		[[nodiscard]] auto GetLocalVisibleBounds() const noexcept -> std::optional<RectF>;
+		// Whether anything drawn inside rect under the current transform can reach the target
+		[[nodiscard]] auto IsVisible(RectF rect) const noexcept -> bool;
+
 		private:
 		mutable std::vector<Matrix3x2> transformStack;
+		mutable std::optional<Matrix3x2> worldTransform;
+		// Visible bounds in target coordinates after each pushed clip
+		mutable std::vector<std::optional<RectF>> clipStack;
 	};
 }
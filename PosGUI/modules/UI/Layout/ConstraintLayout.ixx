@@ -0,0 +1,69 @@
+export module PGUI.UI.Layout.ConstraintLayout;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.ErrorHandling;
+import PGUI.UI.Layout.LayoutPanel;
+import PGUI.UI.Layout.ConstraintSolver;
+
+export namespace PGUI::UI::Layout
+{
+	// Edges of an item or of the panel as solver variables, in panel coordinates
+	struct LayoutAnchors
+	{
+		Variable left;
+		Variable top;
+		Variable width;
+		Variable height;
+
+		[[nodiscard]] auto Right() const noexcept -> Expression { return left + width; }
+		[[nodiscard]] auto Bottom() const noexcept -> Expression { return top + height; }
+		[[nodiscard]] auto CenterX() const noexcept -> Expression { return left + width / 2.0; }
+		[[nodiscard]] auto CenterY() const noexcept -> Expression { return top + height / 2.0; }
+	};
+
+	// Places items by solving linear constraints between their anchors and the anchors of the panel.
+	// Items keep their measured size with weak strength and the panel size is an edit variable,
+	// so resizes and suggested values are applied incrementally instead of solving from scratch.
+	// Constraints and edit variables that reference an item are removed together with the item.
+	class ConstraintLayout final : public LayoutPanel
+	{
+		public:
+		explicit ConstraintLayout(RectF bounds) noexcept;
+
+		auto RearrangeItems() noexcept -> void override;
+
+		[[nodiscard]] auto GetPanelAnchors() const noexcept -> const LayoutAnchors& { return panelAnchors; }
+		[[nodiscard]] auto GetItemAnchors(std::size_t index) const noexcept -> Result<LayoutAnchors>;
+		[[nodiscard]] auto GetItemAnchors(const LayoutItem& item) const noexcept -> Result<LayoutAnchors>;
+
+		[[nodiscard]] auto AddConstraint(const Constraint& constraint) noexcept -> Result<void>;
+		[[nodiscard]] auto RemoveConstraint(const Constraint& constraint) noexcept -> Result<void>;
+
+		// For values that change often, like the position of a splitter while it is dragged
+		[[nodiscard]] auto AddEditVariable(const Variable& variable, double strength = Strength::Strong) noexcept -> Result<void>;
+		[[nodiscard]] auto RemoveEditVariable(const Variable& variable) noexcept -> Result<void>;
+		[[nodiscard]] auto SuggestValue(const Variable& variable, double value) noexcept -> Result<void>;
+
+		[[nodiscard]] auto GetSolver() const noexcept -> const ConstraintSolver& { return solver; }
+
+		private:
+		struct ItemEntry
+		{
+			LayoutAnchors anchors;
+			std::array<Constraint, 2> nonNegativeSize;
+			std::optional<SizeF> suggestedSize;
+		};
+
+		ConstraintSolver solver;
+		LayoutAnchors panelAnchors;
+		std::optional<SizeF> suggestedPanelSize;
+		std::vector<ItemEntry> itemEntries;
+		std::vector<Constraint> userConstraints;
+		std::vector<Variable> userEditVariables;
+
+		auto OnItemAdded(const LayoutItem&) -> void override;
+		auto OnItemRemoved(std::size_t index) -> void override;
+	};
+}
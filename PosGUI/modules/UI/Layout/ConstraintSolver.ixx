@@ -0,0 +1,345 @@
+export module PGUI.UI.Layout.ConstraintSolver;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+
+export namespace PGUI::UI::Layout
+{
+	// Unknown solved for by a ConstraintSolver, copies refer to the same unknown
+	class Variable
+	{
+		public:
+		Variable() noexcept :
+			data{ std::make_shared<Data>() }
+		{
+		}
+		explicit Variable(std::wstring name) noexcept :
+			data{ std::make_shared<Data>(MoveChecked(name)) }
+		{
+		}
+
+		[[nodiscard]] auto GetName() const noexcept -> std::wstring_view { return data->name; }
+		// Value written by the last ConstraintSolver::UpdateVariables call
+		[[nodiscard]] auto GetValue() const noexcept { return data->value; }
+
+		[[nodiscard]] auto GetId() const noexcept -> const void* { return data.get(); }
+
+		[[nodiscard]] auto operator==(const Variable& other) const noexcept -> bool
+		{
+			return data == other.data;
+		}
+
+		private:
+		friend class ConstraintSolver;
+
+		struct Data
+		{
+			std::wstring name;
+			double value = 0;
+		};
+
+		std::shared_ptr<Data> data;
+
+		auto SetValue(const double value) const noexcept -> void
+		{
+			data->value = value;
+		}
+	};
+
+	struct Term
+	{
+		Variable variable;
+		double coefficient = 1;
+	};
+
+	// Linear combination of variables plus a constant
+	struct Expression
+	{
+		std::vector<Term> terms;
+		double constant = 0;
+
+		Expression() noexcept = default;
+		explicit(false) Expression(const double constant) noexcept :
+			constant{ constant }
+		{
+		}
+		explicit(false) Expression(const Variable& variable) noexcept :
+			terms{ Term{ variable, 1 } }
+		{
+		}
+		explicit(false) Expression(const Term& term) noexcept :
+			terms{ term }
+		{
+		}
+
+		[[nodiscard]] auto Evaluate() const noexcept
+		{
+			auto value = constant;
+			for (const auto& [variable, coefficient] : terms)
+			{
+				value += variable.GetValue() * coefficient;
+			}
+			return value;
+		}
+	};
+
+	[[nodiscard]] auto operator*(Expression expression, const double factor) noexcept -> Expression
+	{
+		for (auto& term : expression.terms)
+		{
+			term.coefficient *= factor;
+		}
+		expression.constant *= factor;
+
+		return expression;
+	}
+	[[nodiscard]] auto operator*(const double factor, Expression expression) noexcept -> Expression
+	{
+		return MoveChecked(expression) * factor;
+	}
+	[[nodiscard]] auto operator/(Expression expression, const double divisor) noexcept -> Expression
+	{
+		return MoveChecked(expression) * (1.0 / divisor);
+	}
+	[[nodiscard]] auto operator-(Expression expression) noexcept -> Expression
+	{
+		return MoveChecked(expression) * -1.0;
+	}
+	[[nodiscard]] auto operator+(Expression lhs, const Expression& rhs) noexcept -> Expression
+	{
+		lhs.terms.append_range(rhs.terms);
+		lhs.constant += rhs.constant;
+
+		return lhs;
+	}
+	[[nodiscard]] auto operator-(Expression lhs, const Expression& rhs) noexcept -> Expression
+	{
+		return MoveChecked(lhs) + -rhs;
+	}
+
+	namespace Strength
+	{
+		[[nodiscard]] constexpr auto Create(
+			const double strong, const double medium, const double weak, const double weight = 1.0) noexcept
+		{
+			auto strength = 0.0;
+			strength += std::clamp(strong * weight, 0.0, 1000.0) * 1'000'000.0;
+			strength += std::clamp(medium * weight, 0.0, 1000.0) * 1'000.0;
+			strength += std::clamp(weak * weight, 0.0, 1000.0);
+
+			return strength;
+		}
+
+		constexpr auto Required = Create(1000.0, 1000.0, 1000.0);
+		constexpr auto Strong = Create(1.0, 0.0, 0.0);
+		constexpr auto Medium = Create(0.0, 1.0, 0.0);
+		constexpr auto Weak = Create(0.0, 0.0, 1.0);
+	}
+
+	enum class RelationalOperator
+	{
+		LessOrEqual,
+		GreaterOrEqual,
+		Equal
+	};
+
+	// Relation of an expression to zero, copies refer to the same constraint
+	class Constraint
+	{
+		public:
+		Constraint(Expression expression, RelationalOperator relation, double strength = Strength::Required) noexcept;
+
+		[[nodiscard]] static auto Equal(
+			const Expression& lhs, const Expression& rhs, const double strength = Strength::Required) noexcept
+		{
+			return Constraint{ lhs - rhs, RelationalOperator::Equal, strength };
+		}
+		[[nodiscard]] static auto LessOrEqual(
+			const Expression& lhs, const Expression& rhs, const double strength = Strength::Required) noexcept
+		{
+			return Constraint{ lhs - rhs, RelationalOperator::LessOrEqual, strength };
+		}
+		[[nodiscard]] static auto GreaterOrEqual(
+			const Expression& lhs, const Expression& rhs, const double strength = Strength::Required) noexcept
+		{
+			return Constraint{ lhs - rhs, RelationalOperator::GreaterOrEqual, strength };
+		}
+
+		[[nodiscard]] auto GetExpression() const noexcept -> const Expression& { return data->expression; }
+		[[nodiscard]] auto GetRelation() const noexcept { return data->relation; }
+		[[nodiscard]] auto GetStrength() const noexcept { return data->strength; }
+
+		[[nodiscard]] auto References(const Variable& variable) const noexcept -> bool;
+
+		[[nodiscard]] auto GetId() const noexcept -> const void* { return data.get(); }
+
+		[[nodiscard]] auto operator==(const Constraint& other) const noexcept -> bool
+		{
+			return data == other.data;
+		}
+
+		private:
+		struct Data
+		{
+			Expression expression;
+			RelationalOperator relation;
+			double strength;
+		};
+
+		std::shared_ptr<const Data> data;
+	};
+
+	// Incremental Cassowary solver.
+	// Constraints can be added and removed at any time, the tableau is kept optimal
+	// between calls. Values suggested for edit variables are applied with a dual
+	// simplex pass over the affected rows only, which is what makes dragging and
+	// resizing cheap compared to solving from scratch.
+	class ConstraintSolver
+	{
+		public:
+		ConstraintSolver() noexcept = default;
+
+		ConstraintSolver(const ConstraintSolver&) = delete;
+		auto operator=(const ConstraintSolver&) -> ConstraintSolver& = delete;
+		ConstraintSolver(ConstraintSolver&&) noexcept = default;
+		auto operator=(ConstraintSolver&&) noexcept -> ConstraintSolver& = default;
+
+		~ConstraintSolver() noexcept = default;
+
+		[[nodiscard]] auto AddConstraint(const Constraint& constraint) noexcept -> Result<void>;
+		[[nodiscard]] auto RemoveConstraint(const Constraint& constraint) noexcept -> Result<void>;
+		[[nodiscard]] auto HasConstraint(const Constraint& constraint) const noexcept -> bool;
+
+		// Strength must be weaker than Strength::Required
+		[[nodiscard]] auto AddEditVariable(const Variable& variable, double strength) noexcept -> Result<void>;
+		[[nodiscard]] auto RemoveEditVariable(const Variable& variable) noexcept -> Result<void>;
+		[[nodiscard]] auto HasEditVariable(const Variable& variable) const noexcept -> bool;
+
+		[[nodiscard]] auto SuggestValue(const Variable& variable, double value) noexcept -> Result<void>;
+
+		// Writes the solved values into the variables
+		auto UpdateVariables() const noexcept -> void;
+
+		auto Reset() noexcept -> void;
+
+		// Variables referenced by at least one added constraint
+		[[nodiscard]] auto GetVariableCount() const noexcept { return variables.size(); }
+
+		private:
+		enum class SymbolType
+		{
+			Invalid,
+			External,
+			Slack,
+			Error,
+			Dummy
+		};
+
+		struct Symbol
+		{
+			std::uint64_t id = 0;
+			SymbolType type = SymbolType::Invalid;
+
+			[[nodiscard]] auto IsValid() const noexcept { return type != SymbolType::Invalid; }
+
+			[[nodiscard]] auto operator==(const Symbol& other) const noexcept -> bool
+			{
+				return id == other.id;
+			}
+			[[nodiscard]] auto operator<=>(const Symbol& other) const noexcept
+			{
+				return id <=> other.id;
+			}
+		};
+
+		// constant + sum(coefficient * symbol), basic rows are solved for their key symbol
+		class Row
+		{
+			public:
+			Row() noexcept = default;
+			explicit Row(const double constant) noexcept :
+				constant{ constant }
+			{
+			}
+
+			[[nodiscard]] auto GetConstant() const noexcept { return constant; }
+			[[nodiscard]] auto GetCells() const noexcept -> const std::map<Symbol, double>& { return cells; }
+
+			auto Add(double value) noexcept -> double;
+			auto Insert(Symbol symbol, double coefficient = 1.0) noexcept -> void;
+			auto Insert(const Row& other, double coefficient = 1.0) noexcept -> void;
+			auto Remove(Symbol symbol) noexcept -> void;
+			auto ReverseSign() noexcept -> void;
+			auto SolveFor(Symbol symbol) noexcept -> void;
+			auto SolveFor(Symbol lhs, Symbol rhs) noexcept -> void;
+			[[nodiscard]] auto CoefficientFor(Symbol symbol) const noexcept -> double;
+			auto Substitute(Symbol symbol, const Row& row) noexcept -> void;
+
+			private:
+			std::map<Symbol, double> cells;
+			double constant = 0;
+		};
+
+		struct Tag
+		{
+			Symbol marker;
+			Symbol other;
+		};
+
+		struct ConstraintEntry
+		{
+			Constraint constraint;
+			Tag tag;
+		};
+
+		struct VariableEntry
+		{
+			Variable variable;
+			Symbol symbol;
+			std::size_t constraintCount = 0;
+		};
+
+		struct EditEntry
+		{
+			Variable variable;
+			Constraint constraint;
+			Tag tag;
+			double constant = 0;
+		};
+
+		std::map<Symbol, Row> rows;
+		std::unordered_map<const void*, VariableEntry> variables;
+		std::unordered_map<const void*, ConstraintEntry> constraints;
+		std::unordered_map<const void*, EditEntry> edits;
+		std::vector<Symbol> infeasibleRows;
+		Row objective;
+		std::optional<Row> artificial;
+		std::uint64_t nextSymbolId = 1;
+
+		[[nodiscard]] auto MakeSymbol(SymbolType type) noexcept -> Symbol;
+		[[nodiscard]] auto GetVariableSymbol(const Variable& variable) noexcept -> Symbol;
+
+		[[nodiscard]] auto CreateRow(const Constraint& constraint, Tag& tag) noexcept -> Row;
+		[[nodiscard]] static auto ChooseSubject(const Row& row, const Tag& tag) noexcept -> Symbol;
+		[[nodiscard]] auto AddWithArtificialVariable(const Row& row) noexcept -> Result<bool>;
+		auto Substitute(Symbol symbol, const Row& row) noexcept -> void;
+		[[nodiscard]] auto Optimize(const Row& objectiveRow) noexcept -> Result<void>;
+		[[nodiscard]] auto DualOptimize() noexcept -> Result<void>;
+
+		[[nodiscard]] static auto GetEnteringSymbol(const Row& objectiveRow) noexcept -> Symbol;
+		[[nodiscard]] auto GetDualEnteringSymbol(const Row& row) const noexcept -> Symbol;
+		[[nodiscard]] static auto GetAnyPivotableSymbol(const Row& row) noexcept -> Symbol;
+		[[nodiscard]] auto GetLeavingRow(Symbol entering) noexcept -> std::map<Symbol, Row>::iterator;
+		[[nodiscard]] auto GetMarkerLeavingRow(Symbol marker) noexcept -> std::map<Symbol, Row>::iterator;
+
+		auto RetainVariables(const Constraint& constraint) noexcept -> void;
+		auto ReleaseVariables(const Constraint& constraint, bool isRetained) noexcept -> void;
+
+		auto RemoveConstraintEffects(const Constraint& constraint, const Tag& tag) noexcept -> void;
+		auto RemoveMarkerEffects(Symbol marker, double strength) noexcept -> void;
+
+		[[nodiscard]] static auto AllDummies(const Row& row) noexcept -> bool;
+	};
+}
@@ -34,10 +34,10 @@ export namespace PGUI::UI::Layout
 		explicit DockLayout(RectF bounds) noexcept;
 
 		template <typename T>
-		auto AddItem(const T& item, DockPosition position) noexcept -> void
+		auto AddItem(T& item, DockPosition position) noexcept -> void
 		{
 			LayoutPanel::AddItem(item);
-			dockPositions.insert_or_assign(GetItemCount() - 1, position);
+			dockPositions.back() = position;
 		}
 
 		auto SetDockPosition(const LayoutItem& item, DockPosition position) -> void;
@@ -63,7 +63,8 @@ export namespace PGUI::UI::Layout
 		}
 
 		private:
-		std::map<std::size_t, DockPosition> dockPositions;
+		// Indexed like the items
+		std::vector<DockPosition> dockPositions;
 		std::map<DockPosition, float> maxDockSizes;
 		std::map<DockPosition, DockPriority> dockPriorities;
 
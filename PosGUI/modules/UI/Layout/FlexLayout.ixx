@@ -0,0 +1,129 @@
+export module PGUI.UI.Layout.FlexLayout;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.ErrorHandling;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+
+export namespace PGUI::UI::Layout
+{
+	struct FlexItemProperties
+	{
+		float grow = 0;
+		float shrink = 1;
+		// Main size the item flexes from, the measured main size of the item if not set
+		std::optional<float> basis = std::nullopt;
+		float minMainSize = 0;
+		float maxMainSize = std::numeric_limits<float>::infinity();
+		// Overrides the cross axis alignment of the layout for this item only
+		std::optional<CrossAxisAlignment> alignSelf = std::nullopt;
+		// Items are placed in ascending order, equal orders keep the insertion order
+		int order = 0;
+
+		auto operator==(const FlexItemProperties&) const noexcept -> bool = default;
+	};
+
+	// Lays items out following the CSS flexbox algorithm.
+	// Hypothetical main sizes are cached and only recomputed when the measure version
+	// of the panel or the cross size changes, each line is then resolved in one pass.
+	// Cross sizes of items come from the same measure, they are not remeasured after flexing.
+	class FlexLayout final : public LayoutPanel
+	{
+		public:
+		explicit FlexLayout(
+			RectF bounds,
+			LayoutOrientation direction = LayoutOrientation::Horizontal,
+			MainAxisAlignment justifyContent = MainAxisAlignment::Start,
+			CrossAxisAlignment alignItems = CrossAxisAlignment::Stretch,
+			WrapMode wrapMode = WrapMode::NoWrap,
+			float gap = 0, float crossGap = 0) noexcept;
+
+		template <typename T>
+		auto AddItem(T& item, const FlexItemProperties& properties) noexcept -> void
+		{
+			LayoutPanel::AddItem(item);
+			itemProperties.back() = properties;
+		}
+
+		auto RearrangeItems() noexcept -> void override;
+
+		[[nodiscard]] auto Measure(SizeF availableSize) noexcept -> SizeF override;
+
+		[[nodiscard]] auto GetItemProperties(std::size_t index) const noexcept -> Result<FlexItemProperties>;
+		[[nodiscard]] auto GetItemProperties(const LayoutItem& item) const noexcept -> Result<FlexItemProperties>;
+		[[nodiscard]] auto SetItemProperties(std::size_t index, const FlexItemProperties& properties) noexcept -> Result<void>;
+		[[nodiscard]] auto SetItemProperties(const LayoutItem& item, const FlexItemProperties& properties) noexcept -> Result<void>;
+
+		[[nodiscard]] auto GetDirection() const noexcept { return direction; }
+		auto SetDirection(LayoutOrientation newDirection) noexcept -> void;
+
+		[[nodiscard]] auto GetJustifyContent() const noexcept { return justifyContent; }
+		auto SetJustifyContent(MainAxisAlignment alignment) noexcept -> void;
+
+		[[nodiscard]] auto GetAlignItems() const noexcept { return alignItems; }
+		auto SetAlignItems(CrossAxisAlignment alignment) noexcept -> void;
+
+		// Distribution of the lines along the cross axis when wrapping
+		[[nodiscard]] auto GetAlignContent() const noexcept { return alignContent; }
+		auto SetAlignContent(MainAxisAlignment alignment) noexcept -> void;
+
+		[[nodiscard]] auto GetWrapMode() const noexcept { return wrapMode; }
+		auto SetWrapMode(WrapMode mode) noexcept -> void;
+
+		[[nodiscard]] auto GetMainAxisGap() const noexcept { return mainAxisGap; }
+		auto SetMainAxisGap(float gap) noexcept -> void;
+
+		[[nodiscard]] auto GetCrossAxisGap() const noexcept { return crossAxisGap; }
+		auto SetCrossAxisGap(float gap) noexcept -> void;
+
+		private:
+		struct FlexItemState
+		{
+			std::size_t index = 0;
+			float baseSize = 0;
+			float hypotheticalMainSize = 0;
+			float crossSize = 0;
+			float targetMainSize = 0;
+			// Difference made by clamping the target to the min and max sizes
+			float violation = 0;
+			bool isFrozen = false;
+		};
+
+		struct FlexLine
+		{
+			std::size_t first = 0;
+			std::size_t last = 0;
+			float crossSize = 0;
+		};
+
+		LayoutOrientation direction;
+		MainAxisAlignment justifyContent;
+		CrossAxisAlignment alignItems;
+		MainAxisAlignment alignContent = MainAxisAlignment::Start;
+		WrapMode wrapMode;
+		float mainAxisGap;
+		float crossAxisGap;
+
+		std::vector<FlexItemProperties> itemProperties;
+
+		// Items in placement order, reused between passes
+		std::vector<FlexItemState> itemStates;
+		std::vector<FlexLine> lines;
+		std::uint64_t cachedMeasureVersion = 0;
+		float cachedCrossLimit = 0;
+		bool hasCachedSizes = false;
+
+		[[nodiscard]] auto MainAxis(SizeF size) const noexcept -> float;
+		[[nodiscard]] auto CrossAxis(SizeF size) const noexcept -> float;
+		[[nodiscard]] auto MakeSize(float main, float cross) const noexcept -> SizeF;
+
+		auto ComputeHypotheticalSizes(float crossLimit) noexcept -> void;
+		auto CollectLines(float mainLimit) noexcept -> void;
+		auto ResolveFlexibleLengths(const FlexLine& line, float availableMain) noexcept -> void;
+
+		auto OnItemAdded(const LayoutItem&) -> void override;
+		auto OnItemRemoved(std::size_t index) -> void override;
+	};
+}
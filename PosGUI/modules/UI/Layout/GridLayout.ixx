@@ -123,7 +123,7 @@ export namespace PGUI::UI::Layout
 		auto SetGap(FixedSize gap) noexcept -> void;
 
 		template <typename T>
-		auto AddItem(const T& item, const GridItemProperties& properties) noexcept -> void
+		auto AddItem(T& item, const GridItemProperties& properties) noexcept -> void
 		{
 			SetItemProperty(GetItemCount(), properties);
 			LayoutPanel::AddItem(item);
@@ -146,12 +146,12 @@ export namespace PGUI::UI::Layout
 		auto SetColumnDefinitions(const std::vector<GridCellDefinition>& definitions) noexcept -> void
 		{
 			columnDefinitions = definitions;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 		auto AddColumnDefinition(const GridCellDefinition& definition) noexcept
 		{
 			columnDefinitions.push_back(definition);
-			RearrangeItems();
+			InvalidateArrange();
 		}
 		[[nodiscard]] auto GetRowDefinitions() const noexcept
 		{
@@ -160,12 +160,12 @@ export namespace PGUI::UI::Layout
 		auto SetRowDefinitions(const std::vector<GridCellDefinition>& definitions) noexcept -> void
 		{
 			rowDefinitions = definitions;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 		auto AddRowDefinition(const GridCellDefinition& definition) noexcept
 		{
 			rowDefinitions.push_back(definition);
-			RearrangeItems();
+			InvalidateArrange();
 		}
 
 		[[nodiscard]] auto RemoveColumnDefinitionAtIndex(std::size_t index) noexcept -> Result<void>;
@@ -178,7 +178,7 @@ export namespace PGUI::UI::Layout
 		auto SetGrowToFit(const bool grow) noexcept -> void
 		{
 			growToFit = grow;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 
 		[[nodiscard]] auto GetPadding() const noexcept
@@ -188,7 +188,7 @@ export namespace PGUI::UI::Layout
 		auto SetPadding(const GridLayoutPadding& newPadding) noexcept -> void
 		{
 			padding = newPadding;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 
 		[[nodiscard]] auto GetAutoCellSize() const noexcept
@@ -198,7 +198,7 @@ export namespace PGUI::UI::Layout
 		[[nodiscard]] auto SetAutoCellSize(const GridCellDefinition size) noexcept -> Result<void>
 		{
 			autoCellSize = size;
-			RearrangeItems();
+			InvalidateArrange();
 
 			return EmptyResult;
 		}
@@ -210,7 +210,7 @@ export namespace PGUI::UI::Layout
 		auto SetPlacementType(const GridCellPlacementType type) noexcept -> void
 		{
 			placementType = type;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 
 		[[nodiscard]] auto InsertBlankCell(const long row, const long column) noexcept -> Result<void>
@@ -220,7 +220,7 @@ export namespace PGUI::UI::Layout
 				return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Cannot insert a blank cell with auto place") };
 			}
 			blankCells.emplace(row, column);
-			RearrangeItems();
+			InvalidateArrange();
 
 			return EmptyResult;
 		}
@@ -232,7 +232,7 @@ export namespace PGUI::UI::Layout
 			}
 
 			blankCells.erase(std::make_pair(row, column));
-			RearrangeItems();
+			InvalidateArrange();
 			return EmptyResult;
 		}
 
@@ -255,22 +255,19 @@ export namespace PGUI::UI::Layout
 		std::vector<GridCellDefinition> rowDefinitions;
 
 		bool needsSorting = false;
-		std::vector<std::pair<std::size_t, GridItemProperties>> itemProperties;
+		// Indexed like the items
+		std::vector<GridItemProperties> itemProperties;
+		// Item indices in the order they are placed, kept sorted by SortProperties
+		std::vector<std::size_t> placementOrder;
 
 		auto GetItemId(const LayoutItem& item) const noexcept -> Result<std::size_t>;
 		auto SetItemProperty(std::size_t id, const GridItemProperties& properties) noexcept -> void;
 		auto GetItemProperty(std::size_t id) const noexcept -> Result<GridItemProperties>;
-		auto HasEntry(std::size_t id) const noexcept -> Result<std::size_t>
+		auto HasEntry(const std::size_t id) const noexcept -> Result<std::size_t>
 		{
-			const auto iter = std::ranges::find_if(
-				itemProperties,
-				[&id](const auto& item) noexcept
+			if (id < itemProperties.size())
 			{
-				return item.first == id;
-			});
-			if (iter != itemProperties.end())
-			{
-				return std::distance(itemProperties.begin(), iter);
+				return id;
 			}
 
 			return Unexpected{
@@ -284,6 +281,7 @@ export namespace PGUI::UI::Layout
 		auto PropertyChangeHandler(const long&) noexcept
 		{
 			needsSorting = true;
+			InvalidateArrange();
 		}
 		auto ColumnSpanValidator(const long& value, const long column) const noexcept
 		{
@@ -4,5 +4,10 @@ export import PGUI.UI.Layout.LayoutEnums;
 export import PGUI.UI.Layout.LayoutStructs;
 export import PGUI.UI.Layout.LayoutPanel;
 export import PGUI.UI.Layout.StackLayout;
+export import PGUI.UI.Layout.FlexLayout;
+export import PGUI.UI.Layout.VirtualizingStackLayout;
 export import PGUI.UI.Layout.GridLayout;
 export import PGUI.UI.Layout.DockLayout;
+export import PGUI.UI.Layout.ConstraintSolver;
+export import PGUI.UI.Layout.ConstraintLayout;
+export import PGUI.UI.Layout.LayoutDiagnostics;
@@ -0,0 +1,68 @@
+export module PGUI.UI.Layout.LayoutDiagnostics;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.WorkStealingPool;
+import PGUI.UI.Layout.LayoutPanel;
+
+export namespace PGUI::UI::Layout
+{
+	// Item that is only a rectangle and a desired size.
+	// Useful as a spacer and as a stand in for elements when profiling layouts without a window.
+	class LayoutSpacer
+	{
+		public:
+		explicit LayoutSpacer(const SizeF desiredSize = { }) noexcept :
+			desiredSize{ desiredSize }
+		{
+		}
+
+		auto MoveAndResize(const RectF newRect) noexcept -> void { rect = newRect; }
+		auto MoveAndResize(const PointF point, const SizeF size) noexcept -> void { rect = RectF{ point, size }; }
+		auto Move(const PointF point) noexcept -> void { rect.Move(point); }
+		auto Resize(const SizeF size) noexcept -> void { rect.Resize(size); }
+
+		[[nodiscard]] auto GetRect() const noexcept -> RectF { return rect; }
+		[[nodiscard]] auto GetSize() const noexcept -> SizeF { return rect.Size(); }
+		[[nodiscard]] auto GetPosition() const noexcept -> PointF { return rect.TopLeft(); }
+
+		[[nodiscard]] auto Measure(const SizeF) const noexcept -> SizeF { return desiredSize; }
+		[[nodiscard]] auto GetMeasureVersion() const noexcept { return measureVersion; }
+
+		[[nodiscard]] auto GetDesiredSize() const noexcept { return desiredSize; }
+		// The panel holding the spacer picks the change up through the measure version,
+		// panels above it only see it once it is reported with InvalidateItemMeasure
+		auto SetDesiredSize(const SizeF size) noexcept -> void
+		{
+			if (desiredSize != size)
+			{
+				desiredSize = size;
+				measureVersion++;
+			}
+		}
+
+		private:
+		RectF rect;
+		SizeF desiredSize;
+		std::uint64_t measureVersion = 0;
+	};
+
+	struct LayoutPassReport
+	{
+		std::chrono::nanoseconds duration{ };
+		std::size_t panelCount = 0;
+		// Panels with a pending arrangement when the pass started, panels they resize are not counted
+		std::size_t dirtyPanelCount = 0;
+		std::size_t itemCount = 0;
+		std::size_t itemStorageBytes = 0;
+	};
+
+	// Runs the pending layout work of the tree and reports what it covered and how long it took
+	[[nodiscard]] auto ProfileLayoutPass(LayoutPanel& panel) noexcept -> LayoutPassReport;
+	[[nodiscard]] auto ProfileLayoutPass(LayoutPanel& panel, WorkStealingPool& pool) noexcept -> LayoutPassReport;
+
+	// One line per item in depth first order, with the depth, the index within its panel and its rect.
+	// Values are printed with a fixed precision so that dumps taken before and after a change can be diffed.
+	[[nodiscard]] auto DumpLayoutRects(const LayoutPanel& panel, int precision = 3) noexcept -> std::wstring;
+}
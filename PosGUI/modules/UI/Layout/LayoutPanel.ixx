@@ -9,6 +9,8 @@ import PGUI.Window;
 import PGUI.Shape;
 import PGUI.Utils;
 import PGUI.ErrorHandling;
+import PGUI.Event;
+import PGUI.WorkStealingPool;
 
 namespace PGUI::UI::Layout::Detail
 {
@@ -23,10 +25,26 @@ namespace PGUI::UI::Layout::Detail
 		{ t.GetSize() } -> std::same_as<SizeF>;
 		{ t.GetPosition() } -> std::same_as<PointF>;
 	};;
+
+	template <typename T>
+	concept MeasurableLayoutItem = requires (T & t)
+	{
+		{ t.Measure(SizeF{ }) } -> std::same_as<SizeF>;
+	};
+
+	// Items reporting a version that advances whenever their desired size may change
+	// can have their measurements cached by the panel
+	template <typename T>
+	concept VersionedLayoutItem = requires (const T & t)
+	{
+		{ t.GetMeasureVersion() } -> std::convertible_to<std::uint64_t>;
+	};
 }
 
 export namespace PGUI::UI::Layout
 {
+	class LayoutPanel;
+
 	class LayoutItem
 	{
 		struct VTable
@@ -38,8 +56,27 @@ export namespace PGUI::UI::Layout
 			RectF (*getRect)(const void*) noexcept;
 			SizeF (*getSize)(const void*) noexcept;
 			PointF (*getPosition)(const void*) noexcept;
+			SizeF (*measure)(void*, SizeF) noexcept;
+			std::uint64_t (*getMeasureVersion)(const void*) noexcept;
+			LayoutPanel* (*asPanel)(void*) noexcept;
 		};
 
+		template <typename T>
+		static constexpr auto MeasureVersionGetterFor() noexcept -> std::uint64_t (*)(const void*) noexcept
+		{
+			if constexpr (Detail::VersionedLayoutItem<T>)
+			{
+				return [](const void* obj) noexcept -> std::uint64_t
+				{
+					return static_cast<const T*>(obj)->GetMeasureVersion();
+				};
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
 		template <typename T>
 		static constexpr VTable vtableFor{
 			[](void* obj, const RectF rect) noexcept { static_cast<T*>(obj)->MoveAndResize(rect); },
@@ -48,11 +85,35 @@ export namespace PGUI::UI::Layout
 			[](void* obj, const SizeF size) noexcept { static_cast<T*>(obj)->Resize(size); },
 			[](const void* obj) noexcept -> RectF { return static_cast<const T*>(obj)->GetRect(); },
 			[](const void* obj) noexcept -> SizeF { return static_cast<const T*>(obj)->GetSize(); },
-			[](const void* obj) noexcept -> PointF { return static_cast<const T*>(obj)->GetPosition(); }
+			[](const void* obj) noexcept -> PointF { return static_cast<const T*>(obj)->GetPosition(); },
+			[](void* obj, const SizeF availableSize) noexcept -> SizeF
+			{
+				if constexpr (Detail::MeasurableLayoutItem<T>)
+				{
+					return static_cast<T*>(obj)->Measure(availableSize);
+				}
+				else
+				{
+					return static_cast<const T*>(obj)->GetSize();
+				}
+			},
+			MeasureVersionGetterFor<T>(),
+			[](void* obj) noexcept -> LayoutPanel*
+			{
+				if constexpr (std::derived_from<T, LayoutPanel>)
+				{
+					return static_cast<T*>(obj);
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
 		};
 
 		public:
-		template <Detail::LayoutItemLike T>
+		// Excluding LayoutItem keeps copies of a non const item from wrapping the item itself
+		template <Detail::LayoutItemLike T> requires NotSameAs<T, LayoutItem>
 		explicit LayoutItem(T& item) noexcept :
 			obj{ std::addressof(item) },
 			vtable{ &vtableFor<T> }
@@ -87,6 +148,31 @@ export namespace PGUI::UI::Layout
 		{
 			return vtable->getPosition(obj);
 		}
+		// Items without a Measure function desire their current size
+		[[nodiscard]] auto Measure(const SizeF availableSize) const noexcept -> SizeF
+		{
+			return vtable->measure(obj, availableSize);
+		}
+		[[nodiscard]] auto HasMeasureVersion() const noexcept -> bool
+		{
+			return vtable->getMeasureVersion != nullptr;
+		}
+		[[nodiscard]] auto GetMeasureVersion() const noexcept -> std::uint64_t
+		{
+			if (vtable->getMeasureVersion == nullptr)
+			{
+				return 0;
+			}
+			return vtable->getMeasureVersion(obj);
+		}
+		// Non null when the item is itself a panel
+		[[nodiscard]] auto AsPanel() const noexcept -> LayoutPanel*
+		{
+			return vtable->asPanel(obj);
+		}
+
+		// Identifies the underlying object, items made from the same object share it
+		[[nodiscard]] auto GetId() const noexcept -> const void* { return obj; }
 
 		[[nodiscard]] auto operator==(const LayoutItem& other) const noexcept -> bool
 		{
@@ -103,21 +189,104 @@ export namespace PGUI::UI::Layout
 		return LayoutItem{ item };
 	}
 
+	// Panels measure their items before arranging them, an item is asked for the size it desires
+	// within the available size and the answer is cached for items reporting a measure version.
+	// A cached size is reused until the item's version or the available size changes.
+	// Items without a version are measured by their current size every time, a panel
+	// that holds them has to be invalidated when they are resized from outside.
+	// Changes only mark a panel dirty, the work is done once by UpdateLayout which
+	// rearranges dirty panels and walks down only into subtrees that contain one.
+	// Items are kept as parallel arrays indexed by item index, derived panels keep their
+	// per item attributes the same way. Geometry computed during UpdateLayout is written
+	// to a buffer and committed to the items once the whole pass is done.
 	class LayoutPanel
 	{
+		struct MeasureCacheEntry
+		{
+			SizeF availableSize;
+			SizeF desiredSize;
+			std::uint64_t version = 0;
+			bool isValid = false;
+		};
+
 		public:
 		explicit LayoutPanel(const RectF bounds) noexcept :
 			rect{ bounds }
 		{
 		}
-		virtual ~LayoutPanel() noexcept = default;
+		virtual ~LayoutPanel() noexcept
+		{
+			for (const auto& item : managedItems)
+			{
+				if (const auto panel = item.AsPanel();
+					panel != nullptr)
+				{
+					panel->parentPanel = nullptr;
+				}
+			}
+		}
+
+		LayoutPanel(const LayoutPanel&) = delete;
+		LayoutPanel(LayoutPanel&&) = delete;
+		auto operator=(const LayoutPanel&) -> LayoutPanel& = delete;
+		auto operator=(LayoutPanel&&) -> LayoutPanel& = delete;
 
 		virtual auto RearrangeItems() noexcept -> void = 0;
 
+		// Runs the pending layout work of this panel and the panels below it.
+		// Items other than panels see their new geometry only after the whole pass,
+		// in the order the panels arranged them.
+		auto UpdateLayout() noexcept -> void;
+		// Same as UpdateLayout but dirty sibling panels are laid out in parallel on the pool.
+		// Panels only touch their own subtree so they run on the workers, changes to other items
+		// are collected and applied on the calling thread after the join, in the order UpdateLayout
+		// would apply them. Items may still be measured on worker threads.
+		auto UpdateLayout(WorkStealingPool& pool) noexcept -> void;
+
+		auto InvalidateArrange() noexcept -> void
+		{
+			const auto wasClean = !IsLayoutDirty();
+			isArrangeDirty = true;
+			if (wasClean)
+			{
+				PropagateDirty();
+			}
+		}
+
+		[[nodiscard]] auto IsLayoutDirty() const noexcept
+		{
+			return isArrangeDirty || hasDirtyDescendant;
+		}
+		// Only this panel, IsLayoutDirty also covers the panels below it
+		[[nodiscard]] auto IsArrangeDirty() const noexcept { return isArrangeDirty; }
+
+		[[nodiscard]] auto GetParentPanel() const noexcept { return parentPanel; }
+
+		// Raised by a panel without a parent when it goes from clean to dirty,
+		// the owner should schedule an UpdateLayout call
+		template <typename Self>
+		[[nodiscard]] auto&& LayoutInvalidatedEvent(this Self&& self) noexcept
+		{
+			return std::forward_like<Self>(self.layoutInvalidatedEvent);
+		}
+
 		template <typename T> requires Detail::LayoutItemLike<T>
 		auto AddItem(T& item) noexcept -> void
 		{
 			managedItems.push_back(MakeLayoutItem(item));
+			measureCache.emplace_back();
+			// An item added twice keeps the index of its first occurrence
+			itemIndices.try_emplace(managedItems.back().GetId(), managedItems.size() - 1);
+			if (const auto panel = managedItems.back().AsPanel();
+				panel != nullptr)
+			{
+				panel->parentPanel = this;
+				if (panel->IsLayoutDirty())
+				{
+					MarkDescendantDirty();
+				}
+			}
+			InvalidateMeasure();
 			OnItemAdded(managedItems.back());
 		}
 
@@ -128,7 +297,30 @@ export namespace PGUI::UI::Layout
 				return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Given index is out of range") };
 			}
 
+			if (const auto panel = managedItems[index].AsPanel();
+				panel != nullptr)
+			{
+				panel->parentPanel = nullptr;
+			}
+
+			if (const auto it = itemIndices.find(managedItems[index].GetId());
+				it->second == index)
+			{
+				itemIndices.erase(it);
+			}
 			managedItems.erase(managedItems.begin() + index);
+			measureCache.erase(measureCache.begin() + index);
+			// First occurrences after the removed item move down by one, a removed first occurrence
+			// is taken over by the next occurrence of the same item if there is one
+			for (const auto i : std::views::iota(index, managedItems.size()))
+			{
+				if (const auto [it, inserted] = itemIndices.try_emplace(managedItems[i].GetId(), i);
+					!inserted && it->second == i + 1)
+				{
+					it->second = i;
+				}
+			}
+			InvalidateMeasure();
 			OnItemRemoved(index);
 
 			return EmptyResult;
@@ -165,14 +357,22 @@ export namespace PGUI::UI::Layout
 		{
 			return managedItems.size();
 		}
+		// Bytes held for the bookkeeping of the items, not counting the items or derived panel state
+		[[nodiscard]] auto GetItemStorageBytes() const noexcept
+		{
+			return managedItems.capacity() * sizeof(LayoutItem) +
+			       measureCache.capacity() * sizeof(MeasureCacheEntry) +
+			       itemIndices.bucket_count() * sizeof(void*) +
+			       itemIndices.size() * sizeof(std::pair<const void* const, std::size_t>) +
+			       pendingChanges.capacity() * sizeof(PendingItemChange);
+		}
 
 		auto GetTotalItemSize() const noexcept
 		{
 			SizeF totalSize;
-			for (const auto& item : GetItems())
+			for (const auto index : std::views::iota(0ULL, GetItemCount()))
 			{
-				const auto size = MeasureItem(item);
-				totalSize += size;
+				totalSize += MeasureItem(index);
 			}
 
 			return totalSize;
@@ -185,10 +385,9 @@ export namespace PGUI::UI::Layout
 			}
 
 			SizeF totalSize;
-			for (const auto& item : GetItems() | std::views::take(index + 1))
+			for (const auto i : std::views::iota(0ULL, index + 1))
 			{
-				const auto size = MeasureItem(item);
-				totalSize += size;
+				totalSize += MeasureItem(i);
 			}
 			return totalSize;
 		}
@@ -207,48 +406,102 @@ export namespace PGUI::UI::Layout
 			}
 
 			SizeF totalSize;
-
-			for (const auto& item : GetItems() |
-				std::views::drop(startIndex) | std::views::take(end - startIndex + 1))
+			for (const auto index : std::views::iota(startIndex, end + 1))
 			{
-				const auto size = MeasureItem(item);
-				totalSize += size;
+				totalSize += MeasureItem(index);
 			}
 			return totalSize;
 		}
 
-		static auto MeasureItem(const LayoutItem& item) noexcept -> SizeF
+		// Desired size of the panel itself within availableSize, panels without a notion
+		// of content size desire their current size
+		[[nodiscard]] virtual auto Measure(const SizeF) noexcept -> SizeF
 		{
-			return item.GetSize();
+			return GetSize();
 		}
-		auto MeasureItem(const std::size_t index) const noexcept -> SizeF
+		// Advances whenever this panel or any panel below it is invalidated,
+		// other versioned items reach it through InvalidateItemMeasure
+		[[nodiscard]] auto GetMeasureVersion() const noexcept -> std::uint64_t
 		{
-			if (index < managedItems.size())
+			return measureVersion;
+		}
+		// The desired size of this panel changed, so it and every panel above it need to be remeasured and rearranged
+		auto InvalidateMeasure() noexcept -> void
+		{
+			for (auto panel = this; panel != nullptr; panel = panel->parentPanel)
+			{
+				panel->measureVersion++;
+				panel->InvalidateArrange();
+			}
+		}
+		[[nodiscard]] auto InvalidateItemMeasure(const std::size_t index) noexcept -> Result<void>
+		{
+			if (index >= measureCache.size())
+			{
+				return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Given index is out of range") };
+			}
+
+			measureCache[index].isValid = false;
+			InvalidateMeasure();
+
+			return EmptyResult;
+		}
+
+		static auto MeasureItem(const LayoutItem& item, const SizeF availableSize) noexcept -> SizeF
+		{
+			return item.Measure(availableSize);
+		}
+		auto MeasureItem(const std::size_t index, const SizeF availableSize) const noexcept -> SizeF
+		{
+			if (index >= managedItems.size())
+			{
+				return SizeF{ 0, 0 };
+			}
+
+			const auto& item = managedItems[index];
+			if (!item.HasMeasureVersion())
+			{
+				return item.Measure(availableSize);
+			}
+
+			auto& entry = measureCache[index];
+			const auto version = item.GetMeasureVersion();
+			if (!entry.isValid || entry.version != version || entry.availableSize != availableSize)
 			{
-				return MeasureItem(managedItems.at(index));
+				entry = MeasureCacheEntry{
+					.availableSize = availableSize,
+					.desiredSize = item.Measure(availableSize),
+					.version = version,
+					.isValid = true
+				};
 			}
 
-			return SizeF{ 0, 0 };
+			return entry.desiredSize;
+		}
+		auto MeasureItem(const std::size_t index) const noexcept -> SizeF
+		{
+			return MeasureItem(index, GetSize());
 		}
+
 		auto MoveAndResize(const RectF newRect) noexcept
 		{
-			rect = newRect;
-			RearrangeItems();
+			SetRect(newRect);
 		}
 		auto MoveAndResize(const PointF point, const SizeF size) noexcept
 		{
-			rect = { point, size };
-			RearrangeItems();
+			SetRect(RectF{ point, size });
 		}
 		auto Move(const PointF point) noexcept
 		{
-			rect.Move(point);
-			RearrangeItems();
+			auto newRect = rect;
+			newRect.Move(point);
+			SetRect(newRect);
 		}
 		auto Resize(const SizeF size) noexcept
 		{
-			rect.Resize(size);
-			RearrangeItems();
+			auto newRect = rect;
+			newRect.Resize(size);
+			SetRect(newRect);
 		}
 		[[nodiscard]] auto GetRect() const noexcept -> RectF
 		{
@@ -266,14 +519,10 @@ export namespace PGUI::UI::Layout
 		protected:
 		auto GetItemIndex(const LayoutItem& item) const noexcept -> Result<std::size_t>
 		{
-			if (const auto it = std::ranges::find_if(
-				GetItems(),
-				[&item](const auto& other)
+			if (const auto it = itemIndices.find(item.GetId());
+				it != itemIndices.end())
 			{
-				return item == other;
-			}); it != GetItems().end())
-			{
-				return std::distance(GetItems().begin(), it);
+				return it->second;
 			}
 
 			return Unexpected{
@@ -284,17 +533,26 @@ export namespace PGUI::UI::Layout
 		{
 			auto converted = assignedBounds;
 			converted.Shift(rect.TopLeft());
-			item.MoveAndResize(converted);
+			if (!TryDeferItemChange(item, converted))
+			{
+				item.MoveAndResize(converted);
+			}
 		}
 		auto MoveItem(const LayoutItem& item, const PointF point) const noexcept -> void
 		{
 			auto converted = point;
 			converted.Shift(rect.TopLeft());
-			item.Move(converted);
+			if (!TryDeferItemChange(item, converted))
+			{
+				item.Move(converted);
+			}
 		}
 		static auto ResizeItem(const LayoutItem& item, const SizeF size) noexcept -> void
 		{
-			item.Resize(size);
+			if (!TryDeferItemChange(item, size))
+			{
+				item.Resize(size);
+			}
 		}
 		[[nodiscard]] auto ArrangeItem(const std::size_t index, const RectF assignedBounds) const noexcept -> Result<void>
 		{
@@ -324,13 +582,24 @@ export namespace PGUI::UI::Layout
 			return EmptyResult;
 		}
 
+		// Measures every item once against the same available size
+		[[nodiscard]] auto MeasureItems(const SizeF availableSize) const noexcept -> std::vector<SizeF>
+		{
+			return std::views::iota(0ULL, GetItemCount()) |
+			       std::views::transform([this, availableSize](const auto index)
+			       {
+				       return MeasureItem(index, availableSize);
+			       }) |
+			       std::ranges::to<std::vector>();
+		}
+
 		virtual auto OnItemAdded(const LayoutItem&) -> void
 		{
-			RearrangeItems();
+			InvalidateArrange();
 		}
 		virtual auto OnItemRemoved(const std::size_t) -> void
 		{
-			RearrangeItems();
+			InvalidateArrange();
 		}
 
 		auto operator==(const LayoutPanel& other) const noexcept -> bool
@@ -339,7 +608,68 @@ export namespace PGUI::UI::Layout
 		}
 
 		private:
+		using ItemChange = std::variant<RectF, PointF, SizeF>;
+
+		struct PendingItemChange
+		{
+			LayoutItem item;
+			ItemChange change;
+		};
+
 		std::vector<LayoutItem> managedItems;
+		mutable std::vector<MeasureCacheEntry> measureCache;
+		std::unordered_map<const void*, std::size_t> itemIndices;
+		// Reused by every UpdateLayout call so a pass doesn't allocate once it has warmed up
+		std::vector<PendingItemChange> pendingChanges;
+		std::uint64_t measureVersion = 0;
 		RectF rect;
+		LayoutPanel* parentPanel = nullptr;
+		bool isArrangeDirty = true;
+		bool hasDirtyDescendant = false;
+		EventNM<> layoutInvalidatedEvent;
+
+		class DeferredChangeScope;
+		// Buffer the item changes of the running pass go to, null outside of a pass
+		static thread_local std::vector<PendingItemChange>* deferredChanges;
+
+		// Records the change instead of applying it while a layout pass runs on this thread
+		[[nodiscard]] static auto TryDeferItemChange(const LayoutItem& item, ItemChange change) noexcept -> bool;
+		static auto CommitItemChanges(std::span<const PendingItemChange> changes) noexcept -> void;
+
+		auto UpdateLayoutSerial() noexcept -> void;
+		auto UpdateLayoutParallel(WorkStealingPool& pool) noexcept -> void;
+
+		auto SetRect(const RectF newRect) noexcept -> void
+		{
+			if (rect != newRect)
+			{
+				rect = newRect;
+				InvalidateArrange();
+			}
+		}
+
+		// Ancestors only need to know that something below them is dirty,
+		// the walk stops at the first one that already knows
+		auto MarkDescendantDirty() noexcept -> void
+		{
+			const auto wasClean = !IsLayoutDirty();
+			hasDirtyDescendant = true;
+			if (wasClean)
+			{
+				PropagateDirty();
+			}
+		}
+
+		auto PropagateDirty() noexcept -> void
+		{
+			if (parentPanel != nullptr)
+			{
+				parentPanel->MarkDescendantDirty();
+			}
+			else
+			{
+				layoutInvalidatedEvent.Invoke();
+			}
+		}
 	};
 }
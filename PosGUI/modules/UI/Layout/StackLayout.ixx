@@ -36,6 +36,8 @@ export namespace PGUI::UI::Layout
 
 		auto RearrangeItems() noexcept -> void override;
 
+		[[nodiscard]] auto Measure(SizeF availableSize) noexcept -> SizeF override;
+
 		[[nodiscard]] auto GetOrientation() const noexcept { return orientation; }
 		auto SetOrientation(LayoutOrientation newOrientation) noexcept -> void;
 
@@ -71,10 +73,10 @@ export namespace PGUI::UI::Layout
 		) noexcept -> void;
 
 		protected:
-		auto RearrangeHorizontalNoWrap() noexcept -> void;
-		auto RearrangeVerticalNoWrap() noexcept -> void;
-		auto RearrangeHorizontalWrap() noexcept -> void;
-		auto RearrangeVerticalWrap() noexcept -> void;
+		auto RearrangeHorizontalNoWrap(std::span<const SizeF> itemSizes) noexcept -> void;
+		auto RearrangeVerticalNoWrap(std::span<const SizeF> itemSizes) noexcept -> void;
+		auto RearrangeHorizontalWrap(std::span<const SizeF> itemSizes) noexcept -> void;
+		auto RearrangeVerticalWrap(std::span<const SizeF> itemSizes) noexcept -> void;
 
 		private:
 		LayoutOrientation orientation;
@@ -85,12 +87,15 @@ export namespace PGUI::UI::Layout
 		float mainAxisGap;
 		float crossAxisGap;
 
-		bool batchChanges = false;
+		// Items get a bounded cross axis and an unbounded main axis
+		[[nodiscard]] auto GetItemConstraint(SizeF panelSize) const noexcept -> SizeF;
 
 		auto RearrangeHorizontalRow(
+			std::span<const SizeF> itemSizes,
 			std::size_t startChildIndex, std::size_t endChildIndex,
 			float yPosition, std::size_t rowCount) noexcept -> void;
 		auto RearrangeVerticalColumn(
+			std::span<const SizeF> itemSizes,
 			std::size_t startChildIndex, std::size_t endChildIndex,
 			float xPosition, std::size_t columnCount) noexcept -> void;
 	};
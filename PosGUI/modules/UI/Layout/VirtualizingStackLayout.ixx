@@ -0,0 +1,98 @@
+export module PGUI.UI.Layout.VirtualizingStackLayout;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+import PGUI.UI.Layout.LayoutEnums;
+import PGUI.UI.Layout.LayoutPanel;
+
+export namespace PGUI::UI::Layout
+{
+	// Extent of the item along the stacking axis, used until the item is realized and measured
+	using ItemExtentEstimator = std::move_only_function<float(std::size_t) const>;
+	// Returns the item to show at the index, or nothing if the index cannot be shown yet
+	using ItemRealizer = std::move_only_function<std::optional<LayoutItem>(std::size_t)>;
+	// Called when a realized item leaves the realization window so it can be reused
+	using ItemRecycler = std::move_only_function<void(std::size_t, const LayoutItem&)>;
+
+	// Stack of a virtual list of items where only the ones inside the viewport plus an
+	// overscan window are realized and arranged.
+	// Item extents are kept in a Fenwick tree so offsets and offset to index lookups are O(log n),
+	// estimates are replaced by measured extents as items get realized.
+	// Offsets are summed in double and only narrowed to float for the arranged rects,
+	// so they stay exact far down lists with millions of items.
+	// The viewport is in content coordinates, its position along the stacking axis is the scroll offset.
+	// The scroll offset is kept in double on its own, the viewport rect only holds it narrowed to float.
+	class VirtualizingStackLayout final : public LayoutPanel
+	{
+		public:
+		VirtualizingStackLayout(
+			RectF bounds,
+			LayoutOrientation orientation,
+			std::size_t itemCount,
+			ItemExtentEstimator estimator,
+			ItemRealizer realizer,
+			ItemRecycler recycler = nullptr) noexcept;
+
+		~VirtualizingStackLayout() noexcept override;
+
+		auto RearrangeItems() noexcept -> void override;
+
+		[[nodiscard]] auto Measure(SizeF availableSize) noexcept -> SizeF override;
+
+		[[nodiscard]] auto GetOrientation() const noexcept { return orientation; }
+		auto SetOrientation(LayoutOrientation newOrientation) noexcept -> void;
+
+		[[nodiscard]] auto GetVirtualItemCount() const noexcept { return extents.Size(); }
+		auto SetVirtualItemCount(std::size_t count) noexcept -> void;
+
+		[[nodiscard]] auto GetViewport() const noexcept { return viewport; }
+		auto SetViewport(RectF newViewport) noexcept -> void;
+
+		[[nodiscard]] auto GetScrollOffset() const noexcept { return scrollOffset; }
+		auto SetScrollOffset(double offset) noexcept -> void;
+
+		[[nodiscard]] auto GetOverscan() const noexcept { return overscan; }
+		auto SetOverscan(std::size_t count) noexcept -> void;
+
+		// Reports the real extent of an item, for example after its content changed
+		[[nodiscard]] auto SetItemExtent(std::size_t index, float extent) noexcept -> Result<void>;
+		[[nodiscard]] auto GetItemExtent(std::size_t index) const noexcept -> Result<float>;
+
+		[[nodiscard]] auto GetItemOffset(std::size_t index) const noexcept -> Result<float>;
+		[[nodiscard]] auto GetIndexAtOffset(float offset) const noexcept -> Result<std::size_t>;
+		[[nodiscard]] auto GetContentExtent() const noexcept -> float;
+
+		// Moves the viewport so that the item starts at its leading edge
+		[[nodiscard]] auto ScrollToIndex(std::size_t index) noexcept -> Result<void>;
+
+		[[nodiscard]] auto GetRealizedItems() const noexcept -> const std::map<std::size_t, LayoutItem>&
+		{
+			return realizedItems;
+		}
+
+		private:
+		LayoutOrientation orientation;
+		ItemExtentEstimator estimator;
+		ItemRealizer realizer;
+		ItemRecycler recycler;
+		FenwickTree<double> extents;
+		std::map<std::size_t, LayoutItem> realizedItems;
+		RectF viewport;
+		double scrollOffset = 0.0;
+		std::size_t overscan = 4;
+
+		[[nodiscard]] auto MainAxis(SizeF size) const noexcept -> float;
+		[[nodiscard]] auto CrossAxis(SizeF size) const noexcept -> float;
+		[[nodiscard]] auto GetViewportExtent() const noexcept -> float;
+		auto SetViewportStart(double start) noexcept -> void;
+
+		auto AppendEstimates(std::size_t count) noexcept -> void;
+
+		[[nodiscard]] auto GetRealizationRange() const noexcept -> std::pair<std::size_t, std::size_t>;
+		auto RecycleOutside(std::size_t first, std::size_t last) noexcept -> void;
+		auto RecycleAll() noexcept -> void;
+	};
+}
@@ -6,6 +6,8 @@ export import PGUI.UI.DCompWindow;
 export import PGUI.UI.Gradient;
 export import PGUI.UI.Brush;
 export import PGUI.UI.Clip;
+export import PGUI.UI.DamageRegion;
+export import PGUI.UI.DisplayList;
 export import PGUI.UI.Font;
 export import PGUI.UI.TextFormat;
 export import PGUI.UI.TextLayout;
@@ -0,0 +1,398 @@
+export module PGUI.UI.UICore:AABBTree;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.Utils;
+
+export namespace PGUI::UI
+{
+	// Dynamic bounding volume hierarchy over rectangles.
+	// Leaves store their bounds inflated by a margin so that small moves don't touch the tree,
+	// queries report every leaf whose inflated bounds match and callers check the exact bounds.
+	// Subtrees are kept balanced with rotations so queries stay O(log n) plus the matches.
+	template <typename T>
+	class AABBTree
+	{
+		public:
+		using ProxyId = std::uint32_t;
+		static constexpr auto NullProxy = std::numeric_limits<ProxyId>::max();
+
+		explicit AABBTree(const float margin = 4.0F) noexcept :
+			margin{ margin }
+		{
+		}
+
+		[[nodiscard]] auto Size() const noexcept { return proxyCount; }
+		[[nodiscard]] auto IsEmpty() const noexcept { return proxyCount == 0; }
+		[[nodiscard]] auto GetHeight() const noexcept
+		{
+			return root == NullProxy ? 0 : nodes[root].height;
+		}
+
+		auto CreateProxy(const RectF bounds, T data) noexcept -> ProxyId
+		{
+			const auto id = AllocateNode();
+			auto& node = nodes[id];
+			node.bounds = Fatten(bounds);
+			node.data = MoveChecked(data);
+			node.height = 0;
+
+			InsertLeaf(id);
+			proxyCount++;
+
+			return id;
+		}
+
+		auto DestroyProxy(const ProxyId id) noexcept -> void
+		{
+			RemoveLeaf(id);
+			FreeNode(id);
+			proxyCount--;
+		}
+
+		// Returns false when the bounds still fit into the stored ones and the tree was left as is
+		auto MoveProxy(const ProxyId id, const RectF bounds) noexcept -> bool
+		{
+			const auto fattened = Fatten(bounds);
+			// Leaves that shrank a lot are reinserted too so they don't keep covering space they left
+			if (const auto& stored = nodes[id].bounds;
+				stored.Contains(bounds) && fattened.Inflated(3 * margin, 3 * margin).Contains(stored))
+			{
+				return false;
+			}
+
+			RemoveLeaf(id);
+			nodes[id].bounds = fattened;
+			InsertLeaf(id);
+
+			return true;
+		}
+
+		[[nodiscard]] auto GetData(const ProxyId id) const noexcept -> const T& { return nodes[id].data; }
+		[[nodiscard]] auto GetFatBounds(const ProxyId id) const noexcept { return nodes[id].bounds; }
+
+		template <std::invocable<ProxyId, const T&> Visitor>
+		auto QueryPoint(const PointF point, Visitor&& visitor) const noexcept -> void
+		{
+			Query([point](const RectF bounds) { return bounds.Contains(point); },
+			      std::forward<Visitor>(visitor));
+		}
+
+		template <std::invocable<ProxyId, const T&> Visitor>
+		auto QueryRect(const RectF rect, Visitor&& visitor) const noexcept -> void
+		{
+			Query([rect](const RectF bounds) { return Overlaps(bounds, rect); },
+			      std::forward<Visitor>(visitor));
+		}
+
+		auto Clear() noexcept -> void
+		{
+			nodes.clear();
+			root = NullProxy;
+			freeList = NullProxy;
+			proxyCount = 0;
+		}
+
+		private:
+		struct Node
+		{
+			RectF bounds;
+			T data{ };
+			// Parent while in the tree, next free node while in the free list
+			ProxyId parent = NullProxy;
+			ProxyId child1 = NullProxy;
+			ProxyId child2 = NullProxy;
+			// Leaves are 0, free nodes -1
+			int height = -1;
+
+			[[nodiscard]] auto IsLeaf() const noexcept { return child1 == NullProxy; }
+		};
+
+		std::vector<Node> nodes;
+		ProxyId root = NullProxy;
+		ProxyId freeList = NullProxy;
+		std::size_t proxyCount = 0;
+		float margin;
+
+		[[nodiscard]] static constexpr auto Union(const RectF lhs, const RectF rhs) noexcept
+		{
+			return RectF{
+				std::min(lhs.left, rhs.left),
+				std::min(lhs.top, rhs.top),
+				std::max(lhs.right, rhs.right),
+				std::max(lhs.bottom, rhs.bottom)
+			};
+		}
+		[[nodiscard]] static constexpr auto Perimeter(const RectF rect) noexcept
+		{
+			return 2.0F * (rect.Width() + rect.Height());
+		}
+		// Unlike RectF::Intersects, touching edges and empty rects count
+		[[nodiscard]] static constexpr auto Overlaps(const RectF lhs, const RectF rhs) noexcept
+		{
+			return lhs.left <= rhs.right && rhs.left <= lhs.right &&
+			       lhs.top <= rhs.bottom && rhs.top <= lhs.bottom;
+		}
+
+		[[nodiscard]] auto Fatten(const RectF bounds) const noexcept
+		{
+			return bounds.Inflated(margin, margin);
+		}
+
+		template <typename Predicate, typename Visitor>
+		auto Query(Predicate&& overlaps, Visitor&& visitor) const noexcept -> void
+		{
+			if (root == NullProxy)
+			{
+				return;
+			}
+
+			std::vector<ProxyId> stack;
+			stack.reserve(64);
+			stack.push_back(root);
+			while (!stack.empty())
+			{
+				const auto id = stack.back();
+				stack.pop_back();
+
+				const auto& node = nodes[id];
+				if (!overlaps(node.bounds))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					std::invoke(visitor, id, node.data);
+				}
+				else
+				{
+					stack.push_back(node.child1);
+					stack.push_back(node.child2);
+				}
+			}
+		}
+
+		auto AllocateNode() noexcept -> ProxyId
+		{
+			if (freeList == NullProxy)
+			{
+				nodes.emplace_back();
+				return static_cast<ProxyId>(nodes.size() - 1);
+			}
+
+			const auto id = freeList;
+			freeList = nodes[id].parent;
+			nodes[id] = Node{ };
+
+			return id;
+		}
+
+		auto FreeNode(const ProxyId id) noexcept -> void
+		{
+			nodes[id] = Node{ };
+			nodes[id].parent = freeList;
+			freeList = id;
+		}
+
+		// Walks down to the sibling that grows the total perimeter of the tree the least
+		[[nodiscard]] auto FindBestSibling(const RectF leafBounds) const noexcept -> ProxyId
+		{
+			auto index = root;
+			while (!nodes[index].IsLeaf())
+			{
+				const auto& node = nodes[index];
+				const auto perimeter = Perimeter(node.bounds);
+				const auto combinedPerimeter = Perimeter(Union(node.bounds, leafBounds));
+
+				// Making a new parent for this node and the leaf
+				const auto cost = 2.0F * combinedPerimeter;
+				// Pushing the leaf further down costs at least the growth of this node
+				const auto inheritanceCost = 2.0F * (combinedPerimeter - perimeter);
+
+				const auto descendCost = [this, leafBounds, inheritanceCost](const ProxyId child)
+				{
+					const auto& childNode = nodes[child];
+					const auto combined = Perimeter(Union(childNode.bounds, leafBounds));
+					if (childNode.IsLeaf())
+					{
+						return combined + inheritanceCost;
+					}
+					return combined - Perimeter(childNode.bounds) + inheritanceCost;
+				};
+
+				const auto cost1 = descendCost(node.child1);
+				const auto cost2 = descendCost(node.child2);
+				if (cost < cost1 && cost < cost2)
+				{
+					break;
+				}
+
+				index = cost1 < cost2 ? node.child1 : node.child2;
+			}
+
+			return index;
+		}
+
+		auto InsertLeaf(const ProxyId leaf) noexcept -> void
+		{
+			if (root == NullProxy)
+			{
+				root = leaf;
+				nodes[leaf].parent = NullProxy;
+				return;
+			}
+
+			const auto leafBounds = nodes[leaf].bounds;
+			const auto sibling = FindBestSibling(leafBounds);
+
+			const auto oldParent = nodes[sibling].parent;
+			const auto newParent = AllocateNode();
+			nodes[newParent].parent = oldParent;
+			nodes[newParent].bounds = Union(leafBounds, nodes[sibling].bounds);
+			nodes[newParent].height = nodes[sibling].height + 1;
+			nodes[newParent].child1 = sibling;
+			nodes[newParent].child2 = leaf;
+			nodes[sibling].parent = newParent;
+			nodes[leaf].parent = newParent;
+
+			if (oldParent == NullProxy)
+			{
+				root = newParent;
+			}
+			else if (nodes[oldParent].child1 == sibling)
+			{
+				nodes[oldParent].child1 = newParent;
+			}
+			else
+			{
+				nodes[oldParent].child2 = newParent;
+			}
+
+			Refit(nodes[leaf].parent);
+		}
+
+		auto RemoveLeaf(const ProxyId leaf) noexcept -> void
+		{
+			if (leaf == root)
+			{
+				root = NullProxy;
+				return;
+			}
+
+			const auto parent = nodes[leaf].parent;
+			const auto grandParent = nodes[parent].parent;
+			const auto sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+			if (grandParent == NullProxy)
+			{
+				root = sibling;
+				nodes[sibling].parent = NullProxy;
+				FreeNode(parent);
+				return;
+			}
+
+			if (nodes[grandParent].child1 == parent)
+			{
+				nodes[grandParent].child1 = sibling;
+			}
+			else
+			{
+				nodes[grandParent].child2 = sibling;
+			}
+			nodes[sibling].parent = grandParent;
+			FreeNode(parent);
+
+			Refit(grandParent);
+		}
+
+		// Rebalances and recomputes the bounds and heights from index up to the root
+		auto Refit(ProxyId index) noexcept -> void
+		{
+			while (index != NullProxy)
+			{
+				index = Balance(index);
+
+				auto& node = nodes[index];
+				const auto& child1 = nodes[node.child1];
+				const auto& child2 = nodes[node.child2];
+				node.height = 1 + std::max(child1.height, child2.height);
+				node.bounds = Union(child1.bounds, child2.bounds);
+
+				index = node.parent;
+			}
+		}
+
+		// Rotates the taller child of a up if the subtree is unbalanced, returns the new subtree root
+		auto Balance(const ProxyId a) noexcept -> ProxyId
+		{
+			if (nodes[a].IsLeaf() || nodes[a].height < 2)
+			{
+				return a;
+			}
+
+			const auto b = nodes[a].child1;
+			const auto c = nodes[a].child2;
+			const auto balance = nodes[c].height - nodes[b].height;
+
+			if (balance > 1)
+			{
+				return RotateUp(a, c, b);
+			}
+			if (balance < -1)
+			{
+				return RotateUp(a, b, c);
+			}
+
+			return a;
+		}
+
+		// Moves child up into the place of a, a takes the shorter grandchild
+		auto RotateUp(const ProxyId a, const ProxyId child, const ProxyId other) noexcept -> ProxyId
+		{
+			const auto f = nodes[child].child1;
+			const auto g = nodes[child].child2;
+
+			nodes[child].child1 = a;
+			nodes[child].parent = nodes[a].parent;
+			nodes[a].parent = child;
+
+			if (const auto parent = nodes[child].parent;
+				parent == NullProxy)
+			{
+				root = child;
+			}
+			else if (nodes[parent].child1 == a)
+			{
+				nodes[parent].child1 = child;
+			}
+			else
+			{
+				nodes[parent].child2 = child;
+			}
+
+			const auto [taller, shorter] = nodes[f].height > nodes[g].height ?
+				                               std::pair{ f, g } :
+				                               std::pair{ g, f };
+
+			nodes[child].child2 = taller;
+			if (nodes[a].child1 == child)
+			{
+				nodes[a].child1 = shorter;
+			}
+			else
+			{
+				nodes[a].child2 = shorter;
+			}
+			nodes[shorter].parent = a;
+
+			nodes[a].bounds = Union(nodes[other].bounds, nodes[shorter].bounds);
+			nodes[a].height = 1 + std::max(nodes[other].height, nodes[shorter].height);
+			nodes[child].bounds = Union(nodes[a].bounds, nodes[taller].bounds);
+			nodes[child].height = 1 + std::max(nodes[a].height, nodes[taller].height);
+
+			return child;
+		}
+	};
+}
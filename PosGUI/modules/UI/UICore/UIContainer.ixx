@@ -2,10 +2,12 @@ export module PGUI.UI.UICore:UIContainer;
 
 import :Interface;
 import :UIElement;
+import :AABBTree;
 import PGUI.Event;
 import PGUI.ErrorHandling;
 import PGUI.UI.Layout;
 import PGUI.Utils;
+import PGUI.WorkStealingPool;
 
 import std;
 
@@ -13,10 +15,16 @@ export namespace PGUI::UI
 {
 	class UIContainer final : public UIElement
 	{
+		friend UIElement;
+
+		using SpatialIndex = AABBTree<RawUIElementPtr<>>;
+
 		struct ChildAssociatedData
 		{
-			CallbackId zIndexCallbackId;
 			CallbackId redrawRequestCallbackId;
+			// Slot in subtreeSizes, grows with the position in children, higher is drawn later
+			std::size_t order = 0;
+			SpatialIndex::ProxyId proxyId = SpatialIndex::NullProxy;
 		};
 
 		public:
@@ -26,6 +34,7 @@ export namespace PGUI::UI
 		auto CreateChildElement(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
 			-> Result<RawUIElementPtr<T>>
 		{
+			UIElementPropertyStore::Scope storeScope{ propertyStore };
 			auto element = std::make_unique<T>(std::forward<Args>(args)...);
 			auto elementPtr = element.get();
 			if (elementPtr == nullptr)
@@ -75,14 +84,28 @@ export namespace PGUI::UI
 		auto RemoveChildElement(std::size_t index) -> Result<UIElementPtr<>>;
 
 		[[nodiscard]] auto GetElementIndex(RawUIElementPtr<> element) const noexcept -> Result<std::size_t>;
-		[[nodiscard]] auto GetElementLinearIndex(RawUIElementPtr<> element) const noexcept -> Result<std::size_t>;
 
 		[[nodiscard]] auto GetElementAtIndex(std::size_t index) const noexcept -> Result<RawUIElementPtr<>>;
 
+		// Linear indices number every element below this container in pre-order,
+		// a nested container comes right before its own elements.
+		// Subtree sizes are kept up to date as elements are added and removed,
+		// so lookups are O(depth * log(children)).
+		[[nodiscard]] auto GetElementLinearIndex(RawUIElementPtr<> element) const noexcept -> Result<std::size_t>;
 		[[nodiscard]] auto GetLinearElementCount() const noexcept -> std::size_t;
 		[[nodiscard]] auto GetElementAtLinearIndex(std::size_t index) const noexcept -> Result<RawUIElementPtr<>>;
 
 		[[nodiscard]] auto GetElementAtPosition(PointF point) const noexcept -> Result<RawUIElementPtr<>>;
+		// Children whose bounds overlap rect, in drawing order
+		[[nodiscard]] auto GetChildElementsInRect(RectF rect) const noexcept -> std::vector<RawUIElementPtr<>>;
+
+		// Keeps the children in an AABB tree so point and rect queries only visit the children
+		// around the query instead of all of them, worth it for containers with many children.
+		// Hit testing through the index assumes children are only hit inside their bounds.
+		auto EnableSpatialIndex(bool enable) noexcept -> void;
+		[[nodiscard]] auto IsSpatialIndexEnabled() const noexcept { return spatialIndex.has_value(); }
+		// Called for children that change their geometry without UIElement's setters
+		auto UpdateChildBounds(RawUIElementPtr<> element) noexcept -> void;
 
 		auto IsChildElementVisible(RawUIElementPtr<> element) const noexcept -> bool;
 
@@ -94,9 +117,26 @@ export namespace PGUI::UI
 
 		auto Render(const Graphics&) noexcept -> void override;
 		auto HitTest(PointF point) noexcept -> bool override;
+		[[nodiscard]] auto AsContainer() noexcept -> RawUIContainerPtr<> override { return this; }
 		auto CreateDeviceResources() noexcept -> void override;
 		auto DiscardDeviceResources() noexcept -> void override;
 
+		// The host brings the panel up to date through UpdateLayout once per frame, before painting
+		auto SetLayoutPanel(std::unique_ptr<Layout::LayoutPanel> panel) noexcept -> void;
+		template <typename Self>
+		[[nodiscard]] auto&& GetLayoutPanel(this Self&& self) noexcept
+		{
+			return std::forward_like<Self>(self.layoutPanel);
+		}
+		// Opts the panel into the parallel layout pass, nullptr goes back to the serial one
+		auto SetLayoutPool(WorkStealingPool* pool) noexcept
+		{
+			layoutPool = pool;
+		}
+		[[nodiscard]] auto GetLayoutPool() const noexcept { return layoutPool; }
+		// Runs the dirty layout panels in this subtree, clean subtrees are skipped
+		auto UpdateLayout() noexcept -> void;
+
 		template <typename Self>
 		[[nodiscard]] auto&& ChildAddedEvent(this Self&& self) noexcept
 		{
@@ -112,17 +152,39 @@ export namespace PGUI::UI
 		private:
 		auto OnChildAddedEvent(RawUIElementPtr<> element) noexcept -> void;
 		auto OnChildRemovedEvent(RawUIElementPtr<> element) noexcept -> void;
-		auto OnChildZIndexChangedEvent(RawUIElementPtr<> element, ZIndex newZIndex) noexcept -> void;
-		auto OnChildRedrawRequestedEvent(RawUIElementPtr<> element) noexcept -> void;
+		// Called by the child itself, like UpdateChildBounds, so children don't need a z-index observer each
+		auto OnChildZIndexChanged(RawUIElementPtr<> element) noexcept -> void;
+		auto OnChildRedrawRequestedEvent(RawUIElementPtr<> element, RectF area) noexcept -> void;
 
 		auto EnsureZOrder() noexcept -> void;
+		// Marks this container and its ancestors until one that is already marked
+		auto MarkLayoutPending() noexcept -> void;
+		// Drops the slots of removed children, renumbering the rest
+		auto CompactSlots() noexcept -> void;
+		// Adds delta to the size of this container's subtree in every container above it
+		auto PropagateSubtreeSizeChange(std::ptrdiff_t delta) noexcept -> void;
+		// Candidates from the index that really contain point, topmost first
+		[[nodiscard]] auto GetIndexedChildrenAt(PointF point) const noexcept -> std::vector<RawUIElementPtr<>>;
 
 		bool clipRendering = false;
 		bool isZOrderDirty = false;
+		// A layout panel in this subtree waits for UpdateLayout
+		bool isLayoutPending = false;
+		std::reference_wrapper<UIElementPropertyStore> propertyStore{ UIElementPropertyStore::Current() };
 		Event<RawUIElementPtr<>> childAdded;
 		Event<RawUIElementPtr<>> childRemoved;
 		std::vector<UIElementPtr<>> children;
 		std::unordered_map<RawUIElementPtr<>, ChildAssociatedData> childAssociatedData;
+		std::optional<SpatialIndex> spatialIndex;
+		// Children by slot, removed children leave a null slot behind until the next compaction
+		std::vector<RawUIElementPtr<>> childSlots;
+		// Per slot, 1 plus the linear element count for containers, 0 for null slots
+		FenwickTree<std::size_t> subtreeSizes;
+		// Per slot, 1 if a child is in it, so positions in children are prefix sums
+		FenwickTree<std::size_t> occupiedSlots;
+		std::size_t freeSlotCount = 0;
 		std::unique_ptr<Layout::LayoutPanel> layoutPanel;
+		WorkStealingPool* layoutPool = nullptr;
+		CallbackId layoutInvalidatedCallbackId{ };
 	};
 }
@@ -1,6 +1,7 @@
 export module PGUI.UI.UICore;
 
 export import :UIEvent;
+export import :AABBTree;
 export import :UIElement;
 export import :UIContainer;
 export import :UIHost;
\ No newline at end of file
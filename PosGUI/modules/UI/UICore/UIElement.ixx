@@ -14,6 +14,7 @@ import PGUI.ErrorHandling;
 import PGUI.Shape;
 import PGUI.Event;
 import PGUI.UI.Graphics;
+import PGUI.UI.DisplayList;
 
 export namespace PGUI::UI
 {
@@ -30,6 +31,54 @@ export namespace PGUI::UI
 		// ReSharper restore CppUseAutoForNumeric
 	}
 
+	// Holds the per element state of UIElement in shared tables instead of inside every element.
+	// Elements take their slots from the store current at construction,
+	// that is the innermost Scope on the thread or a default store of the thread.
+	// Elements have to be destroyed on the thread of their store and before it,
+	// debug builds terminate otherwise.
+	class UIElementPropertyStore
+	{
+		public:
+		class Scope
+		{
+			public:
+			explicit Scope(UIElementPropertyStore& store) noexcept;
+			~Scope() noexcept;
+
+			Scope(const Scope&) = delete;
+			Scope(Scope&&) = delete;
+			auto operator=(const Scope&) -> Scope& = delete;
+			auto operator=(Scope&&) -> Scope& = delete;
+
+			private:
+			UIElementPropertyStore* previous;
+		};
+
+		UIElementPropertyStore() noexcept = default;
+
+		UIElementPropertyStore(const UIElementPropertyStore&) = delete;
+		UIElementPropertyStore(UIElementPropertyStore&&) = delete;
+		auto operator=(const UIElementPropertyStore&) -> UIElementPropertyStore& = delete;
+		auto operator=(UIElementPropertyStore&&) -> UIElementPropertyStore& = delete;
+
+		~UIElementPropertyStore() noexcept;
+
+		[[nodiscard]] static auto Current() noexcept -> UIElementPropertyStore&;
+
+		[[nodiscard]] auto GetElementCount() const noexcept { return zIndices.GetSize(); }
+
+		// Table storage only, the handles inside each element are reported by GetHandleBytesPerElement
+		[[nodiscard]] auto GetMemoryUsage() const noexcept -> DataBinding::PropertyTableMemoryUsage;
+		[[nodiscard]] static constexpr auto GetHandleBytesPerElement() noexcept
+		{
+			return sizeof(DataBinding::StoredProperty<ZIndex>) + 2 * sizeof(DataBinding::StoredProperty<bool>);
+		}
+
+		DataBinding::PropertyTable<ZIndex> zIndices;
+		DataBinding::PropertyTable<bool> enabledStates;
+		DataBinding::PropertyTable<bool> focusStates;
+	};
+
 	class UIElement
 	{
 		friend UIHost;
@@ -76,10 +125,10 @@ export namespace PGUI::UI
 		{
 			return std::forward_like<Self>(self.hasFocus);
 		}
-		template <typename Self>
-		[[nodiscard]] auto&& ZIndexEvent(this Self&& self) noexcept
+		// Read only, a new z-index has to go through SetZIndex so the parent can reorder
+		[[nodiscard]] auto ZIndexEvent() const noexcept
 		{
-			return std::forward_like<Self>(self.zIndex);
+			return DataBinding::StoredPropertyView<ZIndex>{ zIndex };
 		}
 
 		[[nodiscard]] virtual auto GetRect() const noexcept -> RectF
@@ -94,27 +143,54 @@ export namespace PGUI::UI
 		{
 			return rect.TopLeft();
 		}
+		// Overrides that don't call these have to report their geometry
+		// changes with UIContainer::UpdateChildBounds
 		virtual auto MoveAndResize(const RectF newRect) noexcept -> void
 		{
-			rect = newRect;
+			SetRect(newRect);
 		}
 		virtual auto MoveAndResize(const PointF point, const SizeF size) noexcept -> void
 		{
-			rect = RectF{ point, size };
+			SetRect(RectF{ point, size });
 		}
 		virtual auto Move(const PointF point) noexcept -> void
 		{
-			rect = RectF{ point, GetSize() };
+			SetRect(RectF{ point, GetSize() });
 		}
 		virtual auto Resize(const SizeF size) noexcept -> void
 		{
-			rect = RectF{ GetPosition(), size };
+			SetRect(RectF{ GetPosition(), size });
+		}
+
+		// Non null when the element is a container
+		[[nodiscard]] virtual auto AsContainer() noexcept -> RawUIContainerPtr<>
+		{
+			return nullptr;
 		}
 
 		virtual auto Render(const Graphics&) noexcept -> void
 		{
 			/*  */
 		}
+		// Elements that draw the same thing until they request a redraw can record it here and return true,
+		// containers then replay the list instead of calling Render until the next RequestRedraw.
+		// Brushes and text layouts used must outlive the recording, changing them has to request a redraw
+		virtual auto RecordDisplayList(DisplayList&) noexcept -> bool
+		{
+			return false;
+		}
+		// Null until the element has recorded a list that is still valid
+		[[nodiscard]] auto GetDisplayList() const noexcept -> const DisplayList*
+		{
+			return isDisplayListValid ? displayList.get() : nullptr;
+		}
+		// Raised by RequestRedraw with the area to repaint. The parent container clips the area to itself
+		// and raises its own event, the host handles the event of the root container
+		template <typename Self>
+		[[nodiscard]] auto&& RedrawRequestedEvent(this Self&& self) noexcept
+		{
+			return std::forward_like<Self>(self.redrawRequestedEvent);
+		}
 		virtual auto HitTest(const PointF point) noexcept -> bool
 		{
 			return rect.Contains(point);
@@ -142,27 +218,40 @@ export namespace PGUI::UI
 		auto AllowFocus() noexcept { canHaveFocus = true; }
 		auto DisallowFocus() noexcept;
 
-		auto SetZIndex(const ZIndex value) noexcept { zIndex.Set(value); }
+		auto SetZIndex(ZIndex value) noexcept -> void;
 
 		auto SetTabStop(const bool value) noexcept { isTabStop = value; }
 
+		// Repaints the whole element
 		auto RequestRedraw() noexcept -> void;
-
-		template <typename Self>
-		[[nodiscard]] auto&& RedrawRequestedEvent(this Self&& self) noexcept
-		{
-			return std::forward_like<Self>(self.redrawRequestedEvent);
-		}
+		// Repaints only area, for changes that don't touch the rest of the element
+		auto RequestRedraw(RectF area) noexcept -> void;
 
 		private:
 		RectF rect;
 		bool isTabStop = false;
 		bool canHaveFocus = false;
-		Event<RawUIElementPtr<>> redrawRequestedEvent;
-		DataBinding::PropertyNM<ZIndex> zIndex{ ZIndices::Normal };
-		DataBinding::PropertyNM<bool> isEnabled{ true };
-		DataBinding::PropertyNM<bool> hasFocus{ false };
+		// Requesting element and the area to repaint
+		EventSnapshot<RawUIElementPtr<>, RectF> redrawRequestedEvent;
+		DataBinding::StoredProperty<ZIndex> zIndex{ UIElementPropertyStore::Current().zIndices, ZIndices::Normal };
+		DataBinding::StoredProperty<bool> isEnabled{ UIElementPropertyStore::Current().enabledStates, true };
+		DataBinding::StoredProperty<bool> hasFocus{ UIElementPropertyStore::Current().focusStates, false };
 		RawUIElementPtr<> parent = nullptr;
 		RawUIHostPtr<> host = nullptr;
+		std::unique_ptr<DisplayList> displayList;
+		bool isDisplayListValid = false;
+
+		auto SetRect(const RectF newRect) noexcept -> void
+		{
+			if (rect != newRect)
+			{
+				OnRectChanged(std::exchange(rect, newRect));
+			}
+		}
+		auto OnRectChanged(RectF oldRect) noexcept -> void;
+
+		// Replays the recorded list, recording it first if needed, or renders elements that don't record
+		auto RenderCached(const Graphics& graphics) noexcept -> void;
+		auto InvalidateDisplayList() noexcept -> void { isDisplayListValid = false; }
 	};
 }
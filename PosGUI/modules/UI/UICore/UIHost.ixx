@@ -4,6 +4,7 @@ import :Interface;
 import :UIElement;
 import :UIContainer;
 import PGUI.UI.DCompWindow;
+import PGUI.UI.DamageRegion;
 import PGUI.Shape;
 import PGUI.Window;
 import PGUI.WindowClass;
@@ -30,6 +31,12 @@ export namespace PGUI::UI
 			return std::forward_like<Self>(self.rootContainer);
 		}
 
+		template <typename Self>
+		[[nodiscard]] auto&& PropertyStore(this Self&& self) noexcept
+		{
+			return std::forward_like<Self>(self.propertyStore);
+		}
+
 		template <typename Self>
 		[[nodiscard]] auto&& HoveredElement(this Self&& self) noexcept
 		{
@@ -42,6 +49,11 @@ export namespace PGUI::UI
 			return std::forward_like<Self>(self.focusedElement);
 		}
 
+		// Area the next frame repaints, the rest of the window keeps its previous contents
+		[[nodiscard]] auto GetPendingDamage() const noexcept -> const DamageRegion& { return pendingDamage; }
+		// Repaints the whole window on the next frame
+		auto InvalidateAll() noexcept -> void;
+
 		protected:
 		virtual auto Render(const Graphics&) noexcept -> void
 		{
@@ -51,6 +63,8 @@ export namespace PGUI::UI
 		auto CreateDeviceResources() -> void override;
 		auto DiscardDeviceResources() -> void override;
 
+		auto BeginDraw() -> void override;
+
 		private:
 		auto OnNCCreate(MessageID msg, Argument1 arg1, Argument2 arg2) noexcept -> MessageHandlerResult;
 		auto OnSize(MessageID msg, Argument1 arg1, Argument2 arg2) noexcept -> MessageHandlerResult;
@@ -67,13 +81,20 @@ export namespace PGUI::UI
 		auto OnMouseButtonUp(MessageID msg, Argument1 arg1, Argument2 arg2) noexcept -> MessageHandlerResult;
 		auto OnMouseDoubleClick(MessageID msg, Argument1 arg1, Argument2 arg2) noexcept -> MessageHandlerResult;
 
-		auto RedrawRequested(RawUIElementPtr<> element) noexcept -> void;
+		auto RedrawRequested(RawUIElementPtr<> element, RectF area) noexcept -> void;
+
+		auto AddSystemDamage() noexcept -> void;
 
 		auto Draw(const Graphics& graphics) noexcept -> void final;
 
-		Event<RawUIElementPtr<>> redrawRequestedEvent;
+		EventSnapshot<RawUIElementPtr<>, RectF> redrawRequestedEvent;
+		DamageRegion pendingDamage;
+		// The back buffer holds the frame before the last one, its damage is repainted again
+		DamageRegion previousDamage;
+		bool repaintAll = true;
 		RawUIElementPtr<> hoveredElement;
 		RawUIElementPtr<> focusedElement;
+		UIElementPropertyStore propertyStore;
 		UIContainerPtr<> rootContainer;
 	};
 }
@@ -0,0 +1,159 @@
+export module PGUI.Utils:FenwickTree;
+
+import std;
+
+export namespace PGUI
+{
+	// Binary indexed tree over a sequence of values.
+	// Point updates, prefix sums and searching by prefix sum are all O(log n).
+	// Values are stored as given, with floating point types the sums pick up the rounding
+	// of every update, so prefer double when the values are floats.
+	template <typename T> requires std::is_arithmetic_v<T>
+	class FenwickTree
+	{
+		public:
+		FenwickTree() noexcept = default;
+
+		explicit FenwickTree(const std::span<const T> initialValues) noexcept :
+			values{ initialValues.begin(), initialValues.end() }
+		{
+			Rebuild();
+		}
+
+		FenwickTree(const std::size_t count, const T value) noexcept :
+			values(count, value)
+		{
+			Rebuild();
+		}
+
+		[[nodiscard]] auto Size() const noexcept { return values.size(); }
+		[[nodiscard]] auto IsEmpty() const noexcept { return values.empty(); }
+
+		[[nodiscard]] auto Get(const std::size_t index) const noexcept -> T
+		{
+			return values[index];
+		}
+
+		auto Add(const std::size_t index, const T delta) noexcept -> void
+		{
+			values[index] += delta;
+			AddToTree(index, delta);
+		}
+
+		// The value is kept exactly, only the sums above it are updated by the difference
+		auto Set(const std::size_t index, const T value) noexcept -> void
+		{
+			const auto delta = value - values[index];
+			values[index] = value;
+			AddToTree(index, delta);
+		}
+
+		// Sum of the first count values
+		[[nodiscard]] auto PrefixSum(std::size_t count) const noexcept -> T
+		{
+			count = std::min(count, tree.size());
+
+			T sum{ };
+			for (auto i = count; i > 0; i -= LowestBit(i))
+			{
+				sum += tree[i - 1];
+			}
+			return sum;
+		}
+
+		[[nodiscard]] auto RangeSum(const std::size_t first, const std::size_t last) const noexcept -> T
+		{
+			return PrefixSum(last) - PrefixSum(first);
+		}
+
+		[[nodiscard]] auto Total() const noexcept -> T
+		{
+			return PrefixSum(tree.size());
+		}
+
+		// Index of the value covering target when the values are laid end to end,
+		// that is the first index whose prefix sum including itself exceeds target.
+		// Returns Size() if target is past the total. Requires non negative values.
+		[[nodiscard]] auto FindByPrefixSum(T target) const noexcept -> std::size_t
+		{
+			std::size_t position = 0;
+			for (auto step = std::bit_floor(tree.size()); step != 0; step /= 2)
+			{
+				if (const auto next = position + step;
+					next <= tree.size() && tree[next - 1] <= target)
+				{
+					position = next;
+					target -= tree[next - 1];
+				}
+			}
+
+			return position;
+		}
+
+		auto PushBack(const T value) noexcept -> void
+		{
+			values.push_back(value);
+
+			const auto i = values.size();
+			auto node = value;
+			for (auto child = i - 1; child > i - LowestBit(i); child -= LowestBit(child))
+			{
+				node += tree[child - 1];
+			}
+			tree.push_back(node);
+		}
+
+		auto Resize(const std::size_t count, const T value = T{ }) noexcept -> void
+		{
+			if (count <= values.size())
+			{
+				values.resize(count);
+				tree.resize(count);
+				return;
+			}
+
+			values.reserve(count);
+			tree.reserve(count);
+			while (values.size() < count)
+			{
+				PushBack(value);
+			}
+		}
+
+		auto Clear() noexcept -> void
+		{
+			values.clear();
+			tree.clear();
+		}
+
+		private:
+		std::vector<T> values;
+		std::vector<T> tree;
+
+		[[nodiscard]] static constexpr auto LowestBit(const std::size_t i) noexcept
+		{
+			return i & (~i + 1);
+		}
+
+		auto AddToTree(const std::size_t index, const T delta) noexcept -> void
+		{
+			for (auto i = index + 1; i <= tree.size(); i += LowestBit(i))
+			{
+				tree[i - 1] += delta;
+			}
+		}
+
+		auto Rebuild() noexcept -> void
+		{
+			tree = values;
+			for (std::size_t i = 1; i <= tree.size(); i++)
+			{
+				if (const auto parent = i + LowestBit(i);
+					parent <= tree.size())
+				{
+					tree[parent - 1] += tree[i - 1];
+				}
+			}
+		}
+	};
+}
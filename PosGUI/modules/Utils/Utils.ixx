@@ -8,6 +8,7 @@ export import :ArithmeticUtils;
 export import :EnumUtils;
 export import :MetaUtils;
 export import :HashUtils;
+export import :FenwickTree;
 
 import PGUI.Mutex;
 
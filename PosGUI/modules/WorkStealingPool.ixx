@@ -0,0 +1,88 @@
+export module PGUI.WorkStealingPool;
+
+import std;
+
+export namespace PGUI
+{
+	// Fork join pool where every worker owns a deque of tasks.
+	// Workers take their own newest tasks first and steal the oldest tasks of the others
+	// when they run dry, tasks submitted from outside go to a shared queue.
+	class WorkStealingPool
+	{
+		public:
+		using Task = std::move_only_function<void()>;
+
+		explicit WorkStealingPool(std::size_t workerCount = DefaultWorkerCount()) noexcept;
+
+		~WorkStealingPool() noexcept;
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool(WorkStealingPool&&) = delete;
+		auto operator=(const WorkStealingPool&) -> WorkStealingPool& = delete;
+		auto operator=(WorkStealingPool&&) -> WorkStealingPool& = delete;
+
+		[[nodiscard]] static auto Default() noexcept -> WorkStealingPool&;
+		[[nodiscard]] static auto DefaultWorkerCount() noexcept -> std::size_t;
+
+		auto Submit(Task&& task) noexcept -> void;
+
+		// Runs one queued task on the calling thread, returns false if there was none
+		auto RunPendingTask() noexcept -> bool;
+
+		[[nodiscard]] auto GetWorkerCount() const noexcept { return workers.size(); }
+
+		private:
+		friend class TaskGroup;
+
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		// One queue per worker followed by the shared one
+		std::vector<std::unique_ptr<TaskQueue>> queues;
+		std::atomic<std::size_t> queuedCount = 0;
+		std::mutex sleepMutex;
+		std::condition_variable_any taskAvailable;
+		std::vector<std::jthread> workers;
+
+		[[nodiscard]] auto GetSharedQueueIndex() const noexcept { return queues.size() - 1; }
+		[[nodiscard]] auto GetCurrentQueueIndex() const noexcept -> std::size_t;
+
+		[[nodiscard]] auto TryPop(std::size_t queueIndex) noexcept -> std::optional<Task>;
+		auto WorkerLoop(std::size_t queueIndex, const std::stop_token& stopToken) noexcept -> void;
+
+		// Sleeps until a task is queued or the count of the group reaches zero
+		auto WaitForTaskOrGroup(const std::atomic<std::size_t>& pendingCount) noexcept -> void;
+		auto NotifyGroupFinished() noexcept -> void;
+	};
+
+	// Tasks that are started together and waited for together.
+	// The waiting thread runs queued tasks in the meantime, so groups can be nested inside tasks.
+	class TaskGroup
+	{
+		public:
+		explicit TaskGroup(WorkStealingPool& pool) noexcept :
+			pool{ pool }
+		{
+		}
+
+		~TaskGroup() noexcept
+		{
+			Wait();
+		}
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup(TaskGroup&&) = delete;
+		auto operator=(const TaskGroup&) -> TaskGroup& = delete;
+		auto operator=(TaskGroup&&) -> TaskGroup& = delete;
+
+		auto Run(WorkStealingPool::Task&& task) noexcept -> void;
+		auto Wait() noexcept -> void;
+
+		private:
+		std::reference_wrapper<WorkStealingPool> pool;
+		std::atomic<std::size_t> pendingCount = 0;
+	};
+}
@@ -0,0 +1,152 @@
+module PGUI.DataBinding.PropagationScheduler;
+
+import std;
+
+namespace PGUI::DataBinding
+{
+	namespace
+	{
+		struct RankGreater
+		{
+			auto operator()(const PropagationNode* lhs, const PropagationNode* rhs) const noexcept
+			{
+				return lhs->GetRank() > rhs->GetRank();
+			}
+		};
+
+		struct SchedulerState
+		{
+			std::size_t scopeDepth = 0;
+			bool draining = false;
+			std::vector<PropagationNode*> dirtyHeap;
+			std::unordered_set<const PropagationNode*> dirtyNodes;
+			std::vector<PropagationNode*> pendingPublish;
+		};
+
+		thread_local SchedulerState schedulerState;
+	}
+
+	PropagationNode::PropagationNode(const std::size_t rank) noexcept :
+		rank{ rank }
+	{
+	}
+
+	PropagationNode::~PropagationNode() noexcept
+	{
+		PropagationScheduler::Cancel(*this);
+	}
+
+	auto PropagationNode::HasDependents() const noexcept -> bool
+	{
+		std::scoped_lock lock{ dependentsMutex };
+		return !dependents.empty();
+	}
+
+	auto PropagationNode::AddDependent(PropagationNode& dependent) noexcept -> void
+	{
+		std::scoped_lock lock{ dependentsMutex };
+		dependents.push_back(&dependent);
+	}
+
+	auto PropagationNode::RemoveDependent(PropagationNode& dependent) noexcept -> void
+	{
+		std::scoped_lock lock{ dependentsMutex };
+		std::erase(dependents, &dependent);
+	}
+
+	auto PropagationScheduler::MarkDirty(PropagationNode& node) noexcept -> void
+	{
+		Enqueue(node);
+
+		if (schedulerState.scopeDepth == 0)
+		{
+			Drain();
+		}
+	}
+
+	auto PropagationScheduler::MarkDependentsDirty(const PropagationNode& node) noexcept -> void
+	{
+		std::scoped_lock lock{ node.dependentsMutex };
+		for (auto* dependent : node.dependents)
+		{
+			Enqueue(*dependent);
+		}
+	}
+
+	auto PropagationScheduler::Cancel(const PropagationNode& node) noexcept -> void
+	{
+		auto& state = schedulerState;
+
+		if (state.dirtyNodes.erase(&node) != 0)
+		{
+			std::erase(state.dirtyHeap, &node);
+			std::ranges::make_heap(state.dirtyHeap, RankGreater{ });
+		}
+		std::ranges::replace(state.pendingPublish, &node, nullptr);
+	}
+
+	auto PropagationScheduler::Enqueue(PropagationNode& node) noexcept -> void
+	{
+		auto& state = schedulerState;
+
+		if (state.dirtyNodes.insert(&node).second)
+		{
+			state.dirtyHeap.push_back(&node);
+			std::ranges::push_heap(state.dirtyHeap, RankGreater{ });
+		}
+	}
+
+	auto PropagationScheduler::Drain() noexcept -> void
+	{
+		auto& state = schedulerState;
+		if (state.draining)
+		{
+			return;
+		}
+		state.draining = true;
+
+		// Observers may change other properties while being notified, those start the next wave
+		while (!state.dirtyHeap.empty())
+		{
+			while (!state.dirtyHeap.empty())
+			{
+				std::ranges::pop_heap(state.dirtyHeap, RankGreater{ });
+				auto* node = state.dirtyHeap.back();
+				state.dirtyHeap.pop_back();
+				state.dirtyNodes.erase(node);
+
+				if (node->RecomputeValue())
+				{
+					state.pendingPublish.push_back(node);
+					MarkDependentsDirty(*node);
+				}
+			}
+
+			// Indexed since publishing may cancel nodes that are destroyed by an observer
+			for (std::size_t i = 0; i < state.pendingPublish.size(); i++)
+			{
+				if (auto* node = state.pendingPublish[i];
+					node != nullptr)
+				{
+					node->PublishValue();
+				}
+			}
+			state.pendingPublish.clear();
+		}
+
+		state.draining = false;
+	}
+
+	PropagationScope::PropagationScope() noexcept
+	{
+		schedulerState.scopeDepth++;
+	}
+
+	PropagationScope::~PropagationScope() noexcept
+	{
+		if (--schedulerState.scopeDepth == 0)
+		{
+			PropagationScheduler::Drain();
+		}
+	}
+}
@@ -0,0 +1,115 @@
+module PGUI.DataBinding.PropertyTransaction;
+
+import std;
+
+import PGUI.DataBinding.PropagationScheduler;
+
+namespace PGUI::DataBinding
+{
+	namespace
+	{
+		struct PendingNotification
+		{
+			const void* key;
+			PropertyTransaction::Notifier notifier;
+		};
+
+		struct TransactionState
+		{
+			std::size_t depth = 0;
+			bool committing = false;
+			std::vector<PendingNotification> pending;
+			std::unordered_set<const void*> pendingKeys;
+		};
+
+		thread_local TransactionState transactionState;
+	}
+
+	PropertyTransaction::PropertyTransaction() noexcept
+	{
+		transactionState.depth++;
+	}
+
+	PropertyTransaction::~PropertyTransaction() noexcept
+	{
+		Commit();
+	}
+
+	auto PropertyTransaction::Commit() noexcept -> void
+	{
+		if (committed)
+		{
+			return;
+		}
+		committed = true;
+
+		if (--transactionState.depth == 0)
+		{
+			Flush();
+		}
+	}
+
+	auto PropertyTransaction::IsActive() noexcept -> bool
+	{
+		return transactionState.depth != 0 && !transactionState.committing;
+	}
+
+	auto PropertyTransaction::Defer(const void* key, Notifier&& notifier) noexcept -> bool
+	{
+		if (!IsActive())
+		{
+			return false;
+		}
+
+		auto& state = transactionState;
+		if (state.pendingKeys.insert(key).second)
+		{
+			state.pending.emplace_back(key, std::move(notifier));
+		}
+
+		return true;
+	}
+
+	auto PropertyTransaction::Cancel(const void* key) noexcept -> void
+	{
+		auto& state = transactionState;
+		if (state.pendingKeys.erase(key) == 0)
+		{
+			return;
+		}
+
+		for (auto& [pendingKey, notifier] : state.pending)
+		{
+			if (pendingKey == key)
+			{
+				notifier = nullptr;
+			}
+		}
+	}
+
+	auto PropertyTransaction::Flush() noexcept -> void
+	{
+		auto& state = transactionState;
+		state.committing = true;
+
+		{
+			// Dependent recomputation runs once, after every deferred notification
+			PropagationScope scope;
+
+			// Indexed since a notification may destroy a property that is still pending
+			for (std::size_t i = 0; i < state.pending.size(); i++)
+			{
+				auto notifier = std::move(state.pending[i].notifier);
+				if (notifier)
+				{
+					state.pendingKeys.erase(state.pending[i].key);
+					notifier();
+				}
+			}
+			state.pending.clear();
+			state.pendingKeys.clear();
+		}
+
+		state.committing = false;
+	}
+}
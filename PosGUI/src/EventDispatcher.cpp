@@ -0,0 +1,223 @@
+module PGUI.EventDispatcher;
+
+import std;
+
+import PGUI.Utils;
+
+namespace PGUI
+{
+	namespace
+	{
+		thread_local const EventDispatcher* currentDispatcher = nullptr;
+	}
+
+	EventDispatcher::EventDispatcher(
+		const std::size_t workerCount,
+		const std::size_t queueCapacity,
+		const OverflowPolicy overflowPolicy,
+		const std::chrono::microseconds backpressureTimeout) noexcept :
+		queueCapacity{ std::max(queueCapacity, std::size_t{ 1 }) },
+		overflowPolicy{ overflowPolicy },
+		backpressureTimeout{ backpressureTimeout }
+	{
+		const auto count = std::max(workerCount, std::size_t{ 1 });
+		workers.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			workers.emplace_back([this](const std::stop_token& stopToken)
+			{
+				WorkerLoop(stopToken);
+			});
+		}
+	}
+
+	EventDispatcher::~EventDispatcher() noexcept
+	{
+		for (auto& worker : workers)
+		{
+			worker.request_stop();
+		}
+		taskAvailable.notify_all();
+		spaceAvailable.notify_all();
+		workers.clear();
+	}
+
+	auto EventDispatcher::Default() noexcept -> EventDispatcher&
+	{
+		static EventDispatcher dispatcher;
+		return dispatcher;
+	}
+
+	auto EventDispatcher::DefaultWorkerCount() noexcept -> std::size_t
+	{
+		return std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+	}
+
+	auto EventDispatcher::NewDispatchKey() noexcept -> DispatchKey
+	{
+		static std::atomic<DispatchKey> nextKey = NoDispatchKey + 1;
+		return nextKey.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	auto EventDispatcher::TryPost(Task& task) noexcept -> bool
+	{
+		{
+			std::scoped_lock lock{ mutex };
+			if (queue.size() >= queueCapacity)
+			{
+				return false;
+			}
+			queue.emplace_back(NoDispatchKey, MoveChecked(task));
+		}
+		taskAvailable.notify_one();
+
+		return true;
+	}
+
+	auto EventDispatcher::Post(Task&& task) noexcept -> PostResult
+	{
+		Task dropped;
+		auto result = PostResult::Queued;
+		{
+			std::unique_lock lock{ mutex };
+			result = MakeRoom(lock, dropped);
+			if (result == PostResult::Rejected)
+			{
+				return result;
+			}
+			queue.emplace_back(NoDispatchKey, MoveChecked(task));
+		}
+		taskAvailable.notify_one();
+
+		return result;
+	}
+
+	auto EventDispatcher::PostCoalesced(const DispatchKey key, Task&& task) noexcept -> PostResult
+	{
+		if (key == NoDispatchKey)
+		{
+			return Post(MoveChecked(task));
+		}
+
+		Task dropped;
+		auto result = PostResult::Queued;
+		{
+			std::unique_lock lock{ mutex };
+			if (const auto iter = coalescedSequences.find(key);
+				iter != coalescedSequences.end())
+			{
+				// Destroy the replaced task outside the lock
+				[[maybe_unused]] auto replaced = std::exchange(queue[iter->second - headSequence].task, MoveChecked(task));
+				lock.unlock();
+				return PostResult::Coalesced;
+			}
+
+			result = MakeRoom(lock, dropped);
+			if (result == PostResult::Rejected)
+			{
+				return result;
+			}
+			// Waiting for room released the lock, a task with the same key may have been queued meanwhile
+			if (const auto iter = coalescedSequences.find(key);
+				iter != coalescedSequences.end())
+			{
+				[[maybe_unused]] auto replaced = std::exchange(queue[iter->second - headSequence].task, MoveChecked(task));
+				lock.unlock();
+				return PostResult::Coalesced;
+			}
+
+			coalescedSequences.emplace(key, headSequence + queue.size());
+			queue.emplace_back(key, MoveChecked(task));
+		}
+		taskAvailable.notify_one();
+
+		return result;
+	}
+
+	auto EventDispatcher::GetPendingCount() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return queue.size();
+	}
+
+	auto EventDispatcher::GetDroppedCount() const noexcept -> std::size_t
+	{
+		std::scoped_lock lock{ mutex };
+		return droppedCount;
+	}
+
+	auto EventDispatcher::MakeRoom(std::unique_lock<std::mutex>& lock, Task& dropped) noexcept -> PostResult
+	{
+		if (queue.size() < queueCapacity)
+		{
+			return PostResult::Queued;
+		}
+
+		switch (overflowPolicy)
+		{
+			case OverflowPolicy::DropOldest:
+			{
+				dropped = PopFront();
+				droppedCount++;
+				return PostResult::DroppedOldest;
+			}
+			case OverflowPolicy::Wait:
+			{
+				// A worker waiting for room in its own queue could be the one that has to make it
+				if (currentDispatcher != this &&
+				    spaceAvailable.wait_for(lock, backpressureTimeout, [this] { return queue.size() < queueCapacity; }))
+				{
+					return PostResult::Queued;
+				}
+				break;
+			}
+			case OverflowPolicy::Reject:
+			{
+				break;
+			}
+		}
+
+		droppedCount++;
+		return PostResult::Rejected;
+	}
+
+	auto EventDispatcher::WorkerLoop(const std::stop_token& stopToken) noexcept -> void
+	{
+		currentDispatcher = this;
+
+		while (true)
+		{
+			Task task;
+			auto wasFull = false;
+			{
+				std::unique_lock lock{ mutex };
+				if (!taskAvailable.wait(lock, stopToken, [this] { return !queue.empty(); }))
+				{
+					return;
+				}
+				wasFull = queue.size() == queueCapacity;
+				task = PopFront();
+			}
+			if (wasFull)
+			{
+				spaceAvailable.notify_one();
+			}
+
+			task();
+		}
+	}
+
+	auto EventDispatcher::PopFront() noexcept -> Task
+	{
+		auto [key, task] = MoveChecked(queue.front());
+		queue.pop_front();
+
+		if (key != NoDispatchKey)
+		{
+			coalescedSequences.erase(key);
+		}
+		headSequence++;
+
+		return MoveChecked(task);
+	}
+}
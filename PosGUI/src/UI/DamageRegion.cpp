@@ -0,0 +1,144 @@
+module PGUI.UI.DamageRegion;
+
+import std;
+
+import PGUI.Shape;
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		[[nodiscard]] constexpr auto Union(const RectF lhs, const RectF rhs) noexcept
+		{
+			return RectF{
+				std::min(lhs.left, rhs.left),
+				std::min(lhs.top, rhs.top),
+				std::max(lhs.right, rhs.right),
+				std::max(lhs.bottom, rhs.bottom)
+			};
+		}
+	}
+
+	auto DamageRegion::Add(RectF rect) noexcept -> void
+	{
+		if (rect.Width() <= 0 || rect.Height() <= 0)
+		{
+			return;
+		}
+
+		// A merged rect can reach rects the original didn't, so keep going until nothing touches it
+		for (auto merged = true; merged; )
+		{
+			merged = false;
+			for (auto it = rects.begin(); it != rects.end(); )
+			{
+				if (it->Contains(rect))
+				{
+					return;
+				}
+				// Rects lined up along an edge merge without covering anything new
+				if (it->Intersects(rect) || Union(*it, rect).Area() <= it->Area() + rect.Area())
+				{
+					rect = Union(rect, *it);
+					it = rects.erase(it);
+					merged = true;
+					continue;
+				}
+				++it;
+			}
+		}
+
+		rects.push_back(rect);
+		while (rects.size() > maxRects)
+		{
+			MergeCheapestPair();
+		}
+	}
+
+	auto DamageRegion::Add(const DamageRegion& other) noexcept -> void
+	{
+		for (const auto rect : other.rects)
+		{
+			Add(rect);
+		}
+	}
+
+	auto DamageRegion::GetBounds() const noexcept -> RectF
+	{
+		if (rects.empty())
+		{
+			return RectF{ };
+		}
+
+		auto bounds = rects.front();
+		for (const auto rect : rects | std::views::drop(1))
+		{
+			bounds = Union(bounds, rect);
+		}
+
+		return bounds;
+	}
+
+	auto DamageRegion::GetArea() const noexcept -> float
+	{
+		auto area = 0.0F;
+		for (const auto rect : rects)
+		{
+			area += rect.Area();
+		}
+
+		return area;
+	}
+
+	auto DamageRegion::Intersects(const RectF rect) const noexcept -> bool
+	{
+		return std::ranges::any_of(
+			rects,
+			[rect](const RectF damaged) { return damaged.Intersects(rect); });
+	}
+
+	auto DamageRegion::ClipTo(const RectF bounds) noexcept -> void
+	{
+		std::erase_if(
+			rects,
+			[bounds](RectF& rect)
+			{
+				const auto clipped = rect.IntersectionRect(bounds);
+				if (!clipped.has_value())
+				{
+					return true;
+				}
+				rect = *clipped;
+				return false;
+			});
+	}
+
+	auto DamageRegion::MergeCheapestPair() noexcept -> void
+	{
+		auto bestFirst = 0ULL;
+		auto bestSecond = 1ULL;
+		auto bestWaste = std::numeric_limits<float>::max();
+
+		for (const auto first : std::views::iota(0ULL, rects.size()))
+		{
+			for (const auto second : std::views::iota(first + 1, rects.size()))
+			{
+				const auto waste = Union(rects[first], rects[second]).Area() -
+				                   rects[first].Area() - rects[second].Area();
+				if (waste < bestWaste)
+				{
+					bestWaste = waste;
+					bestFirst = first;
+					bestSecond = second;
+				}
+			}
+		}
+
+		const auto merged = Union(rects[bestFirst], rects[bestSecond]);
+		rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestSecond));
+		rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestFirst));
+
+		// The union can cover other rects now, adding it again restores the invariant
+		Add(merged);
+	}
+}
@@ -0,0 +1,117 @@
+module PGUI.UI.DisplayList;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.UI.Brush;
+import PGUI.UI.TextLayout;
+import PGUI.UI.D2D.D2DEnums;
+
+namespace PGUI::UI
+{
+	namespace
+	{
+		// Elements reuse a handful of brushes, searching from the back finds the last one used first
+		template <typename T>
+		[[nodiscard]] auto FindOrAppend(std::vector<const T*>& resources, const T& resource) noexcept
+		{
+			for (auto index = resources.size(); index > 0; index--)
+			{
+				if (resources[index - 1] == &resource)
+				{
+					return static_cast<std::uint32_t>(index - 1);
+				}
+			}
+
+			resources.push_back(&resource);
+			return static_cast<std::uint32_t>(resources.size() - 1);
+		}
+	}
+
+	auto DisplayList::FillRectangle(const RectF rect, const Brush& brush) noexcept -> void
+	{
+		Write(Command::FillRectangle, ShapeData{ rect, GetBrushIndex(brush) });
+	}
+
+	auto DisplayList::DrawRectangle(const RectF rect, const Brush& brush, const float strokeWidth) noexcept -> void
+	{
+		Write(Command::DrawRectangle, StrokeData{ rect, GetBrushIndex(brush), strokeWidth });
+	}
+
+	auto DisplayList::FillRoundedRectangle(const RoundedRect rect, const Brush& brush) noexcept -> void
+	{
+		Write(Command::FillRoundedRectangle, ShapeData{ rect, GetBrushIndex(brush) });
+	}
+
+	auto DisplayList::DrawRoundedRectangle(
+		const RoundedRect rect, const Brush& brush, const float strokeWidth) noexcept -> void
+	{
+		Write(Command::DrawRoundedRectangle, StrokeData{ rect, GetBrushIndex(brush), strokeWidth });
+	}
+
+	auto DisplayList::FillEllipse(const Ellipse ellipse, const Brush& brush) noexcept -> void
+	{
+		Write(Command::FillEllipse, ShapeData{ ellipse, GetBrushIndex(brush) });
+	}
+
+	auto DisplayList::DrawEllipse(const Ellipse ellipse, const Brush& brush, const float strokeWidth) noexcept -> void
+	{
+		Write(Command::DrawEllipse, StrokeData{ ellipse, GetBrushIndex(brush), strokeWidth });
+	}
+
+	auto DisplayList::DrawLine(
+		const PointF p1, const PointF p2, const Brush& brush, const float strokeWidth) noexcept -> void
+	{
+		Write(Command::DrawLine, LineData{ p1, p2, GetBrushIndex(brush), strokeWidth });
+	}
+
+	auto DisplayList::DrawText(const TextLayout& layout, const PointF origin, const Brush& brush) noexcept -> void
+	{
+		Write(Command::DrawText, TextData{ origin, GetTextLayoutIndex(layout), GetBrushIndex(brush) });
+	}
+
+	auto DisplayList::PushAxisAlignedClip(
+		const RectF clipRect, const D2D::AntiAliasingMode antiAliasingMode) noexcept -> void
+	{
+		Write(Command::PushAxisAlignedClip, ClipData{ clipRect, antiAliasingMode });
+	}
+
+	auto DisplayList::PopAxisAlignedClip() noexcept -> void
+	{
+		Write(Command::PopAxisAlignedClip);
+	}
+
+	auto DisplayList::PushTransform(const Matrix3x2& transform) noexcept -> void
+	{
+		Write(Command::PushTransform, transform);
+	}
+
+	auto DisplayList::PopTransform() noexcept -> void
+	{
+		Write(Command::PopTransform);
+	}
+
+	auto DisplayList::Clear() noexcept -> void
+	{
+		commands.clear();
+		brushes.clear();
+		textLayouts.clear();
+		commandCount = 0;
+	}
+
+	auto DisplayList::Write(const Command command) noexcept -> void
+	{
+		commands.push_back(static_cast<std::byte>(command));
+		commandCount++;
+	}
+
+	auto DisplayList::GetBrushIndex(const Brush& brush) noexcept -> ResourceIndex
+	{
+		return FindOrAppend(brushes, brush);
+	}
+
+	auto DisplayList::GetTextLayoutIndex(const TextLayout& layout) noexcept -> ResourceIndex
+	{
+		return FindOrAppend(textLayouts, layout);
+	}
+}
@@ -3,15 +3,50 @@ module;
 
 module PGUI.UI.Graphics;
 
+import std;
+
 import PGUI.ComPtr;
+import PGUI.Shape;
 import PGUI.UI.D2D.DeviceContext;
+import PGUI.UI.D2D.D2DEnums;
 
 namespace PGUI::UI
 {
+	namespace
+	{
+		// Bounds of the transformed corners, Direct2D clips a transformed axis aligned clip the same way
+		[[nodiscard]] constexpr auto TransformBounds(const RectF rect, const Matrix3x2& transform) noexcept
+		{
+			if (transform.IsIdentity())
+			{
+				return rect;
+			}
+
+			const std::array corners{
+				transform.Transform(rect.TopLeft()),
+				transform.Transform(PointF{ rect.right, rect.top }),
+				transform.Transform(PointF{ rect.left, rect.bottom }),
+				transform.Transform(rect.BottomRight())
+			};
+
+			auto bounds = RectF{ corners[0].x, corners[0].y, corners[0].x, corners[0].y };
+			for (const auto corner : corners)
+			{
+				bounds.left = std::min(bounds.left, corner.x);
+				bounds.top = std::min(bounds.top, corner.y);
+				bounds.right = std::max(bounds.right, corner.x);
+				bounds.bottom = std::max(bounds.bottom, corner.y);
+			}
+
+			return bounds;
+		}
+	}
+
 	Graphics::Graphics(const ComPtr<ID2D1DeviceContext7>& deviceContext) noexcept :
 		DeviceContext{ deviceContext }
 	{
 		transformStack.reserve(8);
+		clipStack.reserve(8);
 	}
 
 	auto Graphics::PushTransform(const Matrix3x2& transform) const -> void
@@ -33,4 +68,77 @@ namespace PGUI::UI
 		SetTransform(transform);
 		transformStack.pop_back();
 	}
+
+	auto Graphics::SetTransform(const Matrix3x2& transform) const noexcept -> void
+	{
+		worldTransform = transform;
+		DeviceContext::SetTransform(transform);
+	}
+
+	auto Graphics::GetTransform() const noexcept -> Matrix3x2
+	{
+		if (!worldTransform.has_value())
+		{
+			worldTransform = DeviceContext::GetTransform();
+		}
+
+		return *worldTransform;
+	}
+
+	auto Graphics::PushAxisAlignedClip(const RectF clipRect, const D2D::AntiAliasingMode antiAliasingMode) const noexcept -> void
+	{
+		auto visibleBounds = GetVisibleBounds();
+		if (visibleBounds.has_value())
+		{
+			visibleBounds = visibleBounds->IntersectionRect(TransformBounds(clipRect, GetTransform()));
+		}
+		clipStack.push_back(visibleBounds);
+
+		DeviceContext::PushAxisAlignedClip(clipRect, antiAliasingMode);
+	}
+
+	auto Graphics::PopAxisAlignedClip() const noexcept -> void
+	{
+		if (!clipStack.empty())
+		{
+			clipStack.pop_back();
+		}
+
+		DeviceContext::PopAxisAlignedClip();
+	}
+
+	auto Graphics::GetVisibleBounds() const noexcept -> std::optional<RectF>
+	{
+		if (!clipStack.empty())
+		{
+			return clipStack.back();
+		}
+
+		// Size in DIPs is read here since the DPI is set after construction
+		return RectF{ PointF{ }, GetSize() };
+	}
+
+	auto Graphics::GetLocalVisibleBounds() const noexcept -> std::optional<RectF>
+	{
+		const auto visibleBounds = GetVisibleBounds();
+		if (!visibleBounds.has_value())
+		{
+			return std::nullopt;
+		}
+
+		// A transform that collapses everything to a line or a point makes nothing visible
+		const auto inverse = GetTransform().Inverted();
+		if (!inverse.has_value())
+		{
+			return std::nullopt;
+		}
+
+		return TransformBounds(*visibleBounds, *inverse);
+	}
+
+	auto Graphics::IsVisible(const RectF rect) const noexcept -> bool
+	{
+		const auto visibleBounds = GetVisibleBounds();
+		return visibleBounds.has_value() && visibleBounds->Intersects(TransformBounds(rect, GetTransform()));
+	}
 }
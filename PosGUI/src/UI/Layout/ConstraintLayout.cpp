@@ -0,0 +1,219 @@
+module PGUI.UI.Layout.ConstraintLayout;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+
+namespace PGUI::UI::Layout
+{
+	ConstraintLayout::ConstraintLayout(const RectF bounds) noexcept :
+		LayoutPanel{ bounds }
+	{
+		Unused(solver.AddConstraint(Constraint::Equal(panelAnchors.left, 0.0)));
+		Unused(solver.AddConstraint(Constraint::Equal(panelAnchors.top, 0.0)));
+		Unused(solver.AddEditVariable(panelAnchors.width, Strength::Strong));
+		Unused(solver.AddEditVariable(panelAnchors.height, Strength::Strong));
+	}
+
+	auto ConstraintLayout::RearrangeItems() noexcept -> void
+	{
+		// Only values that changed since the last pass are suggested, the rest of the tableau stays solved
+		const auto size = GetSize();
+		if (suggestedPanelSize != size)
+		{
+			if (const auto result = solver.SuggestValue(panelAnchors.width, size.cx).and_then(
+				[this, size]
+				{
+					return solver.SuggestValue(panelAnchors.height, size.cy);
+				}); !result.has_value())
+			{
+				Logger::Error(result.error(), L"Failed to suggest the panel size");
+			}
+			suggestedPanelSize = size;
+		}
+
+		for (auto&& [index, entry] : std::views::enumerate(itemEntries))
+		{
+			const auto desiredSize = MeasureItem(static_cast<std::size_t>(index), size);
+			if (entry.suggestedSize == desiredSize)
+			{
+				continue;
+			}
+
+			if (const auto result = solver.SuggestValue(entry.anchors.width, desiredSize.cx).and_then(
+				[this, &entry, desiredSize]
+				{
+					return solver.SuggestValue(entry.anchors.height, desiredSize.cy);
+				}); !result.has_value())
+			{
+				Logger::Error(result.error(), L"Failed to suggest the size of an item");
+			}
+			entry.suggestedSize = desiredSize;
+		}
+
+		solver.UpdateVariables();
+
+		for (const auto& [item, entry] : std::views::zip(GetItems(), itemEntries))
+		{
+			const auto& [left, top, width, height] = entry.anchors;
+			ArrangeItem(
+				item,
+				RectF{
+					PointF{ static_cast<float>(left.GetValue()), static_cast<float>(top.GetValue()) },
+					SizeF{ static_cast<float>(width.GetValue()), static_cast<float>(height.GetValue()) }
+				});
+		}
+	}
+
+	auto ConstraintLayout::GetItemAnchors(const std::size_t index) const noexcept -> Result<LayoutAnchors>
+	{
+		if (index >= itemEntries.size())
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Given index is out of range") };
+		}
+
+		return itemEntries[index].anchors;
+	}
+
+	auto ConstraintLayout::GetItemAnchors(const LayoutItem& item) const noexcept -> Result<LayoutAnchors>
+	{
+		const auto result = GetItemIndex(item);
+		if (result.has_value())
+		{
+			return GetItemAnchors(*result);
+		}
+
+		return Unexpected{ result.error() };
+	}
+
+	auto ConstraintLayout::AddConstraint(const Constraint& constraint) noexcept -> Result<void>
+	{
+		if (const auto result = solver.AddConstraint(constraint);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		userConstraints.push_back(constraint);
+		InvalidateArrange();
+
+		return EmptyResult;
+	}
+
+	auto ConstraintLayout::RemoveConstraint(const Constraint& constraint) noexcept -> Result<void>
+	{
+		if (const auto result = solver.RemoveConstraint(constraint);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		std::erase(userConstraints, constraint);
+		InvalidateArrange();
+
+		return EmptyResult;
+	}
+
+	auto ConstraintLayout::AddEditVariable(const Variable& variable, const double strength) noexcept -> Result<void>
+	{
+		if (const auto result = solver.AddEditVariable(variable, strength);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		userEditVariables.push_back(variable);
+
+		return EmptyResult;
+	}
+
+	auto ConstraintLayout::RemoveEditVariable(const Variable& variable) noexcept -> Result<void>
+	{
+		if (const auto result = solver.RemoveEditVariable(variable);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		std::erase(userEditVariables, variable);
+		InvalidateArrange();
+
+		return EmptyResult;
+	}
+
+	auto ConstraintLayout::SuggestValue(const Variable& variable, const double value) noexcept -> Result<void>
+	{
+		if (const auto result = solver.SuggestValue(variable, value);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		InvalidateArrange();
+
+		return EmptyResult;
+	}
+
+	auto ConstraintLayout::OnItemAdded(const LayoutItem& item) -> void
+	{
+		LayoutAnchors anchors;
+		auto& entry = itemEntries.emplace_back(
+			anchors,
+			std::array{
+				Constraint::GreaterOrEqual(anchors.width, 0.0),
+				Constraint::GreaterOrEqual(anchors.height, 0.0)
+			},
+			std::nullopt);
+
+		for (const auto& constraint : entry.nonNegativeSize)
+		{
+			Unused(solver.AddConstraint(constraint));
+		}
+		Unused(solver.AddEditVariable(anchors.width, Strength::Weak));
+		Unused(solver.AddEditVariable(anchors.height, Strength::Weak));
+
+		LayoutPanel::OnItemAdded(item);
+	}
+
+	auto ConstraintLayout::OnItemRemoved(const std::size_t index) -> void
+	{
+		if (index < itemEntries.size())
+		{
+			const auto& [anchors, nonNegativeSize, suggestedSize] = itemEntries[index];
+			const auto isAnchor = [&anchors](const Variable& variable)
+			{
+				return variable == anchors.left || variable == anchors.top ||
+				       variable == anchors.width || variable == anchors.height;
+			};
+			const auto referencesItem = [&anchors](const Constraint& constraint)
+			{
+				return constraint.References(anchors.left) || constraint.References(anchors.top) ||
+				       constraint.References(anchors.width) || constraint.References(anchors.height);
+			};
+
+			for (const auto& constraint : userConstraints | std::views::filter(referencesItem))
+			{
+				Unused(solver.RemoveConstraint(constraint));
+			}
+			std::erase_if(userConstraints, referencesItem);
+
+			for (const auto& variable : userEditVariables | std::views::filter(isAnchor))
+			{
+				Unused(solver.RemoveEditVariable(variable));
+			}
+			std::erase_if(userEditVariables, isAnchor);
+
+			for (const auto& constraint : nonNegativeSize)
+			{
+				Unused(solver.RemoveConstraint(constraint));
+			}
+			Unused(solver.RemoveEditVariable(anchors.width));
+			Unused(solver.RemoveEditVariable(anchors.height));
+
+			itemEntries.erase(itemEntries.begin() + static_cast<std::ptrdiff_t>(index));
+		}
+
+		LayoutPanel::OnItemRemoved(index);
+	}
+}
@@ -0,0 +1,777 @@
+module PGUI.UI.Layout.ConstraintSolver;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+
+namespace PGUI::UI::Layout
+{
+	namespace
+	{
+		[[nodiscard]] auto IsNearZero(const double value) noexcept
+		{
+			constexpr auto epsilon = 1.0e-8;
+			return std::abs(value) < epsilon;
+		}
+	}
+
+	Constraint::Constraint(
+		Expression expression,
+		const RelationalOperator relation,
+		const double strength) noexcept
+	{
+		// Terms of the same variable are folded so the solver sees each variable once
+		Expression reduced{ expression.constant };
+		for (const auto& term : expression.terms)
+		{
+			if (const auto iter = std::ranges::find(reduced.terms, term.variable, &Term::variable);
+				iter != reduced.terms.end())
+			{
+				iter->coefficient += term.coefficient;
+				continue;
+			}
+			reduced.terms.push_back(term);
+		}
+
+		data = std::make_shared<const Data>(
+			MoveChecked(reduced), relation, std::clamp(strength, 0.0, Strength::Required));
+	}
+
+	auto Constraint::References(const Variable& variable) const noexcept -> bool
+	{
+		return std::ranges::contains(data->expression.terms, variable, &Term::variable);
+	}
+
+	auto ConstraintSolver::Row::Add(const double value) noexcept -> double
+	{
+		constant += value;
+		return constant;
+	}
+
+	auto ConstraintSolver::Row::Insert(const Symbol symbol, const double coefficient) noexcept -> void
+	{
+		if (const auto value = cells[symbol] += coefficient;
+			IsNearZero(value))
+		{
+			cells.erase(symbol);
+		}
+	}
+
+	auto ConstraintSolver::Row::Insert(const Row& other, const double coefficient) noexcept -> void
+	{
+		constant += other.constant * coefficient;
+		for (const auto& [symbol, value] : other.cells)
+		{
+			Insert(symbol, value * coefficient);
+		}
+	}
+
+	auto ConstraintSolver::Row::Remove(const Symbol symbol) noexcept -> void
+	{
+		cells.erase(symbol);
+	}
+
+	auto ConstraintSolver::Row::ReverseSign() noexcept -> void
+	{
+		constant = -constant;
+		for (auto& value : cells | std::views::values)
+		{
+			value = -value;
+		}
+	}
+
+	auto ConstraintSolver::Row::SolveFor(const Symbol symbol) noexcept -> void
+	{
+		const auto iter = cells.find(symbol);
+		const auto coefficient = -1.0 / iter->second;
+		cells.erase(iter);
+
+		constant *= coefficient;
+		for (auto& value : cells | std::views::values)
+		{
+			value *= coefficient;
+		}
+	}
+
+	auto ConstraintSolver::Row::SolveFor(const Symbol lhs, const Symbol rhs) noexcept -> void
+	{
+		Insert(lhs, -1.0);
+		SolveFor(rhs);
+	}
+
+	auto ConstraintSolver::Row::CoefficientFor(const Symbol symbol) const noexcept -> double
+	{
+		const auto iter = cells.find(symbol);
+		return iter != cells.end() ? iter->second : 0.0;
+	}
+
+	auto ConstraintSolver::Row::Substitute(const Symbol symbol, const Row& row) noexcept -> void
+	{
+		if (const auto iter = cells.find(symbol);
+			iter != cells.end())
+		{
+			const auto coefficient = iter->second;
+			cells.erase(iter);
+			Insert(row, coefficient);
+		}
+	}
+
+	auto ConstraintSolver::AddConstraint(const Constraint& constraint) noexcept -> Result<void>
+	{
+		if (HasConstraint(constraint))
+		{
+			return Unexpected{ Error{ ErrorCode::DuplicateEntry }.SuggestFix(L"Constraint is already added") };
+		}
+
+		Tag tag;
+		auto row = CreateRow(constraint, tag);
+		auto subject = ChooseSubject(row, tag);
+
+		// A row made of dummies only is either redundant or contradicts the required constraints
+		if (!subject.IsValid() && AllDummies(row))
+		{
+			if (!IsNearZero(row.GetConstant()))
+			{
+				ReleaseVariables(constraint, false);
+				return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Constraint is unsatisfiable") };
+			}
+			subject = tag.marker;
+		}
+
+		if (!subject.IsValid())
+		{
+			// The pivots tried for a rejected constraint are undone by restoring the tableau as it was
+			auto savedRows = rows;
+			auto savedObjective = objective;
+
+			const auto added = AddWithArtificialVariable(row);
+			if (!added.has_value() || !*added)
+			{
+				rows = MoveChecked(savedRows);
+				objective = MoveChecked(savedObjective);
+				objective.Remove(tag.marker);
+				objective.Remove(tag.other);
+				infeasibleRows.clear();
+				ReleaseVariables(constraint, false);
+
+				if (!added.has_value())
+				{
+					return Unexpected{ added.error() };
+				}
+				return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Constraint is unsatisfiable") };
+			}
+		}
+		else
+		{
+			row.SolveFor(subject);
+			Substitute(subject, row);
+			rows.insert_or_assign(subject, MoveChecked(row));
+		}
+
+		constraints.insert_or_assign(constraint.GetId(), ConstraintEntry{ constraint, tag });
+		RetainVariables(constraint);
+
+		return Optimize(objective);
+	}
+
+	auto ConstraintSolver::RemoveConstraint(const Constraint& constraint) noexcept -> Result<void>
+	{
+		const auto entryIter = constraints.find(constraint.GetId());
+		if (entryIter == constraints.end())
+		{
+			return Unexpected{ Error{ ErrorCode::NotFound }.SuggestFix(L"Constraint was not added") };
+		}
+
+		const auto tag = entryIter->second.tag;
+		constraints.erase(entryIter);
+
+		RemoveConstraintEffects(constraint, tag);
+
+		if (!rows.erase(tag.marker))
+		{
+			const auto leavingIter = GetMarkerLeavingRow(tag.marker);
+			if (leavingIter == rows.end())
+			{
+				ReleaseVariables(constraint, true);
+				return Unexpected{ Error{ ErrorCode::Failure }.SuggestFix(L"Failed to find a leaving row") };
+			}
+
+			const auto leaving = leavingIter->first;
+			auto row = MoveChecked(leavingIter->second);
+			rows.erase(leavingIter);
+
+			row.SolveFor(leaving, tag.marker);
+			Substitute(tag.marker, row);
+		}
+		ReleaseVariables(constraint, true);
+
+		return Optimize(objective);
+	}
+
+	auto ConstraintSolver::HasConstraint(const Constraint& constraint) const noexcept -> bool
+	{
+		return constraints.contains(constraint.GetId());
+	}
+
+	auto ConstraintSolver::AddEditVariable(const Variable& variable, double strength) noexcept -> Result<void>
+	{
+		if (HasEditVariable(variable))
+		{
+			return Unexpected{ Error{ ErrorCode::DuplicateEntry }.SuggestFix(L"Variable is already an edit variable") };
+		}
+
+		strength = std::clamp(strength, 0.0, Strength::Required);
+		if (strength == Strength::Required)
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Edit variables cannot be required") };
+		}
+
+		const Constraint constraint{ Expression{ variable }, RelationalOperator::Equal, strength };
+		if (const auto result = AddConstraint(constraint);
+			!result.has_value())
+		{
+			return result;
+		}
+
+		edits.insert_or_assign(
+			variable.GetId(),
+			EditEntry{ variable, constraint, constraints.at(constraint.GetId()).tag, 0.0 });
+
+		return EmptyResult;
+	}
+
+	auto ConstraintSolver::RemoveEditVariable(const Variable& variable) noexcept -> Result<void>
+	{
+		const auto iter = edits.find(variable.GetId());
+		if (iter == edits.end())
+		{
+			return Unexpected{ Error{ ErrorCode::NotFound }.SuggestFix(L"Variable is not an edit variable") };
+		}
+
+		const auto constraint = iter->second.constraint;
+		edits.erase(iter);
+
+		return RemoveConstraint(constraint);
+	}
+
+	auto ConstraintSolver::HasEditVariable(const Variable& variable) const noexcept -> bool
+	{
+		return edits.contains(variable.GetId());
+	}
+
+	auto ConstraintSolver::SuggestValue(const Variable& variable, const double value) noexcept -> Result<void>
+	{
+		const auto iter = edits.find(variable.GetId());
+		if (iter == edits.end())
+		{
+			return Unexpected{ Error{ ErrorCode::NotFound }.SuggestFix(L"Variable is not an edit variable") };
+		}
+
+		auto& edit = iter->second;
+		const auto delta = value - edit.constant;
+		edit.constant = value;
+
+		// Only the rows the error variables of the edit appear in change,
+		// the ones that become infeasible are repaired by the dual simplex below
+		if (const auto rowIter = rows.find(edit.tag.marker);
+			rowIter != rows.end())
+		{
+			if (rowIter->second.Add(-delta) < 0.0)
+			{
+				infeasibleRows.push_back(rowIter->first);
+			}
+			return DualOptimize();
+		}
+		if (const auto rowIter = rows.find(edit.tag.other);
+			rowIter != rows.end())
+		{
+			if (rowIter->second.Add(delta) < 0.0)
+			{
+				infeasibleRows.push_back(rowIter->first);
+			}
+			return DualOptimize();
+		}
+
+		for (auto& [symbol, row] : rows)
+		{
+			if (const auto coefficient = row.CoefficientFor(edit.tag.marker);
+				coefficient != 0.0 && row.Add(delta * coefficient) < 0.0 && symbol.type != SymbolType::External)
+			{
+				infeasibleRows.push_back(symbol);
+			}
+		}
+
+		return DualOptimize();
+	}
+
+	auto ConstraintSolver::UpdateVariables() const noexcept -> void
+	{
+		for (const auto& [variable, symbol, constraintCount] : variables | std::views::values)
+		{
+			const auto iter = rows.find(symbol);
+			variable.SetValue(iter != rows.end() ? iter->second.GetConstant() : 0.0);
+		}
+	}
+
+	auto ConstraintSolver::Reset() noexcept -> void
+	{
+		rows.clear();
+		variables.clear();
+		constraints.clear();
+		edits.clear();
+		infeasibleRows.clear();
+		objective = Row{ };
+		artificial.reset();
+		nextSymbolId = 1;
+	}
+
+	auto ConstraintSolver::MakeSymbol(const SymbolType type) noexcept -> Symbol
+	{
+		return Symbol{ nextSymbolId++, type };
+	}
+
+	auto ConstraintSolver::GetVariableSymbol(const Variable& variable) noexcept -> Symbol
+	{
+		if (const auto iter = variables.find(variable.GetId());
+			iter != variables.end())
+		{
+			return iter->second.symbol;
+		}
+
+		const auto symbol = MakeSymbol(SymbolType::External);
+		variables.emplace(variable.GetId(), VariableEntry{ variable, symbol });
+
+		return symbol;
+	}
+
+	auto ConstraintSolver::CreateRow(const Constraint& constraint, Tag& tag) noexcept -> Row
+	{
+		const auto& expression = constraint.GetExpression();
+		Row row{ expression.constant };
+
+		// Basic variables are replaced by their rows so the new row only has parametric symbols
+		for (const auto& [variable, coefficient] : expression.terms)
+		{
+			if (IsNearZero(coefficient))
+			{
+				continue;
+			}
+
+			const auto symbol = GetVariableSymbol(variable);
+			if (const auto iter = rows.find(symbol);
+				iter != rows.end())
+			{
+				row.Insert(iter->second, coefficient);
+			}
+			else
+			{
+				row.Insert(symbol, coefficient);
+			}
+		}
+
+		const auto strength = constraint.GetStrength();
+		switch (constraint.GetRelation())
+		{
+			case RelationalOperator::LessOrEqual:
+			case RelationalOperator::GreaterOrEqual:
+			{
+				const auto coefficient = constraint.GetRelation() == RelationalOperator::LessOrEqual ? 1.0 : -1.0;
+				const auto slack = MakeSymbol(SymbolType::Slack);
+				tag.marker = slack;
+				row.Insert(slack, coefficient);
+
+				if (strength < Strength::Required)
+				{
+					const auto error = MakeSymbol(SymbolType::Error);
+					tag.other = error;
+					row.Insert(error, -coefficient);
+					objective.Insert(error, strength);
+				}
+				break;
+			}
+			case RelationalOperator::Equal:
+			{
+				if (strength < Strength::Required)
+				{
+					const auto errorPlus = MakeSymbol(SymbolType::Error);
+					const auto errorMinus = MakeSymbol(SymbolType::Error);
+					tag.marker = errorPlus;
+					tag.other = errorMinus;
+					row.Insert(errorPlus, -1.0);
+					row.Insert(errorMinus, 1.0);
+					objective.Insert(errorPlus, strength);
+					objective.Insert(errorMinus, strength);
+				}
+				else
+				{
+					const auto dummy = MakeSymbol(SymbolType::Dummy);
+					tag.marker = dummy;
+					row.Insert(dummy);
+				}
+				break;
+			}
+		}
+
+		if (row.GetConstant() < 0.0)
+		{
+			row.ReverseSign();
+		}
+
+		return row;
+	}
+
+	auto ConstraintSolver::ChooseSubject(const Row& row, const Tag& tag) noexcept -> Symbol
+	{
+		for (const auto& symbol : row.GetCells() | std::views::keys)
+		{
+			if (symbol.type == SymbolType::External)
+			{
+				return symbol;
+			}
+		}
+
+		for (const auto symbol : { tag.marker, tag.other })
+		{
+			if ((symbol.type == SymbolType::Slack || symbol.type == SymbolType::Error) &&
+			    row.CoefficientFor(symbol) < 0.0)
+			{
+				return symbol;
+			}
+		}
+
+		return Symbol{ };
+	}
+
+	auto ConstraintSolver::AddWithArtificialVariable(const Row& row) noexcept -> Result<bool>
+	{
+		// The artificial variable starts basic with the row and is driven to zero
+		const auto artificialSymbol = MakeSymbol(SymbolType::Slack);
+		rows.insert_or_assign(artificialSymbol, row);
+		artificial = row;
+
+		const auto result = Optimize(*artificial);
+		const auto isSatisfiable = IsNearZero(artificial->GetConstant());
+		artificial.reset();
+
+		if (!result.has_value())
+		{
+			return Unexpected{ result.error() };
+		}
+
+		if (!isSatisfiable)
+		{
+			return false;
+		}
+
+		if (const auto iter = rows.find(artificialSymbol);
+			iter != rows.end())
+		{
+			auto basicRow = MoveChecked(iter->second);
+			rows.erase(iter);
+
+			if (basicRow.GetCells().empty())
+			{
+				return true;
+			}
+
+			const auto entering = GetAnyPivotableSymbol(basicRow);
+			if (!entering.IsValid())
+			{
+				return false;
+			}
+
+			basicRow.SolveFor(artificialSymbol, entering);
+			Substitute(entering, basicRow);
+			rows.insert_or_assign(entering, MoveChecked(basicRow));
+		}
+
+		for (auto& basicRow : rows | std::views::values)
+		{
+			basicRow.Remove(artificialSymbol);
+		}
+		objective.Remove(artificialSymbol);
+
+		return true;
+	}
+
+	auto ConstraintSolver::Substitute(const Symbol symbol, const Row& row) noexcept -> void
+	{
+		for (auto& [basic, basicRow] : rows)
+		{
+			basicRow.Substitute(symbol, row);
+			if (basic.type != SymbolType::External && basicRow.GetConstant() < 0.0)
+			{
+				infeasibleRows.push_back(basic);
+			}
+		}
+
+		objective.Substitute(symbol, row);
+		if (artificial.has_value())
+		{
+			artificial->Substitute(symbol, row);
+		}
+	}
+
+	auto ConstraintSolver::Optimize(const Row& objectiveRow) noexcept -> Result<void>
+	{
+		while (true)
+		{
+			const auto entering = GetEnteringSymbol(objectiveRow);
+			if (!entering.IsValid())
+			{
+				return EmptyResult;
+			}
+
+			const auto leavingIter = GetLeavingRow(entering);
+			if (leavingIter == rows.end())
+			{
+				return Unexpected{ Error{ ErrorCode::Failure }.SuggestFix(L"The objective is unbounded") };
+			}
+
+			const auto leaving = leavingIter->first;
+			auto row = MoveChecked(leavingIter->second);
+			rows.erase(leavingIter);
+
+			row.SolveFor(leaving, entering);
+			Substitute(entering, row);
+			rows.insert_or_assign(entering, MoveChecked(row));
+		}
+	}
+
+	auto ConstraintSolver::DualOptimize() noexcept -> Result<void>
+	{
+		while (!infeasibleRows.empty())
+		{
+			const auto leaving = infeasibleRows.back();
+			infeasibleRows.pop_back();
+
+			const auto iter = rows.find(leaving);
+			if (iter == rows.end() ||
+			    IsNearZero(iter->second.GetConstant()) || iter->second.GetConstant() >= 0.0)
+			{
+				continue;
+			}
+
+			const auto entering = GetDualEnteringSymbol(iter->second);
+			if (!entering.IsValid())
+			{
+				infeasibleRows.clear();
+				return Unexpected{ Error{ ErrorCode::Failure }.SuggestFix(L"Dual optimization failed") };
+			}
+
+			auto row = MoveChecked(iter->second);
+			rows.erase(iter);
+
+			row.SolveFor(leaving, entering);
+			Substitute(entering, row);
+			rows.insert_or_assign(entering, MoveChecked(row));
+		}
+
+		return EmptyResult;
+	}
+
+	auto ConstraintSolver::GetEnteringSymbol(const Row& objectiveRow) noexcept -> Symbol
+	{
+		for (const auto& [symbol, coefficient] : objectiveRow.GetCells())
+		{
+			if (symbol.type != SymbolType::Dummy && coefficient < 0.0)
+			{
+				return symbol;
+			}
+		}
+
+		return Symbol{ };
+	}
+
+	auto ConstraintSolver::GetDualEnteringSymbol(const Row& row) const noexcept -> Symbol
+	{
+		Symbol entering;
+		auto ratio = std::numeric_limits<double>::max();
+		for (const auto& [symbol, coefficient] : row.GetCells())
+		{
+			if (coefficient > 0.0 && symbol.type != SymbolType::Dummy)
+			{
+				if (const auto candidate = objective.CoefficientFor(symbol) / coefficient;
+					candidate < ratio)
+				{
+					ratio = candidate;
+					entering = symbol;
+				}
+			}
+		}
+
+		return entering;
+	}
+
+	auto ConstraintSolver::GetAnyPivotableSymbol(const Row& row) noexcept -> Symbol
+	{
+		for (const auto& symbol : row.GetCells() | std::views::keys)
+		{
+			if (symbol.type == SymbolType::Slack || symbol.type == SymbolType::Error)
+			{
+				return symbol;
+			}
+		}
+
+		return Symbol{ };
+	}
+
+	auto ConstraintSolver::GetLeavingRow(const Symbol entering) noexcept -> std::map<Symbol, Row>::iterator
+	{
+		auto ratio = std::numeric_limits<double>::max();
+		auto found = rows.end();
+		for (auto iter = rows.begin(); iter != rows.end(); ++iter)
+		{
+			if (iter->first.type == SymbolType::External)
+			{
+				continue;
+			}
+
+			if (const auto coefficient = iter->second.CoefficientFor(entering);
+				coefficient < 0.0)
+			{
+				if (const auto candidate = -iter->second.GetConstant() / coefficient;
+					candidate < ratio)
+				{
+					ratio = candidate;
+					found = iter;
+				}
+			}
+		}
+
+		return found;
+	}
+
+	auto ConstraintSolver::GetMarkerLeavingRow(const Symbol marker) noexcept -> std::map<Symbol, Row>::iterator
+	{
+		auto firstRatio = std::numeric_limits<double>::max();
+		auto secondRatio = std::numeric_limits<double>::max();
+		auto first = rows.end();
+		auto second = rows.end();
+		auto third = rows.end();
+
+		for (auto iter = rows.begin(); iter != rows.end(); ++iter)
+		{
+			const auto coefficient = iter->second.CoefficientFor(marker);
+			if (coefficient == 0.0)
+			{
+				continue;
+			}
+
+			if (iter->first.type == SymbolType::External)
+			{
+				third = iter;
+			}
+			else if (coefficient < 0.0)
+			{
+				if (const auto ratio = -iter->second.GetConstant() / coefficient;
+					ratio < firstRatio)
+				{
+					firstRatio = ratio;
+					first = iter;
+				}
+			}
+			else
+			{
+				if (const auto ratio = iter->second.GetConstant() / coefficient;
+					ratio < secondRatio)
+				{
+					secondRatio = ratio;
+					second = iter;
+				}
+			}
+		}
+
+		if (first != rows.end())
+		{
+			return first;
+		}
+		if (second != rows.end())
+		{
+			return second;
+		}
+		return third;
+	}
+
+	auto ConstraintSolver::RetainVariables(const Constraint& constraint) noexcept -> void
+	{
+		for (const auto& term : constraint.GetExpression().terms)
+		{
+			if (const auto iter = variables.find(term.variable.GetId());
+				iter != variables.end())
+			{
+				iter->second.constraintCount++;
+			}
+		}
+	}
+
+	auto ConstraintSolver::ReleaseVariables(const Constraint& constraint, const bool isRetained) noexcept -> void
+	{
+		for (const auto& term : constraint.GetExpression().terms)
+		{
+			const auto iter = variables.find(term.variable.GetId());
+			if (iter == variables.end())
+			{
+				continue;
+			}
+
+			auto& [variable, symbol, constraintCount] = iter->second;
+			if (isRetained)
+			{
+				constraintCount--;
+			}
+			if (constraintCount != 0)
+			{
+				continue;
+			}
+
+			// Nothing constrains the variable anymore. A basic row of it only defines the variable itself,
+			// a parametric one is zero in the current solution, so dropping its column changes no other value.
+			if (!rows.erase(symbol))
+			{
+				for (auto& row : rows | std::views::values)
+				{
+					row.Remove(symbol);
+				}
+				objective.Remove(symbol);
+			}
+			variables.erase(iter);
+		}
+	}
+
+	auto ConstraintSolver::RemoveConstraintEffects(const Constraint& constraint, const Tag& tag) noexcept -> void
+	{
+		if (tag.marker.type == SymbolType::Error)
+		{
+			RemoveMarkerEffects(tag.marker, constraint.GetStrength());
+		}
+		if (tag.other.type == SymbolType::Error)
+		{
+			RemoveMarkerEffects(tag.other, constraint.GetStrength());
+		}
+	}
+
+	auto ConstraintSolver::RemoveMarkerEffects(const Symbol marker, const double strength) noexcept -> void
+	{
+		if (const auto iter = rows.find(marker);
+			iter != rows.end())
+		{
+			objective.Insert(iter->second, -strength);
+		}
+		else
+		{
+			objective.Insert(marker, -strength);
+		}
+	}
+
+	auto ConstraintSolver::AllDummies(const Row& row) noexcept -> bool
+	{
+		return std::ranges::all_of(
+			row.GetCells() | std::views::keys,
+			[](const auto& symbol)
+			{
+				return symbol.type == SymbolType::Dummy;
+			});
+	}
+}
@@ -70,7 +70,7 @@ namespace PGUI::UI::Layout
 		}
 
 		maxDockSizes.insert_or_assign(position, size);
-		RearrangeItems();
+		InvalidateArrange();
 
 		return EmptyResult;
 	}
@@ -80,6 +80,7 @@ namespace PGUI::UI::Layout
 		if (maxDockSizes.contains(position))
 		{
 			maxDockSizes.erase(position);
+			InvalidateArrange();
 		}
 	}
 
@@ -105,23 +106,23 @@ namespace PGUI::UI::Layout
 
 		dockPriorities.insert_or_assign(toSwap, dockPriorities.at(position));
 		dockPriorities[position] = priority;
-		RearrangeItems();
+		InvalidateArrange();
 	}
 
 	auto DockLayout::SetDockPosition(const std::size_t id, const DockPosition position) noexcept -> void
 	{
-		if (dockPositions.contains(id))
+		if (id < dockPositions.size() && dockPositions[id] != position)
 		{
 			dockPositions[id] = position;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
 	auto DockLayout::GetItemPosition(const std::size_t id) const noexcept -> Result<DockPosition>
 	{
-		if (dockPositions.contains(id))
+		if (id < dockPositions.size())
 		{
-			return dockPositions.at(id);
+			return dockPositions[id];
 		}
 		return Unexpected{ Error{ ErrorCode::InvalidArgument } };
 	}
@@ -131,9 +132,9 @@ namespace PGUI::UI::Layout
 		std::vector<std::pair<std::size_t, DockPosition>> dockedItems;
 		dockedItems.reserve(dockPositions.size());
 
-		for (const auto& [id, position] : dockPositions)
+		for (const auto& [id, position] : dockPositions | std::views::enumerate)
 		{
-			dockedItems.emplace_back(id, position);
+			dockedItems.emplace_back(static_cast<std::size_t>(id), position);
 		}
 		std::ranges::stable_sort(
 			dockedItems,
@@ -144,7 +145,8 @@ namespace PGUI::UI::Layout
 				return ToUnderlying(priorityA) < ToUnderlying(priorityB);
 			});
 
-		const auto space = GetRect();
+		// Items are arranged in the coordinates of the panel
+		const auto space = RectF{ PointF{ 0, 0 }, GetSize() };
 		auto availableSpace = space;
 
 		for (auto& [id, position] : dockedItems)
@@ -154,7 +156,7 @@ namespace PGUI::UI::Layout
 			{
 				case DockPosition::Top:
 				{
-					auto topHeight = MeasureItem(item).cy;
+					auto topHeight = MeasureItem(id, availableSpace.Size()).cy;
 					if (maxDockSizes.contains(DockPosition::Top) &&
 					    availableSpace.top + topHeight > maxDockSizes[DockPosition::Top])
 					{
@@ -172,7 +174,7 @@ namespace PGUI::UI::Layout
 				}
 				case DockPosition::Bottom:
 				{
-					auto bottomHeight = MeasureItem(item).cy;
+					auto bottomHeight = MeasureItem(id, availableSpace.Size()).cy;
 					if (maxDockSizes.contains(DockPosition::Bottom) &&
 					    space.bottom - availableSpace.bottom + bottomHeight > maxDockSizes[DockPosition::Bottom])
 					{
@@ -190,7 +192,7 @@ namespace PGUI::UI::Layout
 				}
 				case DockPosition::Left:
 				{
-					auto leftWidth = MeasureItem(item).cx;
+					auto leftWidth = MeasureItem(id, availableSpace.Size()).cx;
 					if (maxDockSizes.contains(DockPosition::Left) &&
 					    availableSpace.left + leftWidth > maxDockSizes[DockPosition::Left])
 					{
@@ -208,7 +210,7 @@ namespace PGUI::UI::Layout
 				}
 				case DockPosition::Right:
 				{
-					auto rightWidth = MeasureItem(item).cx;
+					auto rightWidth = MeasureItem(id, availableSpace.Size()).cx;
 					if (maxDockSizes.contains(DockPosition::Right) &&
 					    space.right - availableSpace.right + rightWidth > maxDockSizes[DockPosition::Right])
 					{
@@ -239,19 +241,13 @@ namespace PGUI::UI::Layout
 
 	auto DockLayout::OnItemAdded(const LayoutItem& layoutItem) -> void
 	{
-		if (const auto result = GetItemIndex(layoutItem);
-			result.has_value() && !dockPositions.contains(*result))
-		{
-			LayoutPanel::OnItemAdded(layoutItem);
-			return;
-		}
 		LayoutPanel::OnItemAdded(layoutItem);
-		dockPositions.insert_or_assign(GetItemCount() - 1, DockPosition::None);
+		dockPositions.push_back(DockPosition::None);
 	}
 
 	auto DockLayout::OnItemRemoved(const std::size_t id) -> void
 	{
-		dockPositions.erase(id);
+		dockPositions.erase(dockPositions.begin() + static_cast<std::ptrdiff_t>(id));
 		LayoutPanel::OnItemRemoved(id);
 	}
 }
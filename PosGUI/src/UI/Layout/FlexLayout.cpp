@@ -0,0 +1,540 @@
+module PGUI.UI.Layout.FlexLayout;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+
+namespace PGUI::UI::Layout
+{
+	namespace
+	{
+		struct SpaceDistribution
+		{
+			float leading = 0;
+			float between = 0;
+		};
+
+		// Splits the free space of a line (or of the lines) the way the alignment asks for,
+		// the spacing alignments fall back like CSS does when there is no free space
+		auto DistributeFreeSpace(
+			const MainAxisAlignment alignment,
+			const float freeSpace,
+			const std::size_t count) noexcept -> SpaceDistribution
+		{
+			const auto itemCount = static_cast<float>(count);
+			switch (alignment)
+			{
+				case MainAxisAlignment::Start:
+				{
+					return { };
+				}
+				case MainAxisAlignment::Center:
+				{
+					return { .leading = freeSpace / 2 };
+				}
+				case MainAxisAlignment::End:
+				{
+					return { .leading = freeSpace };
+				}
+				case MainAxisAlignment::SpaceBetween:
+				{
+					if (freeSpace <= 0 || count < 2)
+					{
+						return { };
+					}
+					return { .between = freeSpace / (itemCount - 1) };
+				}
+				case MainAxisAlignment::SpaceAround:
+				{
+					if (freeSpace <= 0 || count == 0)
+					{
+						return { .leading = freeSpace / 2 };
+					}
+					return { .leading = freeSpace / itemCount / 2, .between = freeSpace / itemCount };
+				}
+				case MainAxisAlignment::SpaceEvenly:
+				{
+					if (freeSpace <= 0 || count == 0)
+					{
+						return { .leading = freeSpace / 2 };
+					}
+					const auto space = freeSpace / (itemCount + 1);
+					return { .leading = space, .between = space };
+				}
+			}
+
+			return { };
+		}
+	}
+
+	FlexLayout::FlexLayout(
+		const RectF bounds,
+		const LayoutOrientation direction,
+		const MainAxisAlignment justifyContent,
+		const CrossAxisAlignment alignItems,
+		const WrapMode wrapMode,
+		const float gap, const float crossGap) noexcept :
+		LayoutPanel{ bounds },
+		direction{ direction }, justifyContent{ justifyContent },
+		alignItems{ alignItems }, wrapMode{ wrapMode },
+		mainAxisGap{ gap }, crossAxisGap{ crossGap }
+	{ }
+
+	auto FlexLayout::RearrangeItems() noexcept -> void
+	{
+		if (GetItemCount() == 0)
+		{
+			return;
+		}
+
+		const auto size = GetSize();
+		const auto availableMain = MainAxis(size);
+		const auto availableCross = CrossAxis(size);
+
+		ComputeHypotheticalSizes(availableCross);
+		CollectLines(availableMain);
+
+		// A single line that doesn't wrap is as tall as the panel
+		if (wrapMode == WrapMode::NoWrap)
+		{
+			lines.front().crossSize = availableCross;
+		}
+
+		auto linesCross = static_cast<float>(lines.size() - 1) * crossAxisGap;
+		for (const auto& line : lines)
+		{
+			linesCross += line.crossSize;
+		}
+
+		const auto lineSpacing = DistributeFreeSpace(alignContent, availableCross - linesCross, lines.size());
+		auto crossPosition = lineSpacing.leading;
+
+		for (const auto& line : lines)
+		{
+			ResolveFlexibleLengths(line, availableMain);
+
+			const auto lineStates = std::span{ itemStates }.subspan(line.first, line.last - line.first);
+
+			auto usedMain = static_cast<float>(lineStates.size() - 1) * mainAxisGap;
+			for (const auto& state : lineStates)
+			{
+				usedMain += state.targetMainSize;
+			}
+
+			const auto itemSpacing = DistributeFreeSpace(justifyContent, availableMain - usedMain, lineStates.size());
+			auto mainPosition = itemSpacing.leading;
+
+			for (const auto& state : lineStates)
+			{
+				auto itemCross = state.crossSize;
+				auto crossOffset = 0.0F;
+				switch (itemProperties[state.index].alignSelf.value_or(alignItems))
+				{
+					case CrossAxisAlignment::Start:
+					{
+						break;
+					}
+					case CrossAxisAlignment::Center:
+					{
+						crossOffset = (line.crossSize - itemCross) / 2;
+						break;
+					}
+					case CrossAxisAlignment::End:
+					{
+						crossOffset = line.crossSize - itemCross;
+						break;
+					}
+					case CrossAxisAlignment::Stretch:
+					{
+						itemCross = line.crossSize;
+						break;
+					}
+				}
+
+				const auto position = direction == LayoutOrientation::Horizontal
+					? PointF{ mainPosition, crossPosition + crossOffset }
+					: PointF{ crossPosition + crossOffset, mainPosition };
+				ArrangeItem(GetItems()[state.index], RectF{ position, MakeSize(state.targetMainSize, itemCross) });
+
+				mainPosition += state.targetMainSize + mainAxisGap + itemSpacing.between;
+			}
+
+			crossPosition += line.crossSize + crossAxisGap + lineSpacing.between;
+		}
+	}
+
+	auto FlexLayout::Measure(const SizeF availableSize) noexcept -> SizeF
+	{
+		if (GetItemCount() == 0)
+		{
+			return SizeF{ 0, 0 };
+		}
+
+		auto crossLimit = CrossAxis(availableSize);
+		if (!std::isfinite(crossLimit))
+		{
+			crossLimit = CrossAxis(GetSize());
+		}
+
+		ComputeHypotheticalSizes(crossLimit);
+		CollectLines(MainAxis(availableSize));
+
+		auto mainExtent = 0.0F;
+		auto crossExtent = static_cast<float>(lines.size() - 1) * crossAxisGap;
+		for (const auto& line : lines)
+		{
+			auto lineMain = static_cast<float>(line.last - line.first - 1) * mainAxisGap;
+			for (const auto& state : std::span{ itemStates }.subspan(line.first, line.last - line.first))
+			{
+				lineMain += state.hypotheticalMainSize;
+			}
+
+			mainExtent = std::max(mainExtent, lineMain);
+			crossExtent += line.crossSize;
+		}
+
+		return MakeSize(mainExtent, crossExtent);
+	}
+
+	auto FlexLayout::GetItemProperties(const std::size_t index) const noexcept -> Result<FlexItemProperties>
+	{
+		if (index >= itemProperties.size())
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Given index is out of range") };
+		}
+
+		return itemProperties[index];
+	}
+
+	auto FlexLayout::GetItemProperties(const LayoutItem& item) const noexcept -> Result<FlexItemProperties>
+	{
+		const auto result = GetItemIndex(item);
+		if (result.has_value())
+		{
+			return GetItemProperties(*result);
+		}
+
+		return Unexpected{ result.error() };
+	}
+
+	auto FlexLayout::SetItemProperties(
+		const std::size_t index, const FlexItemProperties& properties) noexcept -> Result<void>
+	{
+		if (index >= itemProperties.size())
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Given index is out of range") };
+		}
+		if (properties.grow < 0 || properties.shrink < 0)
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Flex factors cannot be negative") };
+		}
+		if (properties.basis.has_value() && *properties.basis < 0)
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Flex basis cannot be negative") };
+		}
+
+		if (itemProperties[index] != properties)
+		{
+			itemProperties[index] = properties;
+			InvalidateMeasure();
+		}
+
+		return EmptyResult;
+	}
+
+	auto FlexLayout::SetItemProperties(
+		const LayoutItem& item, const FlexItemProperties& properties) noexcept -> Result<void>
+	{
+		const auto result = GetItemIndex(item);
+		if (result.has_value())
+		{
+			return SetItemProperties(*result, properties);
+		}
+
+		return Unexpected{ result.error() };
+	}
+
+	auto FlexLayout::SetDirection(const LayoutOrientation newDirection) noexcept -> void
+	{
+		if (direction != newDirection)
+		{
+			direction = newDirection;
+			InvalidateMeasure();
+		}
+	}
+
+	auto FlexLayout::SetJustifyContent(const MainAxisAlignment alignment) noexcept -> void
+	{
+		if (justifyContent != alignment)
+		{
+			justifyContent = alignment;
+			InvalidateArrange();
+		}
+	}
+
+	auto FlexLayout::SetAlignItems(const CrossAxisAlignment alignment) noexcept -> void
+	{
+		if (alignItems != alignment)
+		{
+			alignItems = alignment;
+			InvalidateArrange();
+		}
+	}
+
+	auto FlexLayout::SetAlignContent(const MainAxisAlignment alignment) noexcept -> void
+	{
+		if (alignContent != alignment)
+		{
+			alignContent = alignment;
+			InvalidateArrange();
+		}
+	}
+
+	auto FlexLayout::SetWrapMode(const WrapMode mode) noexcept -> void
+	{
+		if (wrapMode != mode)
+		{
+			wrapMode = mode;
+			InvalidateMeasure();
+		}
+	}
+
+	auto FlexLayout::SetMainAxisGap(const float gap) noexcept -> void
+	{
+		if (mainAxisGap != gap)
+		{
+			mainAxisGap = gap;
+			InvalidateMeasure();
+		}
+	}
+
+	auto FlexLayout::SetCrossAxisGap(const float gap) noexcept -> void
+	{
+		if (crossAxisGap != gap)
+		{
+			crossAxisGap = gap;
+			InvalidateMeasure();
+		}
+	}
+
+	auto FlexLayout::MainAxis(const SizeF size) const noexcept -> float
+	{
+		return direction == LayoutOrientation::Horizontal ? size.cx : size.cy;
+	}
+
+	auto FlexLayout::CrossAxis(const SizeF size) const noexcept -> float
+	{
+		return direction == LayoutOrientation::Horizontal ? size.cy : size.cx;
+	}
+
+	auto FlexLayout::MakeSize(const float main, const float cross) const noexcept -> SizeF
+	{
+		return direction == LayoutOrientation::Horizontal ? SizeF{ main, cross } : SizeF{ cross, main };
+	}
+
+	auto FlexLayout::ComputeHypotheticalSizes(const float crossLimit) noexcept -> void
+	{
+		// Unversioned items may have changed without the version moving
+		const auto isCacheable = std::ranges::all_of(
+			GetItems(),
+			[](const auto& item)
+			{
+				return item.HasMeasureVersion();
+			});
+		// Items that are not panels only advance their own version, every version is monotonic
+		// so the sum moves on any change as long as the item set stays the same
+		auto version = GetMeasureVersion();
+		for (const auto& item : GetItems())
+		{
+			version += item.GetMeasureVersion();
+		}
+
+		if (isCacheable && hasCachedSizes &&
+		    cachedMeasureVersion == version && cachedCrossLimit == crossLimit &&
+		    itemStates.size() == GetItemCount())
+		{
+			return;
+		}
+
+		itemStates.resize(GetItemCount());
+		for (auto&& [index, state] : std::views::enumerate(itemStates))
+		{
+			state.index = static_cast<std::size_t>(index);
+		}
+		std::ranges::stable_sort(
+			itemStates,
+			[this](const auto& a, const auto& b)
+			{
+				return itemProperties[a.index].order < itemProperties[b.index].order;
+			});
+
+		const auto constraint = MakeSize(std::numeric_limits<float>::infinity(), crossLimit);
+		for (auto& state : itemStates)
+		{
+			const auto& properties = itemProperties[state.index];
+			const auto desiredSize = MeasureItem(state.index, constraint);
+
+			state.baseSize = properties.basis.value_or(MainAxis(desiredSize));
+			state.hypotheticalMainSize = std::clamp(
+				state.baseSize,
+				properties.minMainSize, std::max(properties.minMainSize, properties.maxMainSize));
+			state.crossSize = CrossAxis(desiredSize);
+		}
+
+		cachedMeasureVersion = version;
+		cachedCrossLimit = crossLimit;
+		hasCachedSizes = isCacheable;
+	}
+
+	auto FlexLayout::CollectLines(const float mainLimit) noexcept -> void
+	{
+		lines.clear();
+
+		FlexLine line{ };
+		auto lineMain = 0.0F;
+		for (const auto& [position, state] : std::views::enumerate(itemStates))
+		{
+			const auto index = static_cast<std::size_t>(position);
+			const auto isLineEmpty = line.first == index;
+
+			if (wrapMode == WrapMode::Wrap && !isLineEmpty &&
+			    lineMain + mainAxisGap + state.hypotheticalMainSize > mainLimit)
+			{
+				line.last = index;
+				lines.push_back(line);
+
+				line = FlexLine{ .first = index };
+				lineMain = 0;
+			}
+
+			lineMain += (line.first != index ? mainAxisGap : 0.0F) + state.hypotheticalMainSize;
+			line.crossSize = std::max(line.crossSize, state.crossSize);
+		}
+
+		line.last = itemStates.size();
+		lines.push_back(line);
+	}
+
+	auto FlexLayout::ResolveFlexibleLengths(const FlexLine& line, const float availableMain) noexcept -> void
+	{
+		const auto lineStates = std::span{ itemStates }.subspan(line.first, line.last - line.first);
+		const auto gaps = static_cast<float>(lineStates.size() - 1) * mainAxisGap;
+
+		auto hypotheticalSum = gaps;
+		for (const auto& state : lineStates)
+		{
+			hypotheticalSum += state.hypotheticalMainSize;
+		}
+		const auto isGrowing = hypotheticalSum < availableMain;
+
+		// Inflexible items keep their hypothetical size
+		for (auto& state : lineStates)
+		{
+			const auto& properties = itemProperties[state.index];
+			const auto factor = isGrowing ? properties.grow : properties.shrink;
+
+			state.targetMainSize = state.hypotheticalMainSize;
+			state.isFrozen = !std::isfinite(availableMain) || factor == 0 ||
+				(isGrowing && state.baseSize > state.hypotheticalMainSize) ||
+				(!isGrowing && state.baseSize < state.hypotheticalMainSize);
+		}
+
+		const auto freeSpaceOf = [&lineStates, gaps, availableMain]
+		{
+			auto used = gaps;
+			for (const auto& state : lineStates)
+			{
+				used += state.isFrozen ? state.targetMainSize : state.baseSize;
+			}
+			return availableMain - used;
+		};
+		const auto initialFreeSpace = freeSpaceOf();
+
+		// Every round freezes at least one item so this ends after at most one round per item
+		while (std::ranges::any_of(lineStates, [](const auto& state) { return !state.isFrozen; }))
+		{
+			auto freeSpace = freeSpaceOf();
+
+			auto factorSum = 0.0F;
+			auto scaledShrinkSum = 0.0F;
+			for (const auto& state : lineStates)
+			{
+				if (!state.isFrozen)
+				{
+					const auto& properties = itemProperties[state.index];
+					factorSum += isGrowing ? properties.grow : properties.shrink;
+					scaledShrinkSum += properties.shrink * state.baseSize;
+				}
+			}
+			if (factorSum < 1)
+			{
+				if (const auto scaled = initialFreeSpace * factorSum;
+					std::abs(scaled) < std::abs(freeSpace))
+				{
+					freeSpace = scaled;
+				}
+			}
+
+			auto totalViolation = 0.0F;
+			for (auto& state : lineStates)
+			{
+				if (state.isFrozen)
+				{
+					continue;
+				}
+
+				const auto& properties = itemProperties[state.index];
+				auto target = state.baseSize;
+				if (isGrowing && factorSum > 0)
+				{
+					target += freeSpace * properties.grow / factorSum;
+				}
+				else if (!isGrowing && scaledShrinkSum > 0)
+				{
+					target += freeSpace * properties.shrink * state.baseSize / scaledShrinkSum;
+				}
+
+				const auto clamped = std::clamp(
+					target,
+					std::max(properties.minMainSize, 0.0F),
+					std::max({ properties.minMainSize, properties.maxMainSize, 0.0F }));
+				state.violation = clamped - target;
+				totalViolation += state.violation;
+				state.targetMainSize = clamped;
+			}
+
+			for (auto& state : lineStates)
+			{
+				if (state.isFrozen)
+				{
+					continue;
+				}
+
+				if (totalViolation == 0 ||
+				    (totalViolation > 0 && state.violation > 0) ||
+				    (totalViolation < 0 && state.violation < 0))
+				{
+					state.isFrozen = true;
+				}
+			}
+		}
+	}
+
+	auto FlexLayout::OnItemAdded(const LayoutItem& item) -> void
+	{
+		itemProperties.emplace_back();
+		hasCachedSizes = false;
+		LayoutPanel::OnItemAdded(item);
+	}
+
+	auto FlexLayout::OnItemRemoved(const std::size_t index) -> void
+	{
+		if (index < itemProperties.size())
+		{
+			itemProperties.erase(itemProperties.begin() + static_cast<std::ptrdiff_t>(index));
+		}
+		hasCachedSizes = false;
+		LayoutPanel::OnItemRemoved(index);
+	}
+}
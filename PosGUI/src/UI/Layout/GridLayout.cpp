@@ -8,42 +8,196 @@ import PGUI.UI.Layout.LayoutPanel;
 
 namespace PGUI::UI::Layout
 {
-	auto OccupySet(std::set<std::pair<long, long>>& set,
-	               const long row, const long column,
-	               const long rowSpan, const long columnSpan) noexcept -> void
+	// Row major occupancy bitmap of the grid, tests and searches whole words at a time.
+	// Rows are added on demand, columns grow by relaying out the rows.
+	class GridOccupancy
 	{
-		for (auto r = row; r < row + rowSpan; r++)
+		using Word = std::uint64_t;
+		static constexpr auto WordBits = static_cast<long>(std::numeric_limits<Word>::digits);
+
+		public:
+		explicit GridOccupancy(const long columnCount) noexcept
 		{
-			for (auto c = column; c < column + columnSpan; c++)
+			EnsureColumns(std::max(columnCount, 1L));
+		}
+
+		[[nodiscard]] auto GetMaxOccupiedColumn() const noexcept { return maxOccupiedColumn; }
+
+		auto Occupy(const long row, const long column, const long rowSpan, const long columnSpan) noexcept -> void
+		{
+			EnsureColumns(column + columnSpan);
+			EnsureRows(row + rowSpan);
+
+			for (auto r = row; r < row + rowSpan; r++)
 			{
-				set.emplace(r, c);
+				const auto rowWords = RowWords(r);
+				ForEachSpanWord(column, columnSpan, [rowWords](const std::size_t index, const Word mask)
+				{
+					rowWords[index] |= mask;
+				});
 			}
+			maxOccupiedColumn = std::max(maxOccupiedColumn, column + columnSpan - 1);
 		}
-	}
 
-	auto IsOccupied(const std::set<std::pair<long, long>>& set,
-	                const long row, const long column,
-	                const long rowSpan, const long columnSpan) noexcept
-	{
-		for (auto r = row; r < row + rowSpan; r++)
+		[[nodiscard]] auto IsOccupied(
+			const long row, const long column, const long rowSpan, const long columnSpan) const noexcept -> bool
 		{
-			for (auto c = column; c < column + columnSpan; c++)
+			const auto lastRow = std::min(row + rowSpan, rowCount);
+			const auto lastColumn = std::min(column + columnSpan, columnCount);
+			if (column >= lastColumn)
 			{
-				if (set.contains({ r, c }))
+				return false;
+			}
+
+			for (auto r = row; r < lastRow; r++)
+			{
+				const auto rowWords = RowWords(r);
+				auto occupied = false;
+				ForEachSpanWord(column, lastColumn - column, [rowWords, &occupied](const std::size_t index, const Word mask)
+				{
+					occupied = occupied || (rowWords[index] & mask) != 0;
+				});
+				if (occupied)
 				{
 					return true;
 				}
 			}
+
+			return false;
 		}
 
-		return false;
-	}
+		// Leftmost column in [firstColumn, lastColumn] where the span fits
+		[[nodiscard]] auto FindFreeColumn(
+			const long row, const long rowSpan, const long columnSpan,
+			const long firstColumn, const long lastColumn) noexcept -> std::optional<long>
+		{
+			EnsureColumns(lastColumn + columnSpan);
+
+			mergedRows.assign(wordsPerRow, 0);
+			for (auto r = row; r < std::min(row + rowSpan, rowCount); r++)
+			{
+				const auto rowWords = RowWords(r);
+				for (std::size_t i = 0; i < wordsPerRow; i++)
+				{
+					mergedRows[i] |= rowWords[i];
+				}
+			}
+
+			auto column = firstColumn;
+			while (column <= lastColumn)
+			{
+				const auto freeStart = NextColumn(column, false);
+				if (freeStart > lastColumn)
+				{
+					break;
+				}
+				const auto freeEnd = NextColumn(freeStart, true);
+				if (freeEnd - freeStart >= columnSpan)
+				{
+					return freeStart;
+				}
+				column = freeEnd;
+			}
 
-	auto IsUnoccupied(const std::set<std::pair<long, long>>& set,
-	                  const long row, const long column,
-	                  const long rowSpan, const long columnSpan) noexcept
+			return std::nullopt;
+		}
+
+		private:
+		long columnCount = 0;
+		long rowCount = 0;
+		std::size_t wordsPerRow = 0;
+		long maxOccupiedColumn = -1;
+		std::vector<Word> words;
+		std::vector<Word> mergedRows;
+
+		[[nodiscard]] auto RowWords(const long row) noexcept -> std::span<Word>
+		{
+			return std::span{ words }.subspan(static_cast<std::size_t>(row) * wordsPerRow, wordsPerRow);
+		}
+		[[nodiscard]] auto RowWords(const long row) const noexcept -> std::span<const Word>
+		{
+			return std::span{ words }.subspan(static_cast<std::size_t>(row) * wordsPerRow, wordsPerRow);
+		}
+
+		auto EnsureRows(const long count) noexcept -> void
+		{
+			if (count > rowCount)
+			{
+				rowCount = count;
+				words.resize(static_cast<std::size_t>(rowCount) * wordsPerRow);
+			}
+		}
+
+		auto EnsureColumns(const long count) noexcept -> void
+		{
+			if (count <= columnCount)
+			{
+				return;
+			}
+
+			const auto newWordsPerRow = static_cast<std::size_t>((count + WordBits - 1) / WordBits);
+			if (newWordsPerRow != wordsPerRow)
+			{
+				std::vector<Word> relaid(static_cast<std::size_t>(rowCount) * newWordsPerRow);
+				for (auto r = 0L; r < rowCount; r++)
+				{
+					std::ranges::copy(RowWords(r), relaid.begin() + static_cast<std::ptrdiff_t>(r * newWordsPerRow));
+				}
+				words = MoveChecked(relaid);
+				wordsPerRow = newWordsPerRow;
+			}
+			columnCount = count;
+		}
+
+		// First column at or after column whose merged bit equals occupied, columnCount if none
+		[[nodiscard]] auto NextColumn(const long column, const bool occupied) const noexcept -> long
+		{
+			if (column >= columnCount)
+			{
+				return columnCount;
+			}
+
+			auto index = static_cast<std::size_t>(column / WordBits);
+			auto word = (occupied ? mergedRows[index] : ~mergedRows[index]) & (~Word{ 0 } << (column % WordBits));
+			while (word == 0)
+			{
+				if (++index == wordsPerRow)
+				{
+					return columnCount;
+				}
+				word = occupied ? mergedRows[index] : ~mergedRows[index];
+			}
+
+			return std::min(static_cast<long>(index) * WordBits + std::countr_zero(word), columnCount);
+		}
+
+		template <typename Func>
+		static auto ForEachSpanWord(const long column, const long columnSpan, Func&& func) noexcept -> void
+		{
+			auto first = column;
+			const auto last = column + columnSpan;
+			while (first < last)
+			{
+				const auto bit = first % WordBits;
+				const auto count = std::min(WordBits - bit, last - first);
+				const auto mask = count == WordBits ? ~Word{ 0 } : ((Word{ 1 } << count) - 1) << bit;
+				func(static_cast<std::size_t>(first / WordBits), mask);
+				first += count;
+			}
+		}
+	};
+
+	// offsets[i] is where track i starts with the gaps before it included,
+	// so a span covers offsets[last + 1] - offsets[first] - gap
+	auto TrackOffsets(const std::vector<long>& sizes, const long gap) noexcept -> std::vector<long>
 	{
-		return !IsOccupied(set, row, column, rowSpan, columnSpan);
+		std::vector<long> offsets(sizes.size() + 1, 0L);
+		for (const auto& [index, size] : sizes | std::views::enumerate)
+		{
+			offsets[index + 1] = offsets[index] + size + gap;
+		}
+
+		return offsets;
 	}
 
 	auto GridLayout::SetRowGap(const FixedSize gap) noexcept -> void
@@ -51,7 +205,7 @@ namespace PGUI::UI::Layout
 		if (rowGap != gap)
 		{
 			rowGap = gap;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -60,7 +214,7 @@ namespace PGUI::UI::Layout
 		if (columnGap != gap)
 		{
 			columnGap = gap;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -70,7 +224,7 @@ namespace PGUI::UI::Layout
 		{
 			rowGap = gap;
 			columnGap = gap;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -99,7 +253,7 @@ namespace PGUI::UI::Layout
 		auto result = HasEntry(id);
 		if (result.has_value())
 		{
-			return itemProperties.at(*result).second;
+			return itemProperties[*result];
 		}
 		return Unexpected{ result.error() };
 	}
@@ -109,7 +263,7 @@ namespace PGUI::UI::Layout
 		if (minCellSize != size)
 		{
 			minCellSize = size;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -129,7 +283,7 @@ namespace PGUI::UI::Layout
 		columnDefinitions.erase(
 			std::next(columnDefinitions.begin(), static_cast<std::ptrdiff_t>(index)));
 
-		RearrangeItems();
+		InvalidateArrange();
 
 		return EmptyResult;
 	}
@@ -144,7 +298,7 @@ namespace PGUI::UI::Layout
 		rowDefinitions.erase(
 			std::next(rowDefinitions.begin(), static_cast<std::ptrdiff_t>(index)));
 
-		RearrangeItems();
+		InvalidateArrange();
 
 		return EmptyResult;
 	}
@@ -169,41 +323,51 @@ namespace PGUI::UI::Layout
 				itemProperties,
 				[](const auto& lhs, const auto& rhs) noexcept
 		{
-			return *lhs.second.column < *rhs.second.column;
+			return *lhs.column < *rhs.column;
 		});
 			maxColumn != itemProperties.end())
 		{
-			maxDefinedColumn = std::max(maxDefinedColumn, *maxColumn->second.column.Get());
+			maxDefinedColumn = std::max(maxDefinedColumn, *maxColumn->column.Get());
 		}
 		if (const auto maxSpan = std::ranges::max_element(
 				itemProperties,
 				[](const auto& lhs, const auto& rhs) noexcept
 				{
-					return *lhs.second.columnSpan < *rhs.second.columnSpan;
+					return *lhs.columnSpan < *rhs.columnSpan;
 				});
 			maxSpan != itemProperties.end())
 		{
-			maxColumnSpan = *maxSpan->second.columnSpan;
+			maxColumnSpan = *maxSpan->columnSpan;
 		}
 
 		maxDefinedColumn = std::max(maxDefinedColumn, static_cast<long>(columnDefinitions.size()));
 		maxDefinedColumn += maxColumnSpan - 1;
 
-		std::set<std::pair<long, long>> occupiedPositions = blankCells;
+		GridOccupancy occupancy{ maxDefinedColumn + maxColumnSpan };
+		for (const auto& [row, column] : blankCells)
+		{
+			occupancy.Occupy(row, column, 1, 1);
+		}
 		std::vector<std::pair<std::size_t, std::tuple<long, long, long, long>>> itemPositions;
+		itemPositions.reserve(itemProperties.size());
 
 		long maxPlacedRow = 0;
-		const auto populateStructures = [&occupiedPositions, &itemPositions, &maxPlacedRow](
+		const auto populateStructures = [&occupancy, &itemPositions, &maxPlacedRow](
 			const std::size_t id,
 			const long row, const long column, const long rowSpan, const long columnSpan)
 		{
 			itemPositions.emplace_back(id, std::make_tuple(row, column, rowSpan, columnSpan));
-			OccupySet(occupiedPositions, row, column, rowSpan, columnSpan);
+			occupancy.Occupy(row, column, rowSpan, columnSpan);
 			maxPlacedRow = std::max(maxPlacedRow, row + rowSpan - 1);
 		};
 
-		for (const auto& [id, properties] : itemProperties)
+		// Rows before this one have no free cell left within the defined columns,
+		// fully automatic placement never needs to look at them again
+		long firstOpenRow = 0;
+
+		for (const auto id : placementOrder)
 		{
+			const auto& properties = itemProperties[id];
 			const auto row = *properties.row;
 			const auto column = *properties.column;
 			const auto rowSpan = *properties.rowSpan;
@@ -217,23 +381,16 @@ namespace PGUI::UI::Layout
 			}
 			else if (row != AUTO_PLACE && column == AUTO_PLACE)
 			{
-				auto placed = false;
-				long tryColumn = 0;
-
-				while (tryColumn <= maxDefinedColumn - actualColumnSpan && !placed)
+				if (const auto freeColumn = occupancy.FindFreeColumn(
+						row, actualRowSpan, actualColumnSpan, 0, maxDefinedColumn - actualColumnSpan);
+					freeColumn.has_value())
 				{
-					if (IsOccupied(occupiedPositions, row, tryColumn, actualRowSpan, actualColumnSpan))
-					{
-						tryColumn++;
-						continue;
-					}
-					populateStructures(id, row, tryColumn, actualRowSpan, actualColumnSpan);
-					placed = true;
+					populateStructures(id, row, *freeColumn, actualRowSpan, actualColumnSpan);
 				}
-				if (!placed)
+				else
 				{
-					tryColumn = maxDefinedColumn - 1;
-					while (IsOccupied(occupiedPositions, row, tryColumn, 1, 1) && tryColumn > 0)
+					auto tryColumn = maxDefinedColumn - 1;
+					while (occupancy.IsOccupied(row, tryColumn, 1, 1) && tryColumn > 0)
 					{
 						tryColumn--;
 					}
@@ -248,83 +405,60 @@ namespace PGUI::UI::Layout
 					tryRow = maxPlacedRow;
 				}
 
-				while (true)
+				while (occupancy.IsOccupied(tryRow, column, actualRowSpan, actualColumnSpan))
 				{
-					if (IsUnoccupied(occupiedPositions, tryRow, column, actualRowSpan, actualColumnSpan))
-					{
-						populateStructures(id, tryRow, column, actualRowSpan, actualColumnSpan);
-						break;
-					}
 					tryRow++;
 				}
+				populateStructures(id, tryRow, column, actualRowSpan, actualColumnSpan);
 			}
 			else
 			{
-				long tryRow = 0;
+				while (!occupancy.FindFreeColumn(firstOpenRow, 1, 1, 0, maxDefinedColumn - 1).has_value())
+				{
+					firstOpenRow++;
+				}
+
+				auto tryRow = firstOpenRow;
 				if (placementType == GridCellPlacementType::Appended)
 				{
-					tryRow = maxPlacedRow;
+					tryRow = std::max(tryRow, maxPlacedRow);
 				}
-				long tryColumn = 0;
-				auto placed = false;
 
-				while (!placed)
+				while (true)
 				{
-					while (tryColumn <= maxDefinedColumn - actualColumnSpan)
+					if (const auto freeColumn = occupancy.FindFreeColumn(
+							tryRow, actualRowSpan, actualColumnSpan, 0, maxDefinedColumn - actualColumnSpan);
+						freeColumn.has_value())
 					{
-						if (IsUnoccupied(occupiedPositions, tryRow, tryColumn, actualRowSpan, actualColumnSpan))
-						{
-							populateStructures(id, tryRow, tryColumn, actualRowSpan, actualColumnSpan);
-							placed = true;
-							break;
-						}
-						tryColumn++;
+						populateStructures(id, tryRow, *freeColumn, actualRowSpan, actualColumnSpan);
+						break;
 					}
 					tryRow++;
-					tryColumn = 0;
 				}
 			}
 		}
 
-		if (const auto maxColumn = std::ranges::max_element(
-			occupiedPositions,
-			[](const auto& lhs, const auto& rhs)
-			{
-				return lhs.second < rhs.second;
-			});
-			maxColumn != occupiedPositions.end())
+		if (occupancy.GetMaxOccupiedColumn() >= 0)
 		{
-			maxDefinedColumn = maxColumn->second;
+			maxDefinedColumn = occupancy.GetMaxOccupiedColumn();
 		}
 
-		std::vector<long> rowSizes = GetRowSizes(maxPlacedRow + 1);
-		std::vector<long> columnSizes = GetColumnSizes(maxDefinedColumn + 1);
+		const auto rowOffsets = TrackOffsets(GetRowSizes(maxPlacedRow + 1), rowGap);
+		const auto columnOffsets = TrackOffsets(GetColumnSizes(maxDefinedColumn + 1), columnGap);
 
-		const auto placeFixedPosition = [&occupiedPositions, &rowSizes, &columnSizes, this](
+		const auto placeFixedPosition = [&rowOffsets, &columnOffsets, this](
 			const long row, const long column,
 			const long rowSpan, const long columnSpan) -> RectL
 		{
 			const PointL position{
-				std::accumulate(
-					columnSizes.begin(), columnSizes.begin() + column,
-					0L) + column * columnGap + padding.left,
-				std::accumulate(
-					rowSizes.begin(), rowSizes.begin() + row,
-					0L) + row * rowGap + padding.top
+				columnOffsets[column] + padding.left,
+				rowOffsets[row] + padding.top
 			};
 			const SizeL size{
-				std::accumulate(
-					columnSizes.begin() + column,
-					columnSizes.begin() + column + columnSpan,
-					0L) + (columnSpan - 1) * columnGap,
-				std::accumulate(
-					rowSizes.begin() + row,
-					rowSizes.begin() + row + rowSpan,
-					0L) + (rowSpan - 1) * rowGap
+				columnOffsets[column + columnSpan] - columnOffsets[column] - columnGap,
+				rowOffsets[row + rowSpan] - rowOffsets[row] - rowGap
 			};
 
-			OccupySet(occupiedPositions, row, column, rowSpan, columnSpan);
-
 			return RectL{ position, size };
 		};
 
@@ -350,8 +484,9 @@ namespace PGUI::UI::Layout
 		const auto result = HasEntry(id);
 		if (!result.has_value())
 		{
-			itemProperties.emplace_back(id, properties);
-			auto& prop = itemProperties.back().second;
+			itemProperties.push_back(properties);
+			placementOrder.push_back(id);
+			auto& prop = itemProperties.back();
 
 			prop.column.AddObserver(boundChangeHandler);
 			prop.row.AddObserver(boundChangeHandler);
@@ -360,12 +495,12 @@ namespace PGUI::UI::Layout
 			prop.columnSpan.AddValidator(boundColumnSpanValidator);
 
 			needsSorting = true;
-			RearrangeItems();
+			InvalidateArrange();
 
 			return;
 		}
 
-		auto& prop = itemProperties.at(*result).second;
+		auto& prop = itemProperties[*result];
 
 		if (prop.column.Get() == properties.column.Get() &&
 		    prop.row.Get() == properties.row.Get() &&
@@ -390,17 +525,17 @@ namespace PGUI::UI::Layout
 		prop.columnSpan.AddValidator(boundColumnSpanValidator);
 
 		needsSorting = true;
-		RearrangeItems();
+		InvalidateArrange();
 	}
 
 	auto GridLayout::SortProperties() noexcept -> void
 	{
 		std::ranges::stable_sort(
-			itemProperties,
-			[](const auto& lhs, const auto& rhs) noexcept
+			placementOrder,
+			[this](const auto lhs, const auto rhs) noexcept
 			{
-				const GridItemProperties& leftProperties = lhs.second;
-				const GridItemProperties& rightProperties = rhs.second;
+				const auto& leftProperties = itemProperties[lhs];
+				const auto& rightProperties = itemProperties[rhs];
 				const auto leftDefined = leftProperties.row != AUTO_PLACE && leftProperties.column != AUTO_PLACE;
 				const auto rightDefined = rightProperties.row != AUTO_PLACE && rightProperties.column != AUTO_PLACE;
 
@@ -419,37 +554,37 @@ namespace PGUI::UI::Layout
 			});
 
 		const auto firstUndefined = std::ranges::find_if(
-			itemProperties,
-			[](const auto& item) noexcept
+			placementOrder,
+			[this](const auto id) noexcept
 			{
-				return item.second.row == AUTO_PLACE || item.second.column == AUTO_PLACE;
+				return itemProperties[id].row == AUTO_PLACE || itemProperties[id].column == AUTO_PLACE;
 			});
-		const auto firstUndefinedIndex = std::distance(itemProperties.begin(), firstUndefined);
+		const auto firstUndefinedIndex = std::distance(placementOrder.begin(), firstUndefined);
 
 		std::ranges::stable_sort(
-			itemProperties | std::views::drop(firstUndefinedIndex),
-			[](const auto& lhs, const auto& rhs) noexcept
+			placementOrder | std::views::drop(firstUndefinedIndex),
+			[this](const auto lhs, const auto rhs) noexcept
 			{
-				const GridItemProperties& leftProperties = lhs.second;
-				const GridItemProperties& rightProperties = rhs.second;
+				const auto& leftProperties = itemProperties[lhs];
+				const auto& rightProperties = itemProperties[rhs];
 
 				return *leftProperties.row < *rightProperties.row;
 			});
 
 		const auto lastDefinedRow = std::ranges::find_if(
-			itemProperties | std::views::drop(firstUndefinedIndex),
-			[](const auto& item) noexcept
+			placementOrder | std::views::drop(firstUndefinedIndex),
+			[this](const auto id) noexcept
 			{
-				return item.second.row != AUTO_PLACE;
+				return itemProperties[id].row != AUTO_PLACE;
 			});
-		const auto lastDefinedRowIndex = std::distance(itemProperties.begin(), lastDefinedRow);
+		const auto lastDefinedRowIndex = std::distance(placementOrder.begin(), lastDefinedRow);
 
 		std::ranges::stable_sort(
-			itemProperties | std::views::drop(lastDefinedRowIndex),
-			[](const auto& lhs, const auto& rhs) noexcept
+			placementOrder | std::views::drop(lastDefinedRowIndex),
+			[this](const auto lhs, const auto rhs) noexcept
 			{
-				const GridItemProperties& leftProperties = lhs.second;
-				const GridItemProperties& rightProperties = rhs.second;
+				const auto& leftProperties = itemProperties[lhs];
+				const auto& rightProperties = itemProperties[rhs];
 
 				return *leftProperties.column < *rightProperties.column;
 			});
@@ -644,12 +779,17 @@ namespace PGUI::UI::Layout
 
 	auto GridLayout::OnItemRemoved(std::size_t size) -> void
 	{
-		itemProperties.erase(std::ranges::find_if(
-			itemProperties,
-			[&size](const auto& item) noexcept
+		itemProperties.erase(itemProperties.begin() + static_cast<std::ptrdiff_t>(size));
+
+		// Later items move down by one, their relative placement order stays the same
+		std::erase(placementOrder, size);
+		for (auto& id : placementOrder)
+		{
+			if (id > size)
 			{
-				return item.first == size;
-			}));
+				id--;
+			}
+		}
 		LayoutPanel::OnItemRemoved(size);
 	}
 }
@@ -0,0 +1,92 @@
+module PGUI.UI.Layout.LayoutDiagnostics;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.WorkStealingPool;
+import PGUI.UI.Layout.LayoutPanel;
+
+namespace PGUI::UI::Layout
+{
+	namespace
+	{
+		auto CollectStatistics(const LayoutPanel& panel, LayoutPassReport& report) noexcept -> void
+		{
+			report.panelCount++;
+			report.dirtyPanelCount += panel.IsArrangeDirty() ? 1 : 0;
+			report.itemCount += panel.GetItemCount();
+			report.itemStorageBytes += panel.GetItemStorageBytes();
+
+			for (const auto& item : panel.GetItems())
+			{
+				if (const auto child = item.AsPanel();
+					child != nullptr)
+				{
+					CollectStatistics(*child, report);
+				}
+			}
+		}
+
+		template <typename Pass>
+		auto Profile(LayoutPanel& panel, Pass&& pass) noexcept -> LayoutPassReport
+		{
+			LayoutPassReport report{ };
+			CollectStatistics(panel, report);
+
+			const auto startTime = std::chrono::steady_clock::now();
+			std::forward<Pass>(pass)();
+			report.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - startTime);
+
+			return report;
+		}
+
+		auto DumpPanel(
+			const LayoutPanel& panel, const std::size_t depth,
+			const int precision, std::wstring& output) noexcept -> void
+		{
+			for (const auto& [index, item] : std::views::enumerate(panel.GetItems()))
+			{
+				const auto rect = item.GetRect();
+				const auto child = item.AsPanel();
+
+				std::format_to(
+					std::back_inserter(output),
+					L"{}{} {} {:.{}f} {:.{}f} {:.{}f} {:.{}f}\n",
+					std::wstring(depth * 2, L' '),
+					index,
+					child != nullptr ? L"panel" : L"item",
+					rect.left, precision, rect.top, precision,
+					rect.right, precision, rect.bottom, precision);
+
+				if (child != nullptr)
+				{
+					DumpPanel(*child, depth + 1, precision, output);
+				}
+			}
+		}
+	}
+
+	auto ProfileLayoutPass(LayoutPanel& panel) noexcept -> LayoutPassReport
+	{
+		return Profile(panel, [&panel] { panel.UpdateLayout(); });
+	}
+
+	auto ProfileLayoutPass(LayoutPanel& panel, WorkStealingPool& pool) noexcept -> LayoutPassReport
+	{
+		return Profile(panel, [&panel, &pool] { panel.UpdateLayout(pool); });
+	}
+
+	auto DumpLayoutRects(const LayoutPanel& panel, const int precision) noexcept -> std::wstring
+	{
+		const auto rect = panel.GetRect();
+
+		auto output = std::format(
+			L"root panel {:.{}f} {:.{}f} {:.{}f} {:.{}f}\n",
+			rect.left, precision, rect.top, precision,
+			rect.right, precision, rect.bottom, precision);
+		DumpPanel(panel, 1, precision, output);
+
+		return output;
+	}
+}
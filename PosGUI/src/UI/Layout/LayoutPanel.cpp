@@ -0,0 +1,169 @@
+module PGUI.UI.Layout.LayoutPanel;
+
+import std;
+
+import PGUI.Shape;
+import PGUI.Utils;
+import PGUI.WorkStealingPool;
+
+namespace PGUI::UI::Layout
+{
+	thread_local std::vector<LayoutPanel::PendingItemChange>* LayoutPanel::deferredChanges = nullptr;
+
+	// Collects the item changes made on this thread into changes while alive
+	class LayoutPanel::DeferredChangeScope
+	{
+		public:
+		explicit DeferredChangeScope(std::vector<PendingItemChange>& changes) noexcept :
+			previous{ std::exchange(deferredChanges, &changes) }
+		{
+		}
+
+		~DeferredChangeScope() noexcept
+		{
+			deferredChanges = previous;
+		}
+
+		DeferredChangeScope(const DeferredChangeScope&) = delete;
+		DeferredChangeScope(DeferredChangeScope&&) = delete;
+		auto operator=(const DeferredChangeScope&) -> DeferredChangeScope& = delete;
+		auto operator=(DeferredChangeScope&&) -> DeferredChangeScope& = delete;
+
+		private:
+		std::vector<PendingItemChange>* previous;
+	};
+
+	auto LayoutPanel::UpdateLayout() noexcept -> void
+	{
+		// Already inside a pass, the outermost call commits
+		if (deferredChanges != nullptr)
+		{
+			UpdateLayoutSerial();
+			return;
+		}
+
+		pendingChanges.clear();
+		{
+			DeferredChangeScope scope{ pendingChanges };
+			UpdateLayoutSerial();
+		}
+		CommitItemChanges(pendingChanges);
+	}
+
+	auto LayoutPanel::UpdateLayout(WorkStealingPool& pool) noexcept -> void
+	{
+		if (deferredChanges != nullptr)
+		{
+			UpdateLayoutParallel(pool);
+			return;
+		}
+
+		pendingChanges.clear();
+		{
+			DeferredChangeScope scope{ pendingChanges };
+			UpdateLayoutParallel(pool);
+		}
+		CommitItemChanges(pendingChanges);
+	}
+
+	auto LayoutPanel::CommitItemChanges(const std::span<const PendingItemChange> changes) noexcept -> void
+	{
+		for (const auto& [item, change] : changes)
+		{
+			Match(
+				change,
+				[&item](const RectF bounds) { item.MoveAndResize(bounds); },
+				[&item](const PointF position) { item.Move(position); },
+				[&item](const SizeF size) { item.Resize(size); });
+		}
+	}
+
+	auto LayoutPanel::TryDeferItemChange(const LayoutItem& item, ItemChange change) noexcept -> bool
+	{
+		// Panels belong to the subtree being laid out so they are updated in place
+		if (deferredChanges == nullptr || item.AsPanel() != nullptr)
+		{
+			return false;
+		}
+
+		deferredChanges->emplace_back(item, change);
+		return true;
+	}
+
+	auto LayoutPanel::UpdateLayoutSerial() noexcept -> void
+	{
+		// Flags are cleared only after the work so that items dirtied on the way
+		// don't report this panel to its ancestors again
+		if (isArrangeDirty)
+		{
+			RearrangeItems();
+			isArrangeDirty = false;
+		}
+		if (!hasDirtyDescendant)
+		{
+			return;
+		}
+
+		for (const auto& item : managedItems)
+		{
+			if (const auto panel = item.AsPanel();
+				panel != nullptr)
+			{
+				panel->UpdateLayoutSerial();
+			}
+		}
+		hasDirtyDescendant = false;
+	}
+
+	auto LayoutPanel::UpdateLayoutParallel(WorkStealingPool& pool) noexcept -> void
+	{
+		if (isArrangeDirty)
+		{
+			RearrangeItems();
+			isArrangeDirty = false;
+		}
+		if (!hasDirtyDescendant)
+		{
+			return;
+		}
+
+		const auto dirtyPanels = managedItems |
+		                         std::views::transform([](const auto& item) { return item.AsPanel(); }) |
+		                         std::views::filter([](const auto* panel)
+		                         {
+			                         return panel != nullptr && panel->IsLayoutDirty();
+		                         }) |
+		                         std::ranges::to<std::vector>();
+
+		if (dirtyPanels.size() < 2)
+		{
+			for (const auto panel : dirtyPanels)
+			{
+				panel->UpdateLayoutParallel(pool);
+			}
+			hasDirtyDescendant = false;
+			return;
+		}
+
+		std::vector<std::vector<PendingItemChange>> subtreeChanges(dirtyPanels.size());
+		{
+			TaskGroup group{ pool };
+			for (const auto& [panel, changes] : std::views::zip(dirtyPanels, subtreeChanges))
+			{
+				group.Run([panel, &changes, &pool]
+				{
+					DeferredChangeScope scope{ changes };
+					panel->UpdateLayoutParallel(pool);
+				});
+			}
+			group.Wait();
+		}
+
+		// Appended in item order so the result doesn't depend on which subtree finished first
+		for (auto& changes : subtreeChanges)
+		{
+			deferredChanges->append_range(changes);
+		}
+		hasDirtyDescendant = false;
+	}
+}
@@ -23,30 +23,32 @@ namespace PGUI::UI::Layout
 
 	auto StackLayout::RearrangeItems() noexcept -> void
 	{
-		if (GetItemCount() == 0 || batchChanges)
+		if (GetItemCount() == 0)
 		{
 			return;
 		}
 
+		const auto itemSizes = MeasureItems(GetItemConstraint(GetSize()));
+
 		if (orientation == LayoutOrientation::Horizontal)
 		{
 			if (wrapMode == WrapMode::Wrap)
 			{
-				RearrangeHorizontalWrap();
+				RearrangeHorizontalWrap(itemSizes);
 			}
 			else
 			{
-				RearrangeHorizontalNoWrap();
+				RearrangeHorizontalNoWrap(itemSizes);
 			}
 			return;
 		}
 		if (wrapMode == WrapMode::Wrap)
 		{
-			RearrangeVerticalWrap();
+			RearrangeVerticalWrap(itemSizes);
 		}
 		else
 		{
-			RearrangeVerticalNoWrap();
+			RearrangeVerticalNoWrap(itemSizes);
 		}
 	}
 
@@ -55,7 +57,7 @@ namespace PGUI::UI::Layout
 		if (orientation != newOrientation)
 		{
 			orientation = newOrientation;
-			RearrangeItems();
+			InvalidateMeasure();
 		}
 	}
 
@@ -64,7 +66,7 @@ namespace PGUI::UI::Layout
 		if (mainAxisAlignment != alignment)
 		{
 			mainAxisAlignment = alignment;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -73,7 +75,7 @@ namespace PGUI::UI::Layout
 		if (crossAxisAlignment != alignment)
 		{
 			crossAxisAlignment = alignment;
-			RearrangeItems();
+			InvalidateArrange();
 		}
 	}
 
@@ -82,7 +84,7 @@ namespace PGUI::UI::Layout
 		if (mainAxisGap != gap)
 		{
 			mainAxisGap = gap;
-			RearrangeItems();
+			InvalidateMeasure();
 		}
 	}
 
@@ -91,10 +93,7 @@ namespace PGUI::UI::Layout
 		if (crossAxisGap != crossGap)
 		{
 			crossAxisGap = crossGap;
-			if (wrapMode == WrapMode::Wrap)
-			{
-				RearrangeItems();
-			}
+			InvalidateMeasure();
 		}
 	}
 
@@ -103,7 +102,7 @@ namespace PGUI::UI::Layout
 		if (padding != newPadding)
 		{
 			padding = newPadding;
-			RearrangeItems();
+			InvalidateMeasure();
 		}
 	}
 
@@ -112,7 +111,7 @@ namespace PGUI::UI::Layout
 		if (wrapMode != mode)
 		{
 			wrapMode = mode;
-			RearrangeItems();
+			InvalidateMeasure();
 		}
 	}
 
@@ -120,16 +119,12 @@ namespace PGUI::UI::Layout
 		const MainAxisAlignment mainAxis,
 		const CrossAxisAlignment crossAxis) noexcept -> void
 	{
-		ScopedValue scoped{ batchChanges, true };
-		
 		SetMainAxisAlignment(mainAxis);
 		SetCrossAxisAlignment(crossAxis);
 	}
 
 	auto StackLayout::SetGaps(const float mainAxis, const float crossAxis) noexcept -> void
 	{
-		ScopedValue scoped{ batchChanges, true };
-
 		SetMainAxisGap(mainAxis);
 		SetCrossAxisGap(crossAxis);
 	}
@@ -140,8 +135,6 @@ namespace PGUI::UI::Layout
 	                         const float newMainAxisGap,
 	                         const float newCrossAxisGap) noexcept -> void
 	{
-		ScopedValue scoped{ batchChanges, true };
-
 		SetOrientation(newOrientation);
 		SetMainAxisAlignment(newMainAxisAlignment);
 		SetCrossAxisAlignment(newCrossAxisAlignment);
@@ -151,10 +144,67 @@ namespace PGUI::UI::Layout
 		SetCrossAxisGap(newCrossAxisGap);
 	}
 
-	auto StackLayout::RearrangeHorizontalNoWrap() noexcept -> void
+	auto StackLayout::Measure(const SizeF availableSize) noexcept -> SizeF
+	{
+		const auto isHorizontal = orientation == LayoutOrientation::Horizontal;
+		const auto mainPadding = padding.startPad + padding.endingPad;
+		const auto crossPadding = padding.crossStartPad + padding.crossEndPad;
+
+		const auto mainOf = [isHorizontal](const SizeF size) { return isHorizontal ? size.cx : size.cy; };
+		const auto crossOf = [isHorizontal](const SizeF size) { return isHorizontal ? size.cy : size.cx; };
+
+		const auto availableMain = mainOf(availableSize) - mainPadding;
+
+		float mainExtent = 0;
+		float crossExtent = 0;
+		float lineMain = 0;
+		float lineCross = 0;
+		std::size_t lineItemCount = 0;
+
+		for (const auto& itemSize : MeasureItems(GetItemConstraint(availableSize)))
+		{
+			const auto itemMain = mainOf(itemSize);
+			if (wrapMode == WrapMode::Wrap && lineItemCount != 0 &&
+			    lineMain + mainAxisGap + itemMain > availableMain)
+			{
+				mainExtent = std::max(mainExtent, lineMain);
+				crossExtent += lineCross + crossAxisGap;
+				lineMain = 0;
+				lineCross = 0;
+				lineItemCount = 0;
+			}
+
+			lineMain += (lineItemCount != 0 ? mainAxisGap : 0.0F) + itemMain;
+			lineCross = std::max(lineCross, crossOf(itemSize));
+			lineItemCount++;
+		}
+		mainExtent = std::max(mainExtent, lineMain) + mainPadding;
+		crossExtent += lineCross + crossPadding;
+
+		return isHorizontal ? SizeF{ mainExtent, crossExtent } : SizeF{ crossExtent, mainExtent };
+	}
+
+	auto StackLayout::GetItemConstraint(const SizeF panelSize) const noexcept -> SizeF
+	{
+		constexpr auto unbounded = std::numeric_limits<float>::infinity();
+		const auto crossPadding = padding.crossStartPad + padding.crossEndPad;
+
+		if (orientation == LayoutOrientation::Horizontal)
+		{
+			return SizeF{ unbounded, std::max(panelSize.cy - crossPadding, 0.0F) };
+		}
+		return SizeF{ std::max(panelSize.cx - crossPadding, 0.0F), unbounded };
+	}
+
+	auto StackLayout::RearrangeHorizontalNoWrap(const std::span<const SizeF> itemSizes) noexcept -> void
 	{
 		const auto size = GetSize();
-		const auto totalItemSize = GetTotalItemSize().cx;
+		const auto totalItemSize = std::accumulate(
+			itemSizes.begin(), itemSizes.end(), 0.0F,
+			[](const float sum, const SizeF itemSize)
+			{
+				return sum + itemSize.cx;
+			});
 		const auto requiredSpace =
 			totalItemSize +
 			static_cast<float>(GetItemCount() - 1) * mainAxisGap;
@@ -170,9 +220,9 @@ namespace PGUI::UI::Layout
 			position = (size.cx + padding.startPad - padding.endingPad - requiredSpace) / 2;
 		}
 
-		for (auto& item : GetItems())
+		for (const auto& [item, itemSize] : std::views::zip(GetItems(), itemSizes))
 		{
-			const auto itemSize = MeasureItem(item);
+			auto arrangedSize = itemSize;
 			float top = 0;
 			switch (crossAxisAlignment)
 			{
@@ -193,20 +243,25 @@ namespace PGUI::UI::Layout
 				}
 				case CrossAxisAlignment::Stretch:
 				{
-					ResizeItem(item, { itemSize.cx, size.cy });
+					arrangedSize.cy = size.cy;
 					break;
 				}
 			}
 
-			MoveItem(item, { position, top });
+			ArrangeItem(item, RectF{ PointF{ position, top }, arrangedSize });
 			position += itemSize.cx + mainAxisGap;
 		}
 	}
 
-	auto StackLayout::RearrangeVerticalNoWrap() noexcept -> void
+	auto StackLayout::RearrangeVerticalNoWrap(const std::span<const SizeF> itemSizes) noexcept -> void
 	{
 		const auto size = GetSize();
-		const auto totalItemSize = GetTotalItemSize().cy;
+		const auto totalItemSize = std::accumulate(
+			itemSizes.begin(), itemSizes.end(), 0.0F,
+			[](const float sum, const SizeF itemSize)
+			{
+				return sum + itemSize.cy;
+			});
 		const auto requiredSpace =
 			totalItemSize +
 			static_cast<float>(GetItemCount() - 1) * mainAxisGap;
@@ -222,9 +277,9 @@ namespace PGUI::UI::Layout
 			position = (size.cy + padding.startPad - padding.endingPad - requiredSpace) / 2;
 		}
 
-		for (auto& item : GetItems())
+		for (const auto& [item, itemSize] : std::views::zip(GetItems(), itemSizes))
 		{
-			const auto itemSize = MeasureItem(item);
+			auto arrangedSize = itemSize;
 			float left = 0;
 			switch (crossAxisAlignment)
 			{
@@ -245,25 +300,30 @@ namespace PGUI::UI::Layout
 				}
 				case CrossAxisAlignment::Stretch:
 				{
-					ResizeItem(item, { size.cx, itemSize.cy });
+					arrangedSize.cx = size.cx;
 					break;
 				}
 			}
 
-			MoveItem(item, { left, position });
+			ArrangeItem(item, RectF{ PointF{ left, position }, arrangedSize });
 			position += itemSize.cy + mainAxisGap;
 		}
 	}
 
-	auto StackLayout::RearrangeHorizontalWrap() noexcept -> void
+	auto StackLayout::RearrangeHorizontalWrap(const std::span<const SizeF> itemSizes) noexcept -> void
 	{
 		const auto clientSize = GetSize();
-		const auto totalItemSize = GetTotalItemSize();
+		const auto totalItemWidth = std::accumulate(
+			itemSizes.begin(), itemSizes.end(), 0.0F,
+			[](const float sum, const SizeF itemSize)
+			{
+				return sum + itemSize.cx;
+			});
 		const auto availableWidth = clientSize.cx - padding.startPad - padding.endingPad;
 
-		if (totalItemSize.cx + (GetItemCount() - 1) * mainAxisGap <= availableWidth)
+		if (totalItemWidth + (GetItemCount() - 1) * mainAxisGap <= availableWidth)
 		{
-			RearrangeHorizontalNoWrap();
+			RearrangeHorizontalNoWrap(itemSizes);
 			return;
 		}
 
@@ -276,16 +336,8 @@ namespace PGUI::UI::Layout
 		float currentRowSize = 0;
 		float maxHeight = 0;
 
-		std::vector<SizeF> itemSizes;
-		itemSizes.reserve(GetItemCount());
-		for (const auto& item : GetItems())
+		for (const auto& [index, itemSize] : itemSizes | std::views::enumerate)
 		{
-			itemSizes.push_back(MeasureItem(item));
-		}
-
-		for (const auto& [index, item] : GetItems() | std::views::enumerate)
-		{
-			const auto& itemSize = itemSizes.at(index);
 			if (currentRowSize + itemSize.cx > availableWidth)
 			{
 				rowSizes.push_back(maxHeight);
@@ -298,12 +350,9 @@ namespace PGUI::UI::Layout
 		}
 		while (rowSizes.size() < startIndices.size())
 		{
-			for ([[maybe_unused]] const auto& [index, item] :
-			     GetItems() |
-			     std::views::drop(startIndices.back()) |
-			     std::views::enumerate)
+			for (const auto& itemSize : itemSizes | std::views::drop(startIndices.back()))
 			{
-				maxHeight = std::max(maxHeight, itemSizes.at(index).cy);
+				maxHeight = std::max(maxHeight, itemSize.cy);
 			}
 			rowSizes.push_back(maxHeight);
 		}
@@ -356,20 +405,25 @@ namespace PGUI::UI::Layout
 			const auto endIndex = static_cast<std::size_t>(index + 1) < startIndices.size()
 				? startIndices[index + 1] - 1
 				: GetItemCount() - 1;
-			RearrangeHorizontalRow(startIndex, endIndex, currentY, rowCount);
+			RearrangeHorizontalRow(itemSizes, startIndex, endIndex, currentY, rowCount);
 			currentY += rowSize + crossAxisGap;
 		}
 	}
 
-	auto StackLayout::RearrangeVerticalWrap() noexcept -> void
+	auto StackLayout::RearrangeVerticalWrap(const std::span<const SizeF> itemSizes) noexcept -> void
 	{
 		const auto clientSize = GetSize();
-		const auto totalItemSize = GetTotalItemSize();
+		const auto totalItemHeight = std::accumulate(
+			itemSizes.begin(), itemSizes.end(), 0.0F,
+			[](const float sum, const SizeF itemSize)
+			{
+				return sum + itemSize.cy;
+			});
 		const auto availableHeight = clientSize.cy - padding.startPad - padding.endingPad;
 
-		if (totalItemSize.cy + (GetItemCount() - 1) * mainAxisGap <= availableHeight)
+		if (totalItemHeight + (GetItemCount() - 1) * mainAxisGap <= availableHeight)
 		{
-			RearrangeVerticalNoWrap();
+			RearrangeVerticalNoWrap(itemSizes);
 			return;
 		}
 
@@ -380,19 +434,11 @@ namespace PGUI::UI::Layout
 		startIndices.reserve(GetItemCount());
 		startIndices.push_back(0);
 
-		std::vector<SizeF> itemSizes;
-		itemSizes.reserve(GetItemCount());
-		for (const auto& item : GetItems())
-		{
-			itemSizes.push_back(MeasureItem(item));
-		}
-
 		float currentColumnSize = 0;
 		float maxWidth = 0;
 
-		for (const auto& [index, item] : GetItems() | std::views::enumerate)
+		for (const auto& [index, itemSize] : itemSizes | std::views::enumerate)
 		{
-			const auto& itemSize = itemSizes.at(index);
 			if (currentColumnSize + itemSize.cy > availableHeight)
 			{
 				columnSizes.push_back(maxWidth);
@@ -406,12 +452,9 @@ namespace PGUI::UI::Layout
 
 		while (columnSizes.size() < startIndices.size())
 		{
-			for ([[maybe_unused]] const auto& [index, item] :
-			     GetItems() |
-			     std::views::drop(startIndices.back()) |
-			     std::views::enumerate)
+			for (const auto& itemSize : itemSizes | std::views::drop(startIndices.back()))
 			{
-				maxWidth = std::max<float>(maxWidth, itemSizes.at(index).cx);
+				maxWidth = std::max<float>(maxWidth, itemSize.cx);
 			}
 			columnSizes.push_back(maxWidth);
 		}
@@ -467,12 +510,13 @@ namespace PGUI::UI::Layout
 			const auto endIndex = static_cast<std::size_t>(index + 1) < startIndices.size()
 				? startIndices[index + 1] - 1
 				: GetItemCount() - 1;
-			RearrangeVerticalColumn(startIndex, endIndex, currentX, columnCount);
+			RearrangeVerticalColumn(itemSizes, startIndex, endIndex, currentX, columnCount);
 			currentX += columnSize + crossAxisGap;
 		}
 	}
 
 	auto StackLayout::RearrangeHorizontalRow(
+		const std::span<const SizeF> itemSizes,
 		const std::size_t startChildIndex,
 		const std::size_t endChildIndex,
 		float yPosition, const std::size_t rowCount) noexcept -> void
@@ -483,17 +527,18 @@ namespace PGUI::UI::Layout
 		                      static_cast<float>(rowCount - 1) * crossAxisGap)) /
 		                    static_cast<float>(rowCount);
 
+		const auto rowItemSizes = itemSizes.subspan(startChildIndex, endChildIndex - startChildIndex + 1);
+
 		switch (GetMainAxisAlignment())
 		{
 			case MainAxisAlignment::Center:
 			{
 				const auto totalWidth =
 					std::accumulate(
-						GetItems().begin() + startChildIndex,
-						GetItems().begin() + endChildIndex + 1, 0.0F,
-						[](float sum, const auto& item)
+						rowItemSizes.begin(), rowItemSizes.end(), 0.0F,
+						[](const float sum, const SizeF itemSize)
 						{
-							return sum + MeasureItem(item).cx;
+							return sum + itemSize.cx;
 						}) + static_cast<float>(endChildIndex - startChildIndex) * mainAxisGap;
 				const auto availableWidth = GetSize().cx -
 				                            padding.startPad - padding.endingPad;
@@ -504,11 +549,10 @@ namespace PGUI::UI::Layout
 			{
 				const auto totalWidth =
 					std::accumulate(
-						GetItems().begin() + startChildIndex,
-						GetItems().begin() + endChildIndex + 1, 0.0F,
-						[](float sum, const auto& item)
+						rowItemSizes.begin(), rowItemSizes.end(), 0.0F,
+						[](const float sum, const SizeF itemSize)
 						{
-							return sum + MeasureItem(item).cx;
+							return sum + itemSize.cx;
 						}) + static_cast<float>(endChildIndex - startChildIndex) * mainAxisGap;
 				const auto availableWidth = GetSize().cx -
 				                            padding.startPad - padding.endingPad;
@@ -521,20 +565,22 @@ namespace PGUI::UI::Layout
 			}
 		}
 
-		for (auto& item : GetItems() | std::views::drop(startChildIndex) |
-		                  std::views::take(endChildIndex - startChildIndex + 1))
+		const auto rowItems = GetItems() | std::views::drop(startChildIndex) |
+		                      std::views::take(endChildIndex - startChildIndex + 1);
+		for (const auto& [item, itemSize] : std::views::zip(rowItems, rowItemSizes))
 		{
-			MoveItem(item, { currentX, yPosition });
-			const auto itemSize = MeasureItem(item);
+			auto arrangedSize = itemSize;
 			if (GetCrossAxisAlignment() == CrossAxisAlignment::Stretch)
 			{
-				ResizeItem(item, { itemSize.cx, height });
+				arrangedSize.cy = height;
 			}
+			ArrangeItem(item, RectF{ PointF{ currentX, yPosition }, arrangedSize });
 			currentX += itemSize.cx + mainAxisGap;
 		}
 	}
 
 	auto StackLayout::RearrangeVerticalColumn(
+		const std::span<const SizeF> itemSizes,
 		const std::size_t startChildIndex,
 		const std::size_t endChildIndex,
 		float xPosition, const std::size_t columnCount) noexcept -> void
@@ -545,17 +591,18 @@ namespace PGUI::UI::Layout
 		                     static_cast<float>(columnCount - 1) * crossAxisGap)) /
 		                   static_cast<float>(columnCount);
 
+		const auto columnItemSizes = itemSizes.subspan(startChildIndex, endChildIndex - startChildIndex + 1);
+
 		switch (GetMainAxisAlignment())
 		{
 			case MainAxisAlignment::Center:
 			{
 				const auto totalHeight =
 					std::accumulate(
-						GetItems().begin() + startChildIndex,
-						GetItems().begin() + endChildIndex + 1, 0.0F,
-						[](float sum, const auto& item)
+						columnItemSizes.begin(), columnItemSizes.end(), 0.0F,
+						[](const float sum, const SizeF itemSize)
 						{
-							return sum + MeasureItem(item).cy;
+							return sum + itemSize.cy;
 						}) + static_cast<float>(endChildIndex - startChildIndex) * mainAxisGap;
 				const auto availableHeight = GetSize().cy -
 				                             padding.startPad - padding.endingPad;
@@ -566,11 +613,10 @@ namespace PGUI::UI::Layout
 			{
 				const auto totalHeight =
 					std::accumulate(
-						GetItems().begin() + startChildIndex,
-						GetItems().begin() + endChildIndex + 1, 0.0F,
-						[](float sum, const auto& item)
+						columnItemSizes.begin(), columnItemSizes.end(), 0.0F,
+						[](const float sum, const SizeF itemSize)
 						{
-							return sum + MeasureItem(item).cy;
+							return sum + itemSize.cy;
 						}) + static_cast<float>(endChildIndex - startChildIndex) * mainAxisGap;
 				const auto availableHeight = GetSize().cy -
 				                             padding.startPad - padding.endingPad;
@@ -583,16 +629,16 @@ namespace PGUI::UI::Layout
 			}
 		}
 
-		for (auto& item : GetItems() | std::views::drop(startChildIndex) |
-		                  std::views::take(endChildIndex - startChildIndex + 1))
+		const auto columnItems = GetItems() | std::views::drop(startChildIndex) |
+		                         std::views::take(endChildIndex - startChildIndex + 1);
+		for (const auto& [item, itemSize] : std::views::zip(columnItems, columnItemSizes))
 		{
-			MoveItem(item, { xPosition, currentY });
-			const auto itemSize = MeasureItem(item);
-
+			auto arrangedSize = itemSize;
 			if (GetCrossAxisAlignment() == CrossAxisAlignment::Stretch)
 			{
-				ResizeItem(item, { width, itemSize.cy });
+				arrangedSize.cx = width;
 			}
+			ArrangeItem(item, RectF{ PointF{ xPosition, currentY }, arrangedSize });
 			currentY += itemSize.cy + mainAxisGap;
 		}
 	}
@@ -0,0 +1,341 @@
+module PGUI.UI.Layout.VirtualizingStackLayout;
+
+import std;
+
+import PGUI.Utils;
+import PGUI.ErrorHandling;
+
+namespace PGUI::UI::Layout
+{
+	// Corrected extents can change which items are visible, realization is repeated
+	// at most this many times per pass to settle it
+	constexpr auto MaxRealizationPasses = 3;
+
+	VirtualizingStackLayout::VirtualizingStackLayout(
+		const RectF bounds,
+		const LayoutOrientation orientation,
+		const std::size_t itemCount,
+		ItemExtentEstimator estimator,
+		ItemRealizer realizer,
+		ItemRecycler recycler) noexcept :
+		LayoutPanel{ bounds },
+		orientation{ orientation },
+		estimator{ MoveChecked(estimator) },
+		realizer{ MoveChecked(realizer) },
+		recycler{ MoveChecked(recycler) },
+		viewport{ PointF{ 0, 0 }, bounds.Size() }
+	{
+		AppendEstimates(itemCount);
+	}
+
+	VirtualizingStackLayout::~VirtualizingStackLayout() noexcept
+	{
+		RecycleAll();
+	}
+
+	auto VirtualizingStackLayout::RearrangeItems() noexcept -> void
+	{
+		if (extents.IsEmpty())
+		{
+			RecycleAll();
+			return;
+		}
+
+		// Keeps the first visible item in place on screen while estimates above it get corrected
+		const auto anchorIndex = std::min(
+			extents.FindByPrefixSum(std::max(scrollOffset, 0.0)), extents.Size() - 1);
+		const auto anchorShift = extents.PrefixSum(anchorIndex) - scrollOffset;
+
+		const auto crossExtent = CrossAxis(GetSize());
+		constexpr auto unbounded = std::numeric_limits<float>::infinity();
+		const auto constraint = orientation == LayoutOrientation::Horizontal
+			? SizeF{ unbounded, crossExtent }
+			: SizeF{ crossExtent, unbounded };
+
+		for (auto pass = 0; pass < MaxRealizationPasses; pass++)
+		{
+			const auto [first, last] = GetRealizationRange();
+			RecycleOutside(first, last);
+
+			auto extentsChanged = false;
+			for (auto index = first; index < last; index++)
+			{
+				auto iter = realizedItems.find(index);
+				if (iter == realizedItems.end())
+				{
+					auto item = realizer ? realizer(index) : std::nullopt;
+					if (!item.has_value())
+					{
+						continue;
+					}
+					iter = realizedItems.emplace(index, *item).first;
+				}
+
+				if (const auto extent = MainAxis(iter->second.Measure(constraint));
+					extent != extents.Get(index))
+				{
+					extents.Set(index, extent);
+					extentsChanged = true;
+				}
+			}
+
+			if (!extentsChanged)
+			{
+				break;
+			}
+			SetViewportStart(extents.PrefixSum(anchorIndex) - anchorShift);
+		}
+
+		for (const auto& [index, item] : realizedItems)
+		{
+			const auto offset = static_cast<float>(extents.PrefixSum(index) - scrollOffset);
+			const auto extent = static_cast<float>(extents.Get(index));
+
+			if (orientation == LayoutOrientation::Horizontal)
+			{
+				ArrangeItem(item, RectF{ PointF{ offset, 0 }, SizeF{ extent, crossExtent } });
+			}
+			else
+			{
+				ArrangeItem(item, RectF{ PointF{ 0, offset }, SizeF{ crossExtent, extent } });
+			}
+		}
+	}
+
+	auto VirtualizingStackLayout::Measure(const SizeF availableSize) noexcept -> SizeF
+	{
+		auto crossExtent = CrossAxis(availableSize);
+		if (!std::isfinite(crossExtent))
+		{
+			crossExtent = CrossAxis(GetSize());
+		}
+
+		if (orientation == LayoutOrientation::Horizontal)
+		{
+			return SizeF{ GetContentExtent(), crossExtent };
+		}
+		return SizeF{ crossExtent, GetContentExtent() };
+	}
+
+	auto VirtualizingStackLayout::SetOrientation(const LayoutOrientation newOrientation) noexcept -> void
+	{
+		if (orientation == newOrientation)
+		{
+			return;
+		}
+
+		orientation = newOrientation;
+		scrollOffset = orientation == LayoutOrientation::Horizontal ? viewport.left : viewport.top;
+
+		// Extents along the old axis mean nothing now
+		const auto count = extents.Size();
+		RecycleAll();
+		extents.Clear();
+		AppendEstimates(count);
+
+		InvalidateMeasure();
+	}
+
+	auto VirtualizingStackLayout::SetVirtualItemCount(const std::size_t count) noexcept -> void
+	{
+		if (count == extents.Size())
+		{
+			return;
+		}
+
+		if (count < extents.Size())
+		{
+			RecycleOutside(0, count);
+			extents.Resize(count);
+		}
+		else
+		{
+			AppendEstimates(count - extents.Size());
+		}
+
+		InvalidateMeasure();
+	}
+
+	auto VirtualizingStackLayout::SetViewport(const RectF newViewport) noexcept -> void
+	{
+		if (viewport == newViewport)
+		{
+			return;
+		}
+
+		// A viewport handed back from GetViewport keeps the exact offset it was narrowed from
+		if (const auto start = orientation == LayoutOrientation::Horizontal ? newViewport.left : newViewport.top;
+			start != static_cast<float>(scrollOffset))
+		{
+			scrollOffset = start;
+		}
+		viewport = newViewport;
+		InvalidateArrange();
+	}
+
+	auto VirtualizingStackLayout::SetScrollOffset(const double offset) noexcept -> void
+	{
+		if (scrollOffset != offset)
+		{
+			SetViewportStart(offset);
+			InvalidateArrange();
+		}
+	}
+
+	auto VirtualizingStackLayout::SetOverscan(const std::size_t count) noexcept -> void
+	{
+		if (overscan != count)
+		{
+			overscan = count;
+			InvalidateArrange();
+		}
+	}
+
+	auto VirtualizingStackLayout::SetItemExtent(const std::size_t index, const float extent) noexcept -> Result<void>
+	{
+		if (index >= extents.Size())
+		{
+			return Unexpected{ Error{ ErrorCode::OutOfRange } };
+		}
+		if (extent < 0.0F)
+		{
+			return Unexpected{ Error{ ErrorCode::InvalidArgument }.SuggestFix(L"Extent cannot be negative") };
+		}
+
+		if (extents.Get(index) != extent)
+		{
+			extents.Set(index, extent);
+			InvalidateMeasure();
+		}
+
+		return EmptyResult;
+	}
+
+	auto VirtualizingStackLayout::GetItemExtent(const std::size_t index) const noexcept -> Result<float>
+	{
+		if (index >= extents.Size())
+		{
+			return Unexpected{ Error{ ErrorCode::OutOfRange } };
+		}
+
+		return static_cast<float>(extents.Get(index));
+	}
+
+	auto VirtualizingStackLayout::GetItemOffset(const std::size_t index) const noexcept -> Result<float>
+	{
+		if (index >= extents.Size())
+		{
+			return Unexpected{ Error{ ErrorCode::OutOfRange } };
+		}
+
+		return static_cast<float>(extents.PrefixSum(index));
+	}
+
+	auto VirtualizingStackLayout::GetIndexAtOffset(const float offset) const noexcept -> Result<std::size_t>
+	{
+		if (offset < 0.0F || offset >= extents.Total())
+		{
+			return Unexpected{ Error{ ErrorCode::OutOfRange } };
+		}
+
+		return extents.FindByPrefixSum(offset);
+	}
+
+	auto VirtualizingStackLayout::GetContentExtent() const noexcept -> float
+	{
+		return static_cast<float>(extents.Total());
+	}
+
+	auto VirtualizingStackLayout::ScrollToIndex(const std::size_t index) noexcept -> Result<void>
+	{
+		if (index >= extents.Size())
+		{
+			return Unexpected{ Error{ ErrorCode::OutOfRange } };
+		}
+
+		SetViewportStart(extents.PrefixSum(index));
+		InvalidateArrange();
+
+		return EmptyResult;
+	}
+
+	auto VirtualizingStackLayout::MainAxis(const SizeF size) const noexcept -> float
+	{
+		return orientation == LayoutOrientation::Horizontal ? size.cx : size.cy;
+	}
+
+	auto VirtualizingStackLayout::CrossAxis(const SizeF size) const noexcept -> float
+	{
+		return orientation == LayoutOrientation::Horizontal ? size.cy : size.cx;
+	}
+
+	auto VirtualizingStackLayout::GetViewportExtent() const noexcept -> float
+	{
+		if (const auto extent = MainAxis(viewport.Size());
+			extent > 0.0F)
+		{
+			return extent;
+		}
+		return MainAxis(GetSize());
+	}
+
+	auto VirtualizingStackLayout::SetViewportStart(const double start) noexcept -> void
+	{
+		scrollOffset = start;
+		if (orientation == LayoutOrientation::Horizontal)
+		{
+			viewport.Move(PointF{ static_cast<float>(start), viewport.top });
+		}
+		else
+		{
+			viewport.Move(PointF{ viewport.left, static_cast<float>(start) });
+		}
+	}
+
+	auto VirtualizingStackLayout::AppendEstimates(const std::size_t count) noexcept -> void
+	{
+		const auto first = extents.Size();
+		for (auto index = first; index < first + count; index++)
+		{
+			extents.PushBack(estimator ? std::max(estimator(index), 0.0F) : 0.0F);
+		}
+	}
+
+	auto VirtualizingStackLayout::GetRealizationRange() const noexcept -> std::pair<std::size_t, std::size_t>
+	{
+		const auto count = extents.Size();
+		if (count == 0)
+		{
+			return { 0, 0 };
+		}
+
+		const auto start = std::max(scrollOffset, 0.0);
+		const auto first = std::min(extents.FindByPrefixSum(start), count - 1);
+		const auto last = std::min(extents.FindByPrefixSum(start + GetViewportExtent()) + 1, count);
+
+		return { first - std::min(first, overscan), std::min(last + overscan, count) };
+	}
+
+	auto VirtualizingStackLayout::RecycleOutside(const std::size_t first, const std::size_t last) noexcept -> void
+	{
+		for (auto iter = realizedItems.begin(); iter != realizedItems.end();)
+		{
+			if (iter->first >= first && iter->first < last)
+			{
+				++iter;
+				continue;
+			}
+
+			if (recycler)
+			{
+				recycler(iter->first, iter->second);
+			}
+			iter = realizedItems.erase(iter);
+		}
+	}
+
+	auto VirtualizingStackLayout::RecycleAll() noexcept -> void
+	{
+		RecycleOutside(0, 0);
+	}
+}
@@ -6,12 +6,24 @@ import :UIEvent;
 
 import PGUI.UI.Graphics;
 import PGUI.UI.D2D.D2DEnums;
+import PGUI.UI.Layout;
+import PGUI.WorkStealingPool;
 import PGUI.Utils;
 
 import std;
 
 namespace PGUI::UI
 {
+	namespace
+	{
+		// Room the element takes up in the linear order of its parent
+		[[nodiscard]] auto GetSubtreeSize(const RawUIElementPtr<> element) noexcept -> std::size_t
+		{
+			const auto container = element->AsContainer();
+			return container != nullptr ? 1 + container->GetLinearElementCount() : 1;
+		}
+	}
+
 	UIContainer::UIContainer(const RectF& rect) noexcept :
 		UIElement{ rect }
 	{
@@ -21,21 +33,31 @@ namespace PGUI::UI
 
 	auto UIContainer::RemoveChildElement(RawUIElementPtr<> element) -> Result<UIElementPtr<>>
 	{
-		const auto it = std::ranges::find_if(
-			children,
-			[element](const auto& child)
-			{
-				return child.get() == element;
-			});
-
-		if (it == children.end())
+		const auto dataIt = childAssociatedData.find(element);
+		if (dataIt == childAssociatedData.end())
 		{
 			return Unexpected{ Error{ ErrorCode::NotFound } };
 		}
 
+		const auto slot = dataIt->second.order;
+		const auto it = std::next(children.begin(), static_cast<std::ptrdiff_t>(occupiedSlots.PrefixSum(slot)));
+		const auto removedSize = subtreeSizes.Get(slot);
+
+		// The slot stays behind empty, so no other child needs renumbering
+		subtreeSizes.Set(slot, 0);
+		occupiedSlots.Set(slot, 0);
+		childSlots[slot] = nullptr;
+		freeSlotCount++;
+
 		auto elementPtr = MoveChecked(*it);
 		children.erase(it);
 		ChildRemovedEvent().Invoke(element);
+		PropagateSubtreeSizeChange(-static_cast<std::ptrdiff_t>(removedSize));
+
+		if (freeSlotCount > childSlots.size() / 2)
+		{
+			CompactSlots();
+		}
 
 		return elementPtr;
 	}
@@ -50,44 +72,48 @@ namespace PGUI::UI
 		return RemoveChildElement(children.at(index).get());
 	}
 
-	auto UIContainer::GetElementIndex(RawUIElementPtr<> element) const noexcept -> Result<std::size_t>
+	auto UIContainer::GetElementIndex(const RawUIElementPtr<> element) const noexcept -> Result<std::size_t>
 	{
-		const auto it = std::ranges::find_if(
-			children,
-			[element](const auto& child)
-			{
-				return child.get() == element;
-			});
-
-		if (it == children.end())
+		if (const auto it = childAssociatedData.find(element);
+			it != childAssociatedData.end())
 		{
-			return Unexpected{ Error{ ErrorCode::NotFound } };
+			return occupiedSlots.PrefixSum(it->second.order);
 		}
 
-		return std::distance(children.begin(), it);
+		return Unexpected{ Error{ ErrorCode::NotFound } };
 	}
 
 	auto UIContainer::GetElementLinearIndex(const RawUIElementPtr<> element) const noexcept -> Result<std::size_t>
 	{
-		std::size_t offset = 0;
+		std::size_t index = 0;
 
-		for (const auto& child : children)
+		for (auto child = element; child != nullptr; )
 		{
-			if (element == child.get())
+			const auto parent = child->GetParent();
+			if (parent == nullptr)
 			{
-				return offset;
+				break;
 			}
-			if (const auto container = dynamic_cast<UIContainer*>(child.get());
-				container != nullptr)
+			const auto container = parent->AsContainer();
+			if (container == nullptr)
 			{
-				if (const auto result = container->GetElementLinearIndex(element);
-					result.has_value())
-				{
-					return offset + result.value();
-				}
-				offset += container->GetLinearElementCount();
+				break;
 			}
-			offset++;
+			const auto it = container->childAssociatedData.find(child);
+			if (it == container->childAssociatedData.end())
+			{
+				break;
+			}
+
+			index += container->subtreeSizes.PrefixSum(it->second.order);
+			if (container == this)
+			{
+				return index;
+			}
+
+			// The container itself comes right before its elements
+			index++;
+			child = container;
 		}
 
 		return Unexpected{ Error{ ErrorCode::NotFound } };
@@ -105,25 +131,7 @@ namespace PGUI::UI
 
 	auto UIContainer::GetLinearElementCount() const noexcept -> std::size_t
 	{
-		auto count = GetChildElementCount();
-
-		const auto isContainer = [](const auto& element)
-		{
-			return dynamic_cast<UIContainer*>(element.get()) != nullptr;
-		};
-		const auto getContainer = [](const auto& element)
-		{
-			return dynamic_cast<UIContainer*>(element.get());
-		};
-
-		for (const auto& child : children
-		                         | std::views::filter(isContainer)
-		                         | std::views::transform(getContainer))
-		{
-			count += child->GetLinearElementCount();
-		}
-
-		return count;
+		return subtreeSizes.Total();
 	}
 
 	auto UIContainer::GetElementAtLinearIndex(std::size_t index) const noexcept -> Result<RawUIElementPtr<>>
@@ -133,30 +141,22 @@ namespace PGUI::UI
 			return Unexpected{ Error{ ErrorCode::OutOfRange } };
 		}
 
-		for (const auto& child : GetChildElements())
+		auto container = this;
+		while (true)
 		{
-			if (const auto container = dynamic_cast<UIContainer*>(child.get());
-				container != nullptr)
-			{
-				const auto subCount = container->GetLinearElementCount();
-				if (index < subCount)
-				{
-					return container->GetElementAtLinearIndex(index);
-				}
-				index -= subCount;
-
-				continue;
-			}
+			const auto childIndex = container->subtreeSizes.FindByPrefixSum(index);
+			index -= container->subtreeSizes.PrefixSum(childIndex);
 
+			const auto child = container->childSlots[childIndex];
 			if (index == 0)
 			{
-				return child.get();
+				return child;
 			}
 
+			// Only containers have a subtree size above one
+			container = child->AsContainer();
 			index--;
 		}
-
-		return Unexpected{ Error{ ErrorCode::NotFound } };
 	}
 
 	auto UIContainer::GetElementAtPosition(const PointF point) const noexcept -> Result<RawUIElementPtr<>>
@@ -170,27 +170,44 @@ namespace PGUI::UI
 			};
 		}
 
-		const auto hitTestPoint = [point](const auto& element)
+		// Containers without an element at the point don't stop the search
+		const auto resolveChild = [point](const RawUIElementPtr<> child) -> RawUIElementPtr<>
 		{
-			return element->GetRect().Contains(point);
+			if (const auto container = child->AsContainer();
+				container != nullptr)
+			{
+				return container->GetElementAtPosition(point).value_or(nullptr);
+			}
+			return child;
 		};
 
-		for (const auto& child : children
-		                         | std::views::reverse
-		                         | std::views::filter(hitTestPoint))
+		if (spatialIndex.has_value())
 		{
-			if (const auto container = dynamic_cast<UIContainer*>(child.get());
-				container != nullptr)
+			for (const auto child : GetIndexedChildrenAt(point))
 			{
-				if (const auto result = container->GetElementAtPosition(point);
-					result.has_value())
+				if (const auto element = resolveChild(child);
+					element != nullptr)
 				{
-					return result;
+					return element;
 				}
 			}
-			else
+		}
+		else
+		{
+			const auto hitTestPoint = [point](const auto& element)
 			{
-				return child.get();
+				return element->GetRect().Contains(point);
+			};
+
+			for (const auto& child : children
+			                         | std::views::reverse
+			                         | std::views::filter(hitTestPoint))
+			{
+				if (const auto element = resolveChild(child.get());
+					element != nullptr)
+				{
+					return element;
+				}
 			}
 		}
 
@@ -200,11 +217,143 @@ namespace PGUI::UI
 		};
 	}
 
+	auto UIContainer::GetChildElementsInRect(const RectF rect) const noexcept -> std::vector<RawUIElementPtr<>>
+	{
+		if (!spatialIndex.has_value())
+		{
+			return children
+			       | std::views::transform([](const auto& child) { return child.get(); })
+			       | std::views::filter([rect](const auto child) { return child->GetRect().Intersects(rect); })
+			       | std::ranges::to<std::vector>();
+		}
+
+		std::vector<std::pair<std::size_t, RawUIElementPtr<>>> found;
+		spatialIndex->QueryRect(rect, [this, rect, &found](SpatialIndex::ProxyId, const RawUIElementPtr<> child)
+		{
+			if (child->GetRect().Intersects(rect))
+			{
+				found.emplace_back(childAssociatedData.at(child).order, child);
+			}
+		});
+		std::ranges::sort(found);
+
+		return found
+		       | std::views::values
+		       | std::ranges::to<std::vector>();
+	}
+
+	auto UIContainer::GetIndexedChildrenAt(const PointF point) const noexcept -> std::vector<RawUIElementPtr<>>
+	{
+		std::vector<std::pair<std::size_t, RawUIElementPtr<>>> found;
+		spatialIndex->QueryPoint(point, [this, point, &found](SpatialIndex::ProxyId, const RawUIElementPtr<> child)
+		{
+			if (child->GetRect().Contains(point))
+			{
+				found.emplace_back(childAssociatedData.at(child).order, child);
+			}
+		});
+		std::ranges::sort(found, std::ranges::greater{ });
+
+		return found
+		       | std::views::values
+		       | std::ranges::to<std::vector>();
+	}
+
+	auto UIContainer::EnableSpatialIndex(const bool enable) noexcept -> void
+	{
+		if (enable == spatialIndex.has_value())
+		{
+			return;
+		}
+
+		if (!enable)
+		{
+			spatialIndex.reset();
+			for (auto& data : childAssociatedData | std::views::values)
+			{
+				data.proxyId = SpatialIndex::NullProxy;
+			}
+			return;
+		}
+
+		spatialIndex.emplace();
+		for (const auto& child : children)
+		{
+			if (const auto it = childAssociatedData.find(child.get());
+				it != childAssociatedData.end())
+			{
+				it->second.proxyId = spatialIndex->CreateProxy(child->GetRect(), child.get());
+			}
+		}
+	}
+
+	auto UIContainer::UpdateChildBounds(const RawUIElementPtr<> element) noexcept -> void
+	{
+		if (!spatialIndex.has_value())
+		{
+			return;
+		}
+
+		if (const auto it = childAssociatedData.find(element);
+			it != childAssociatedData.end() && it->second.proxyId != SpatialIndex::NullProxy)
+		{
+			spatialIndex->MoveProxy(it->second.proxyId, element->GetRect());
+		}
+	}
+
 	auto UIContainer::IsChildElementVisible(const RawUIElementPtr<> element) const noexcept -> bool
 	{
 		return element->GetRect().Intersects(GetRect());
 	}
 
+	auto UIContainer::SetLayoutPanel(std::unique_ptr<Layout::LayoutPanel> panel) noexcept -> void
+	{
+		if (layoutPanel)
+		{
+			layoutPanel->LayoutInvalidatedEvent().RemoveCallback(layoutInvalidatedCallbackId);
+		}
+
+		layoutPanel = MoveChecked(panel);
+		if (layoutPanel)
+		{
+			layoutInvalidatedCallbackId = layoutPanel->LayoutInvalidatedEvent().AddCallback([this]
+			{
+				MarkLayoutPending();
+				RequestRedraw();
+			});
+			MarkLayoutPending();
+			RequestRedraw();
+		}
+	}
+
+	auto UIContainer::UpdateLayout() noexcept -> void
+	{
+		if (!isLayoutPending)
+		{
+			return;
+		}
+		// Cleared first, panels invalidated while this runs mark it again for the next frame
+		isLayoutPending = false;
+
+		if (layoutPanel && layoutPool != nullptr)
+		{
+			layoutPanel->UpdateLayout(*layoutPool);
+		}
+		else if (layoutPanel)
+		{
+			layoutPanel->UpdateLayout();
+		}
+
+		for (const auto& child : children)
+		{
+			if (const auto container = child->AsContainer();
+				container != nullptr)
+			{
+				container->UpdateLayout();
+			}
+		}
+	}
+
 	auto UIContainer::Render(const Graphics& graphics) noexcept -> void
 	{
 		EnsureZOrder();
@@ -214,11 +363,25 @@ namespace PGUI::UI
 			graphics.PushAxisAlignedClip(GetRect(), D2D::AntiAliasingMode::PerPrimitive);
 		}
 
-		for (const auto& child : children
-		                         | std::views::transform([](const auto& childElement) { return childElement.get(); })
-		                         | std::views::filter(std::bind_front(&UIContainer::IsChildElementVisible, this)))
+		// Children are culled against what the clips and transforms above still leave on screen,
+		// that includes the repainted area. A child's subtree is expected to stay inside its rect
+		const auto visibleBounds = graphics.GetLocalVisibleBounds();
+		const auto area = visibleBounds.has_value() ? visibleBounds->IntersectionRect(GetRect()) : std::nullopt;
+		if (area.has_value() && spatialIndex.has_value())
 		{
-			child->Render(graphics);
+			for (const auto child : GetChildElementsInRect(*area))
+			{
+				child->RenderCached(graphics);
+			}
+		}
+		else if (area.has_value())
+		{
+			for (const auto& child : children
+			                         | std::views::transform([](const auto& childElement) { return childElement.get(); })
+			                         | std::views::filter([&area](const auto child) { return child->GetRect().Intersects(*area); }))
+			{
+				child->RenderCached(graphics);
+			}
 		}
 
 		if (clipRendering)
@@ -236,6 +399,13 @@ namespace PGUI::UI
 			return false;
 		}
 
+		if (spatialIndex.has_value())
+		{
+			return std::ranges::any_of(
+				GetIndexedChildrenAt(point),
+				[point](const auto child) { return child->HitTest(point); });
+		}
+
 		for (const auto& child : children | std::views::reverse)
 		{
 			if (child->HitTest(point))
@@ -259,6 +429,8 @@ namespace PGUI::UI
 	{
 		for (const auto& child : children)
 		{
+			// Recorded lists may reference resources the child is about to recreate
+			child->InvalidateDisplayList();
 			child->DiscardDeviceResources();
 		}
 	}
@@ -267,51 +439,74 @@ namespace PGUI::UI
 	{
 		isZOrderDirty = true;
 
-		const auto zIndexCallbackId = element->ZIndexEvent().AddObserver(
-			std::bind_front(&UIContainer::OnChildZIndexChangedEvent, this, element)
-		);
 		const auto redrawRequestCallbackId = element->RedrawRequestedEvent().AddCallback(
 			std::bind_front(&UIContainer::OnChildRedrawRequestedEvent, this)
 		);
 
 		element->host = GetHost();
+		element->parent = this;
 
+		// Children are appended before the event is raised
+		const auto proxyId = spatialIndex.has_value() ?
+			                     spatialIndex->CreateProxy(element->GetRect(), element) :
+			                     SpatialIndex::NullProxy;
 		childAssociatedData.emplace(
 			element,
 			ChildAssociatedData
 			{
-				.zIndexCallbackId = zIndexCallbackId,
-				.redrawRequestCallbackId = redrawRequestCallbackId
+				.redrawRequestCallbackId = redrawRequestCallbackId,
+				.order = childSlots.size(),
+				.proxyId = proxyId
 			});
+
+		if (const auto container = element->AsContainer();
+			container != nullptr && container->isLayoutPending)
+		{
+			MarkLayoutPending();
+		}
+
+		const auto subtreeSize = GetSubtreeSize(element);
+		childSlots.push_back(element);
+		subtreeSizes.PushBack(subtreeSize);
+		occupiedSlots.PushBack(1);
+		PropagateSubtreeSizeChange(static_cast<std::ptrdiff_t>(subtreeSize));
 	}
 
 	auto UIContainer::OnChildRemovedEvent(const RawUIElementPtr<> element) noexcept -> void
 	{
 		if (childAssociatedData.contains(element)) [[likely]]
 		{
-			const auto& [zIndexChangedId, redrawRequestCallbackId] = childAssociatedData.at(element);
-			element->ZIndexEvent().RemoveObserver(zIndexChangedId);
-			element->RedrawRequestedEvent().RemoveCallback(redrawRequestCallbackId);
+			const auto& data = childAssociatedData.at(element);
+			element->RedrawRequestedEvent().RemoveCallback(data.redrawRequestCallbackId);
+			if (spatialIndex.has_value() && data.proxyId != SpatialIndex::NullProxy)
+			{
+				spatialIndex->DestroyProxy(data.proxyId);
+			}
 		}
 
 		if (element->GetHost() == GetHost()) [[likely]]
 		{
 			element->host = nullptr;
 		}
+		if (element->GetParent() == this) [[likely]]
+		{
+			element->parent = nullptr;
+		}
 
 		childAssociatedData.erase(element);
 	}
 
-	auto UIContainer::OnChildZIndexChangedEvent(RawUIElementPtr<>, ZIndex) noexcept -> void
+	auto UIContainer::OnChildZIndexChanged(RawUIElementPtr<>) noexcept -> void
 	{
 		isZOrderDirty = true;
 	}
 
-	auto UIContainer::OnChildRedrawRequestedEvent(const RawUIElementPtr<> element) noexcept -> void
+	auto UIContainer::OnChildRedrawRequestedEvent(RawUIElementPtr<>, const RectF area) noexcept -> void
 	{
-		if (IsChildElementVisible(element))
+		if (const auto visibleArea = area.IntersectionRect(GetRect());
+			visibleArea.has_value())
 		{
-			RequestRedraw();
+			RequestRedraw(*visibleArea);
 		}
 	}
 
@@ -329,6 +524,116 @@ namespace PGUI::UI
 
 		std::ranges::stable_sort(children, zIndexComparator);
 
+		// Children outside the run that moved keep their slots
+		auto first = 0ULL;
+		auto firstSlot = 0ULL;
+		for (; first < children.size(); first++, firstSlot++)
+		{
+			while (childSlots[firstSlot] == nullptr)
+			{
+				firstSlot++;
+			}
+			if (childSlots[firstSlot] != children[first].get())
+			{
+				break;
+			}
+		}
+		if (first == children.size())
+		{
+			isZOrderDirty = false;
+			return;
+		}
+
+		auto last = children.size() - 1;
+		auto lastSlot = childSlots.size() - 1;
+		for (;; last--, lastSlot--)
+		{
+			while (childSlots[lastSlot] == nullptr)
+			{
+				lastSlot--;
+			}
+			if (childSlots[lastSlot] != children[last].get())
+			{
+				break;
+			}
+		}
+
+		// The moved children share the same slots as before, only in a new order
+		const auto moved = std::span{ children }.subspan(first, last - first + 1);
+		const auto sizes = moved
+		                   | std::views::transform([this](const auto& child)
+		                   {
+			                   return subtreeSizes.Get(childAssociatedData.at(child.get()).order);
+		                   })
+		                   | std::ranges::to<std::vector>();
+
+		auto slot = firstSlot;
+		for (const auto [child, size] : std::views::zip(moved, sizes))
+		{
+			while (childSlots[slot] == nullptr)
+			{
+				slot++;
+			}
+			childSlots[slot] = child.get();
+			childAssociatedData.at(child.get()).order = slot;
+			subtreeSizes.Set(slot, size);
+			slot++;
+		}
+
 		isZOrderDirty = false;
 	}
+
+	auto UIContainer::CompactSlots() noexcept -> void
+	{
+		std::vector<std::size_t> sizes;
+		sizes.reserve(children.size());
+		childSlots.clear();
+
+		for (const auto& child : children)
+		{
+			auto& data = childAssociatedData.at(child.get());
+			sizes.push_back(subtreeSizes.Get(data.order));
+			data.order = childSlots.size();
+			childSlots.push_back(child.get());
+		}
+
+		subtreeSizes = FenwickTree<std::size_t>{ sizes };
+		occupiedSlots = FenwickTree<std::size_t>{ children.size(), 1 };
+		freeSlotCount = 0;
+	}
+
+	auto UIContainer::MarkLayoutPending() noexcept -> void
+	{
+		for (auto container = this; container != nullptr && !container->isLayoutPending; )
+		{
+			container->isLayoutPending = true;
+
+			const auto parent = container->GetParent();
+			container = parent != nullptr ? parent->AsContainer() : nullptr;
+		}
+	}
+
+	auto UIContainer::PropagateSubtreeSizeChange(const std::ptrdiff_t delta) noexcept -> void
+	{
+		// Negative deltas wrap around, the unsigned sums still come out right
+		const auto change = static_cast<std::size_t>(delta);
+
+		RawUIElementPtr<> child = this;
+		for (auto parent = GetParent(); parent != nullptr; parent = parent->GetParent())
+		{
+			const auto container = parent->AsContainer();
+			if (container == nullptr)
+			{
+				return;
+			}
+			const auto it = container->childAssociatedData.find(child);
+			if (it == container->childAssociatedData.end())
+			{
+				return;
+			}
+
+			container->subtreeSizes.Add(it->second.order, change);
+			child = container;
+		}
+	}
 }
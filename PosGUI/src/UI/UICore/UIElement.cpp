@@ -6,11 +6,65 @@ module PGUI.UI.UICore:UIElement;
 import :Interface;
 import :UIEvent;
 import :UIHost;
+import :UIContainer;
 
+import std;
+
+import PGUI.DataBinding;
+import PGUI.Utils;
 import PGUI.UI.D2D.D2DEnums;
+import PGUI.UI.Graphics;
+import PGUI.UI.DisplayList;
 
 namespace PGUI::UI
 {
+	namespace
+	{
+		thread_local UIElementPropertyStore* currentStore = nullptr;
+	}
+
+	UIElementPropertyStore::Scope::Scope(UIElementPropertyStore& store) noexcept :
+		previous{ std::exchange(currentStore, &store) }
+	{
+	}
+
+	UIElementPropertyStore::Scope::~Scope() noexcept
+	{
+		currentStore = previous;
+	}
+
+	UIElementPropertyStore::~UIElementPropertyStore() noexcept
+	{
+		// Elements still alive would release their slots into freed tables
+		if constexpr (IsDebugBuild)
+		{
+			if (GetElementCount() != 0)
+			{
+				std::terminate();
+			}
+		}
+	}
+
+	auto UIElementPropertyStore::Current() noexcept -> UIElementPropertyStore&
+	{
+		if (currentStore != nullptr)
+		{
+			return *currentStore;
+		}
+
+		thread_local UIElementPropertyStore defaultStore;
+		return defaultStore;
+	}
+
+	auto UIElementPropertyStore::GetMemoryUsage() const noexcept -> DataBinding::PropertyTableMemoryUsage
+	{
+		auto usage = zIndices.GetMemoryUsage();
+		usage += enabledStates.GetMemoryUsage();
+		usage += focusStates.GetMemoryUsage();
+
+		return usage;
+	}
+
 	auto UIElement::SetParent(const RawUIElementPtr<> newParent) noexcept
 	{
 		parent = newParent;
@@ -25,15 +79,74 @@ namespace PGUI::UI
 		}
 	}
 
-	auto UIElement::RequestRedraw() noexcept -> void
+	auto UIElement::OnRectChanged(const RectF oldRect) noexcept -> void
 	{
-		if (parent)
+		// Both where the element was and where it is now have to be repainted
+		RequestRedraw(oldRect);
+		RequestRedraw(rect);
+
+		if (parent == nullptr)
 		{
-			parent->RedrawRequestedEvent().Invoke(this);
+			return;
 		}
-		else if (host)
+		if (const auto container = parent->AsContainer();
+			container != nullptr)
 		{
-			host->RedrawRequestedEvent().Invoke(this);
+			container->UpdateChildBounds(this);
 		}
 	}
+
+	auto UIElement::SetZIndex(const ZIndex value) noexcept -> void
+	{
+		if (zIndex.Get() == value)
+		{
+			return;
+		}
+		zIndex.Set(value);
+
+		if (parent == nullptr)
+		{
+			return;
+		}
+		if (const auto container = parent->AsContainer();
+			container != nullptr)
+		{
+			container->OnChildZIndexChanged(this);
+		}
+	}
+
+	auto UIElement::RenderCached(const Graphics& graphics) noexcept -> void
+	{
+		if (!isDisplayListValid)
+		{
+			// Recorded into a shared list first so elements that don't record never allocate their own
+			thread_local DisplayList recording;
+			recording.Clear();
+			if (!RecordDisplayList(recording))
+			{
+				Render(graphics);
+				return;
+			}
+
+			if (displayList == nullptr)
+			{
+				displayList = std::make_unique<DisplayList>();
+			}
+			std::swap(*displayList, recording);
+			isDisplayListValid = true;
+		}
+
+		displayList->Replay(graphics);
+	}
+
+	auto UIElement::RequestRedraw() noexcept -> void
+	{
+		RequestRedraw(GetRect());
+	}
+
+	auto UIElement::RequestRedraw(const RectF area) noexcept -> void
+	{
+		InvalidateDisplayList();
+		redrawRequestedEvent.Invoke(this, area);
+	}
 }
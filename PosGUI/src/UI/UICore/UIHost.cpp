@@ -13,6 +13,9 @@ import std;
 import PGUI.Utils;
 import PGUI.WindowClass;
 import PGUI.UI.DCompWindow;
+import PGUI.UI.DamageRegion;
+import PGUI.UI.Graphics;
+import PGUI.UI.D2D.D2DEnums;
 
 namespace PGUI::UI
 {
@@ -70,6 +73,8 @@ namespace PGUI::UI
 
 	auto UIHost::DiscardDeviceResources() -> void
 	{
+		// Buffers are recreated, nothing drawn before can be kept
+		repaintAll = true;
 		DCompWindow::DiscardDeviceResources();
 		if (rootContainer)
 		{
@@ -79,7 +84,10 @@ namespace PGUI::UI
 
 	auto UIHost::OnNCCreate(MessageID, Argument1, Argument2) noexcept -> MessageHandlerResult
 	{
-		rootContainer = UIElement::Create<UIContainer>(GetClientRect());
+		{
+			UIElementPropertyStore::Scope storeScope{ propertyStore };
+			rootContainer = UIElement::Create<UIContainer>(GetClientRect());
+		}
 		rootContainer->RedrawRequestedEvent().AddCallback(
 			std::bind_front(&UIHost::RedrawRequested, this)
 		);
@@ -120,14 +128,94 @@ namespace PGUI::UI
 	auto UIHost::OnMouseDoubleClick(MessageID msg, Argument1 arg1, Argument2 arg2) noexcept -> MessageHandlerResult { }
 	*/
 
-	auto UIHost::RedrawRequested(const RawUIElementPtr<>) noexcept -> void
+	auto UIHost::InvalidateAll() noexcept -> void
 	{
+		repaintAll = true;
 		Invalidate(false);
 	}
 
+	auto UIHost::RedrawRequested(const RawUIElementPtr<>, const RectF area) noexcept -> void
+	{
+		// Antialiased edges reach into the pixels around the area
+		const auto inflated = area.Inflated(1.0F, 1.0F);
+		pendingDamage.Add(inflated);
+
+		const auto physical = LogicalToPhysical(inflated);
+		Invalidate(RectF{
+			std::floor(physical.left), std::floor(physical.top),
+			std::ceil(physical.right), std::ceil(physical.bottom)
+		}, false);
+	}
+
+	auto UIHost::BeginDraw() -> void
+	{
+		// Before BeginPaint, the redraws the layout requests are validated with this frame
+		// instead of queuing another one
+		rootContainer->UpdateLayout();
+		AddSystemDamage();
+
+		DCompWindow::BeginDraw();
+	}
+
+	auto UIHost::AddSystemDamage() noexcept -> void
+	{
+		// The update region also holds what the system wants repainted, for example after the window
+		// was uncovered. The rcPaint of BeginPaint is only its bounding box.
+		const auto region = CreateRectRgn(0, 0, 0, 0);
+		if (region == nullptr)
+		{
+			repaintAll = true;
+			return;
+		}
+
+		if (GetUpdateRgn(Hwnd(), region, FALSE) > NULLREGION)
+		{
+			if (const auto size = GetRegionData(region, 0, nullptr);
+				size != 0)
+			{
+				std::vector<std::byte> buffer(size);
+				const auto data = reinterpret_cast<RGNDATA*>(buffer.data());
+				if (GetRegionData(region, size, data) == size)
+				{
+					for (const auto& rc : std::span{ reinterpret_cast<const RECT*>(data->Buffer), data->rdh.nCount })
+					{
+						pendingDamage.Add(PhysicalToLogical(RectF{ rc }));
+					}
+				}
+				else
+				{
+					repaintAll = true;
+				}
+			}
+		}
+
+		DeleteObject(region);
+	}
+
 	auto UIHost::Draw(const Graphics& graphics) noexcept -> void
 	{
-		Render(graphics);
-		rootContainer->Render(graphics);
+		const auto bounds = rootContainer->GetRect();
+
+		if (repaintAll)
+		{
+			pendingDamage.Clear();
+			pendingDamage.Add(bounds);
+			repaintAll = false;
+		}
+
+		auto damage = pendingDamage;
+		damage.Add(previousDamage);
+		damage.ClipTo(bounds);
+		previousDamage = std::exchange(pendingDamage, DamageRegion{ });
+
+		for (const auto rect : damage.GetRects())
+		{
+			graphics.PushAxisAlignedClip(rect, D2D::AntiAliasingMode::Aliased);
+
+			Render(graphics);
+			rootContainer->Render(graphics);
+
+			graphics.PopAxisAlignedClip();
+		}
 	}
 }
@@ -0,0 +1,195 @@
+module PGUI.WorkStealingPool;
+
+import std;
+import PGUI.Utils;
+
+namespace PGUI
+{
+	namespace
+	{
+		thread_local const WorkStealingPool* currentPool = nullptr;
+		thread_local std::size_t currentQueueIndex = 0;
+	}
+
+	WorkStealingPool::WorkStealingPool(const std::size_t workerCount) noexcept
+	{
+		const auto count = std::max(workerCount, std::size_t{ 1 });
+
+		queues.reserve(count + 1);
+		for (std::size_t i = 0; i < count + 1; i++)
+		{
+			queues.push_back(std::make_unique<TaskQueue>());
+		}
+
+		workers.reserve(count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			workers.emplace_back([this, i](const std::stop_token& stopToken)
+			{
+				WorkerLoop(i, stopToken);
+			});
+		}
+	}
+
+	WorkStealingPool::~WorkStealingPool() noexcept
+	{
+		for (auto& worker : workers)
+		{
+			worker.request_stop();
+		}
+		taskAvailable.notify_all();
+		workers.clear();
+	}
+
+	auto WorkStealingPool::Default() noexcept -> WorkStealingPool&
+	{
+		static WorkStealingPool pool;
+		return pool;
+	}
+
+	auto WorkStealingPool::DefaultWorkerCount() noexcept -> std::size_t
+	{
+		return std::max(std::thread::hardware_concurrency(), 2U) - 1;
+	}
+
+	auto WorkStealingPool::Submit(Task&& task) noexcept -> void
+	{
+		{
+			auto& queue = *queues[GetCurrentQueueIndex()];
+			std::scoped_lock lock{ queue.mutex };
+			queue.tasks.push_back(MoveChecked(task));
+		}
+		queuedCount.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders this with a worker that is about to sleep so the wake up isn't lost
+		{
+			std::scoped_lock lock{ sleepMutex };
+		}
+		taskAvailable.notify_one();
+	}
+
+	auto WorkStealingPool::RunPendingTask() noexcept -> bool
+	{
+		auto task = TryPop(GetCurrentQueueIndex());
+		if (!task.has_value())
+		{
+			return false;
+		}
+
+		(*task)();
+		return true;
+	}
+
+	auto WorkStealingPool::GetCurrentQueueIndex() const noexcept -> std::size_t
+	{
+		return currentPool == this ? currentQueueIndex : GetSharedQueueIndex();
+	}
+
+	auto WorkStealingPool::TryPop(const std::size_t queueIndex) noexcept -> std::optional<Task>
+	{
+		if (queuedCount.load(std::memory_order_acquire) == 0)
+		{
+			return std::nullopt;
+		}
+
+		// Own newest task first, it is the most likely to still be in cache
+		if (queueIndex != GetSharedQueueIndex())
+		{
+			auto& queue = *queues[queueIndex];
+			std::scoped_lock lock{ queue.mutex };
+			if (!queue.tasks.empty())
+			{
+				auto task = MoveChecked(queue.tasks.back());
+				queue.tasks.pop_back();
+				queuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+				return task;
+			}
+		}
+
+		for (std::size_t offset = 1; offset <= queues.size(); offset++)
+		{
+			auto& queue = *queues[(queueIndex + offset) % queues.size()];
+			std::scoped_lock lock{ queue.mutex };
+			if (!queue.tasks.empty())
+			{
+				auto task = MoveChecked(queue.tasks.front());
+				queue.tasks.pop_front();
+				queuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+				return task;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	auto WorkStealingPool::WorkerLoop(const std::size_t queueIndex, const std::stop_token& stopToken) noexcept -> void
+	{
+		currentPool = this;
+		currentQueueIndex = queueIndex;
+
+		while (!stopToken.stop_requested())
+		{
+			if (auto task = TryPop(queueIndex);
+				task.has_value())
+			{
+				(*task)();
+				continue;
+			}
+
+			std::unique_lock lock{ sleepMutex };
+			taskAvailable.wait(lock, stopToken, [this]
+			{
+				return queuedCount.load(std::memory_order_acquire) != 0;
+			});
+		}
+	}
+
+	auto WorkStealingPool::WaitForTaskOrGroup(const std::atomic<std::size_t>& pendingCount) noexcept -> void
+	{
+		std::unique_lock lock{ sleepMutex };
+		taskAvailable.wait(lock, [this, &pendingCount]
+		{
+			return pendingCount.load(std::memory_order_acquire) == 0 ||
+			       queuedCount.load(std::memory_order_acquire) != 0;
+		});
+	}
+
+	auto WorkStealingPool::NotifyGroupFinished() noexcept -> void
+	{
+		{
+			std::scoped_lock lock{ sleepMutex };
+		}
+		taskAvailable.notify_all();
+	}
+
+	auto TaskGroup::Run(WorkStealingPool::Task&& task) noexcept -> void
+	{
+		pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+		// The group may be gone as soon as the count reaches zero, so the pool is captured on its own
+		pool.get().Submit([this, &workPool = pool.get(), task = MoveChecked(task)] mutable
+		{
+			task();
+			if (pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				workPool.NotifyGroupFinished();
+			}
+		});
+	}
+
+	auto TaskGroup::Wait() noexcept -> void
+	{
+		auto& workPool = pool.get();
+		while (pendingCount.load(std::memory_order_acquire) != 0)
+		{
+			// Tasks of the group still running elsewhere either finish, which wakes this thread,
+			// or queue more work, which wakes a sleeping thread to run it
+			if (!workPool.RunPendingTask())
+			{
+				workPool.WaitForTaskOrGroup(pendingCount);
+			}
+		}
+	}
+}